@@ -0,0 +1,92 @@
+# This file is part of Notepad Next.
+# Copyright 2022 Justin Dailey
+#
+# Notepad Next is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Notepad Next is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+
+
+# Headless benchmark of whole editors on generated files, see main.cpp for its options
+
+QT += core widgets concurrent
+
+TARGET = NotepadNextBenchmark
+
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../Config.pri)
+
+include(../scintilla.pri)
+include(../lexilla.pri)
+include(../uchardet.pri)
+include(../lua.pri)
+
+NOTEPADNEXT = $$PWD/../NotepadNext
+
+SOURCES += \
+    EditorBenchmark.cpp \
+    main.cpp \
+    $$NOTEPADNEXT/ContentSniffer.cpp \
+    $$NOTEPADNEXT/EditorManager.cpp \
+    $$NOTEPADNEXT/EditorNotificationHub.cpp \
+    $$NOTEPADNEXT/Finder.cpp \
+    $$NOTEPADNEXT/LanguageProfile.cpp \
+    $$NOTEPADNEXT/PerformanceTrace.cpp \
+    $$NOTEPADNEXT/QRegexSearch.cpp \
+    $$NOTEPADNEXT/ScintillaCommenter.cpp \
+    $$NOTEPADNEXT/ScintillaNext.cpp \
+    $$NOTEPADNEXT/SelectionTracker.cpp \
+    $$NOTEPADNEXT/UndoAction.cpp \
+    $$NOTEPADNEXT/decorators/AutoCompletion.cpp \
+    $$NOTEPADNEXT/decorators/AutoIndentation.cpp \
+    $$NOTEPADNEXT/decorators/BackgroundLexer.cpp \
+    $$NOTEPADNEXT/decorators/BetterMultiSelection.cpp \
+    $$NOTEPADNEXT/decorators/BraceMatch.cpp \
+    $$NOTEPADNEXT/decorators/EditorDecorator.cpp \
+    $$NOTEPADNEXT/decorators/HighlightedScrollBar.cpp \
+    $$NOTEPADNEXT/decorators/LineNumbers.cpp \
+    $$NOTEPADNEXT/decorators/SmartHighlighter.cpp \
+    $$NOTEPADNEXT/decorators/SurroundSelection.cpp
+
+HEADERS += \
+    EditorBenchmark.h \
+    $$NOTEPADNEXT/ContentSniffer.h \
+    $$NOTEPADNEXT/EditorManager.h \
+    $$NOTEPADNEXT/EditorNotificationHub.h \
+    $$NOTEPADNEXT/Finder.h \
+    $$NOTEPADNEXT/LanguageProfile.h \
+    $$NOTEPADNEXT/PerformanceTrace.h \
+    $$NOTEPADNEXT/QRegexSearch.h \
+    $$NOTEPADNEXT/ScintillaCommenter.h \
+    $$NOTEPADNEXT/ScintillaNext.h \
+    $$NOTEPADNEXT/SelectionTracker.h \
+    $$NOTEPADNEXT/UndoAction.h \
+    $$NOTEPADNEXT/decorators/AutoCompletion.h \
+    $$NOTEPADNEXT/decorators/AutoIndentation.h \
+    $$NOTEPADNEXT/decorators/BackgroundLexer.h \
+    $$NOTEPADNEXT/decorators/BetterMultiSelection.h \
+    $$NOTEPADNEXT/decorators/BraceMatch.h \
+    $$NOTEPADNEXT/decorators/EditorDecorator.h \
+    $$NOTEPADNEXT/decorators/HighlightedScrollBar.h \
+    $$NOTEPADNEXT/decorators/LineNumbers.h \
+    $$NOTEPADNEXT/decorators/SmartHighlighter.h \
+    $$NOTEPADNEXT/decorators/SurroundSelection.h
+
+INCLUDEPATH += $$NOTEPADNEXT
+INCLUDEPATH += $$NOTEPADNEXT/decorators
+INCLUDEPATH += $$PWD/../lexilla/include
+
+OBJECTS_DIR = build/obj
+MOC_DIR = build/moc
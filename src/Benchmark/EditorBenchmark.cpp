@@ -0,0 +1,178 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "EditorBenchmark.h"
+#include "EditorManager.h"
+#include "Finder.h"
+#include "ScintillaNext.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+
+// Every line has this text, with the needle on one line in a hundred
+static const QByteArray LINE_TEXT = QByteArrayLiteral(" Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor");
+static const QByteArray NEEDLE = QByteArrayLiteral("needle");
+static const QByteArray LAST_LINE = QByteArrayLiteral("haystack end\n");
+
+static const int EDITOR_WIDTH = 1280;
+static const int EDITOR_HEIGHT = 800;
+
+
+// Only the lines on screen are wrapped straight away, the rest are wrapped in idle time. Wrapping
+// is finished once nothing is left to wrap and the number of display lines has stopped changing.
+static void waitForWrapping(ScintillaNext *editor)
+{
+    sptr_t displayLines = -1;
+    sptr_t previousDisplayLines = -1;
+
+    do {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+        previousDisplayLines = displayLines;
+        displayLines = editor->visibleFromDocLine(editor->lineCount());
+    } while (displayLines != previousDisplayLines || (editor->idleTasks() & SC_IDLETASK_WRAP));
+}
+
+
+EditorBenchmark::EditorBenchmark(const QString &directory) :
+    directory(directory)
+{
+}
+
+QString EditorBenchmark::generateFile(qint64 size, qint64 &lines) const
+{
+    const QString filePath = QDir(directory).filePath(QStringLiteral("benchmark-%1.txt").arg(size));
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Can not write %s", qUtf8Printable(filePath));
+        return QString();
+    }
+
+    QByteArray chunk;
+    qint64 written = 0;
+    lines = 0;
+
+    while (written + chunk.size() + LAST_LINE.size() < size) {
+        chunk += QByteArray::number(lines).rightJustified(10, '0');
+        chunk += LINE_TEXT;
+        if (lines % 100 == 0) {
+            chunk += ' ';
+            chunk += NEEDLE;
+        }
+        chunk += '\n';
+        ++lines;
+
+        if (chunk.size() >= 1024 * 1024) {
+            written += file.write(chunk);
+            chunk.clear();
+        }
+    }
+
+    chunk += LAST_LINE;
+    ++lines;
+    file.write(chunk);
+
+    return filePath;
+}
+
+QJsonObject EditorBenchmark::run(qint64 size)
+{
+    QJsonObject result;
+    qint64 lines = 0;
+    const QString filePath = generateFile(size, lines);
+
+    if (filePath.isEmpty()) {
+        return result;
+    }
+
+    result["bytes"] = QFileInfo(filePath).size();
+    result["lines"] = lines;
+
+    EditorManager manager;
+    QElapsedTimer timer;
+
+    timer.start();
+    ScintillaNext *editor = manager.createEditorFromFile(filePath);
+    result["open_ms"] = timer.elapsed();
+
+    if (!editor) {
+        result["error"] = QStringLiteral("open failed");
+        return result;
+    }
+
+    editor->resize(EDITOR_WIDTH, EDITOR_HEIGHT);
+    editor->show();
+
+    // Grabbing paints the widget straight away, even without a display
+    timer.start();
+    editor->grab();
+    result["first_paint_ms"] = timer.elapsed();
+
+    timer.start();
+    editor->documentEnd();
+    editor->grab();
+    result["scroll_to_end_ms"] = timer.elapsed();
+
+    Finder finder(editor);
+    finder.setSearchFlags(SCFIND_MATCHCASE);
+
+    finder.setSearchText(QString::fromLatin1(LAST_LINE.trimmed()));
+    timer.start();
+    const Sci_CharacterRange found = finder.findNext(0);
+    result["find_ms"] = timer.elapsed();
+    result["find_found"] = found.cpMin != INVALID_POSITION;
+
+    finder.setSearchText(QString::fromLatin1(NEEDLE));
+    timer.start();
+    result["count"] = finder.count();
+    result["count_ms"] = timer.elapsed();
+
+    timer.start();
+    result["replacements"] = finder.replaceAll(QStringLiteral("pin"));
+    result["replace_all_ms"] = timer.elapsed();
+
+    timer.start();
+    editor->undo();
+    result["undo_replace_ms"] = timer.elapsed();
+
+    timer.start();
+    editor->setWrapMode(SC_WRAP_WORD);
+    editor->grab();
+    waitForWrapping(editor);
+    result["wrap_on_ms"] = timer.elapsed();
+
+    timer.start();
+    editor->setWrapMode(SC_WRAP_NONE);
+    editor->grab();
+    result["wrap_off_ms"] = timer.elapsed();
+
+    timer.start();
+    result["saved"] = editor->save();
+    result["save_ms"] = timer.elapsed();
+
+    delete editor;
+    QFile::remove(filePath);
+
+    return result;
+}
@@ -0,0 +1,43 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EDITORBENCHMARK_H
+#define EDITORBENCHMARK_H
+
+#include <QJsonObject>
+#include <QString>
+
+
+// Times the operations users notice on large files, through the same editor setup as the
+// application: opening, painting, scrolling, searching, replacing, undoing, wrapping and saving.
+class EditorBenchmark
+{
+public:
+    explicit EditorBenchmark(const QString &directory);
+
+    // Runs every operation on a generated file of about the given size
+    QJsonObject run(qint64 size);
+
+private:
+    QString generateFile(qint64 size, qint64 &lines) const;
+
+    QString directory;
+};
+
+#endif // EDITORBENCHMARK_H
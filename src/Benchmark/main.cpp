@@ -0,0 +1,99 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "EditorBenchmark.h"
+
+
+// Runs the editor benchmark on generated files and prints the results as JSON, for example
+//   NotepadNextBenchmark --sizes 1,16,256 --output results.json
+// It runs without a display by using the offscreen platform unless QT_QPA_PLATFORM is set.
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QApplication::setOrganizationName("NotepadNext");
+    QApplication::setApplicationName("NotepadNextBenchmark");
+
+    // The editor logs many of its calls which would only slow it down here
+    QLoggingCategory::setFilterRules(QStringLiteral("default.info=false"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Notepad Next editor benchmark");
+    parser.addHelpOption();
+
+    QCommandLineOption sizesOption("sizes", "Comma separated sizes in MB of the files to generate.", "sizes", "1,16,128");
+    QCommandLineOption outputOption("output", "Write the results to this file instead of standard output.", "file");
+    QCommandLineOption directoryOption("directory", "Generate files in this directory instead of a temporary one.", "directory");
+    parser.addOption(sizesOption);
+    parser.addOption(outputOption);
+    parser.addOption(directoryOption);
+    parser.process(app);
+
+    QTemporaryDir temporaryDirectory;
+    const QString directory = parser.isSet(directoryOption) ? parser.value(directoryOption) : temporaryDirectory.path();
+
+    EditorBenchmark benchmark(directory);
+    QJsonArray results;
+
+    for (const QString &size : parser.value(sizesOption).split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const qint64 megabytes = size.trimmed().toLongLong(&ok);
+
+        if (!ok || megabytes <= 0) {
+            qWarning("Ignoring size %s", qUtf8Printable(size));
+            continue;
+        }
+
+        QJsonObject result = benchmark.run(megabytes * 1024 * 1024);
+        result["size_mb"] = megabytes;
+        results.append(result);
+    }
+
+    QJsonObject report;
+    report["qt"] = QString::fromLatin1(qVersion());
+    report["platform"] = QGuiApplication::platformName();
+    report["results"] = results;
+
+    const QByteArray json = QJsonDocument(report).toJson();
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()) {
+            qWarning("Can not write %s", qUtf8Printable(parser.value(outputOption)));
+            return 1;
+        }
+    }
+    else {
+        QTextStream(stdout) << json;
+    }
+
+    return 0;
+}
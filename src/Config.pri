@@ -29,5 +29,8 @@ DEFINES += SCI_OWNREGEX
 
 DEFINES += ADS_STATIC
 
+# Build with CONFIG+=notracing to compile out the performance trace spans
+notracing: DEFINES += NOTEPADNEXT_NO_TRACING
+
 msvc:QMAKE_CXXFLAGS += /guard:cf
 msvc:QMAKE_LFLAGS += /guard:cf
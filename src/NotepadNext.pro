@@ -23,6 +23,9 @@ TEMPLATE = subdirs
 
 SUBDIRS = NotepadNext
 
+# Headless editor benchmark, built with: qmake CONFIG+=benchmark
+benchmark: SUBDIRS += Benchmark
+
 
 # Extra Windows targets
 win32 {
@@ -0,0 +1,285 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "ContentSniffer.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+
+
+namespace {
+
+struct CacheEntry {
+    qint64 size;
+    QDateTime lastModified;
+    QString extension;
+};
+
+QMutex cacheMutex;
+QHash<QString, CacheEntry> cache;
+
+// Interpreter names as they show up in a shebang line
+const QHash<QByteArray, QString> interpreters {
+    {"sh", "sh"}, {"bash", "sh"}, {"zsh", "sh"}, {"ksh", "sh"}, {"dash", "sh"}, {"ash", "sh"}, {"csh", "sh"}, {"tcsh", "sh"},
+    {"python", "py"}, {"pypy", "py"},
+    {"perl", "pl"},
+    {"ruby", "rb"},
+    {"node", "js"}, {"nodejs", "js"},
+    {"lua", "lua"},
+    {"php", "php"},
+    {"tclsh", "tcl"}, {"wish", "tcl"},
+    {"Rscript", "r"},
+    {"pwsh", "ps1"},
+    {"make", "mak"},
+};
+
+// Names used by Emacs and Vim modelines that are not already an extension
+const QHash<QByteArray, QString> modes {
+    {"shell-script", "sh"}, {"bash", "sh"}, {"zsh", "sh"},
+    {"python", "py"},
+    {"perl", "pl"}, {"cperl", "pl"},
+    {"ruby", "rb"},
+    {"javascript", "js"}, {"js", "js"},
+    {"c++", "cpp"},
+    {"makefile", "mak"}, {"make", "mak"},
+    {"markdown", "md"},
+    {"yaml", "yml"},
+    {"cmake", "cmake"},
+    {"conf", "ini"}, {"dosini", "ini"},
+};
+
+}
+
+QString ContentSniffer::extensionForFileName(const QString &fileName)
+{
+    static const QHash<QString, QString> fileNames {
+        {"Makefile", "mak"}, {"makefile", "mak"}, {"GNUmakefile", "mak"},
+        {"CMakeLists.txt", "cmake"},
+        {".bashrc", "sh"}, {".bash_profile", "sh"}, {".profile", "sh"}, {".zshrc", "sh"},
+        {".gitconfig", "ini"}, {".editorconfig", "ini"},
+    };
+
+    return fileNames.value(fileName);
+}
+
+QString ContentSniffer::extensionForContent(const QFileInfo &fileInfo, const QByteArray &prefix)
+{
+    const QString path = fileInfo.absoluteFilePath();
+    const qint64 size = fileInfo.size();
+    const QDateTime lastModified = fileInfo.lastModified();
+
+    {
+        QMutexLocker locker(&cacheMutex);
+        auto it = cache.constFind(path);
+
+        if (it != cache.constEnd() && it->size == size && it->lastModified == lastModified) {
+            return it->extension;
+        }
+    }
+
+    const QString extension = sniff(prefix.left(PrefixSize));
+
+    QMutexLocker locker(&cacheMutex);
+    cache.insert(path, CacheEntry{size, lastModified, extension});
+
+    return extension;
+}
+
+QString ContentSniffer::sniff(const QByteArray &prefix)
+{
+    QByteArray data = prefix;
+
+    // Skip a UTF-8 byte order mark
+    if (data.startsWith("\xEF\xBB\xBF")) {
+        data.remove(0, 3);
+    }
+
+    // Binary files are left alone
+    if (data.contains('\0')) {
+        return QString();
+    }
+
+    if (data.startsWith("#!")) {
+        const QString extension = fromShebang(data.left(data.indexOf('\n')));
+        if (!extension.isEmpty())
+            return extension;
+    }
+
+    QString extension = fromModeline(data);
+    if (!extension.isEmpty())
+        return extension;
+
+    extension = fromSignature(data);
+    if (!extension.isEmpty())
+        return extension;
+
+    return fromTokens(data);
+}
+
+QString ContentSniffer::fromShebang(const QByteArray &line)
+{
+    // e.g. "#!/bin/sh", "#!/usr/bin/env python3", "#!/usr/bin/env -S node --flag"
+    const QList<QByteArray> parts = line.mid(2).simplified().split(' ');
+    QByteArray interpreter = parts.value(0);
+
+    if (interpreter.endsWith("/env")) {
+        interpreter.clear();
+
+        for (int i = 1; i < parts.size(); ++i) {
+            if (!parts[i].startsWith('-') && !parts[i].contains('=')) {
+                interpreter = parts[i];
+                break;
+            }
+        }
+    }
+
+    interpreter = interpreter.mid(interpreter.lastIndexOf('/') + 1);
+
+    // Drop version numbers, e.g. "python3.10" or "perl5"
+    while (!interpreter.isEmpty()) {
+        const char c = interpreter.at(interpreter.size() - 1);
+
+        if (!(c >= '0' && c <= '9') && c != '.')
+            break;
+
+        interpreter.chop(1);
+    }
+
+    return interpreters.value(interpreter);
+}
+
+QString ContentSniffer::fromModeline(const QByteArray &prefix)
+{
+    // Emacs: "-*- mode: python -*-" or "-*- python -*-", Vim: "vim: set ft=python:" or "vim: syntax=python"
+    static const QRegularExpression emacsMode(QStringLiteral("-\\*-.*\\bmode:\\s*([\\w+-]+).*-\\*-"));
+    static const QRegularExpression emacs(QStringLiteral("-\\*-\\s*([\\w+-]+)\\s*-\\*-"));
+    static const QRegularExpression vim(QStringLiteral("\\b(?:vi|vim|ex):.*\\b(?:ft|filetype|syntax)=([\\w+-]+)"));
+
+    // Modelines are only honoured in the first few lines (Emacs) or last few lines (Vim), but
+    // only the prefix is available so just look at the first few lines for either
+    int end = 0;
+    for (int i = 0; i < 5 && end != -1; ++i) {
+        end = prefix.indexOf('\n', end + 1);
+    }
+
+    const QString head = QString::fromUtf8(end == -1 ? prefix : prefix.left(end));
+
+    for (const QRegularExpression *re : {&emacsMode, &emacs, &vim}) {
+        const QRegularExpressionMatch match = re->match(head);
+
+        if (match.hasMatch()) {
+            const QByteArray mode = match.captured(1).toLower().toUtf8();
+
+            return modes.value(mode, QString::fromUtf8(mode));
+        }
+    }
+
+    return QString();
+}
+
+QString ContentSniffer::fromSignature(const QByteArray &prefix)
+{
+    const QByteArray start = prefix.left(256).trimmed();
+
+    if (start.startsWith("<?xml"))
+        return QStringLiteral("xml");
+    if (start.startsWith("<?php"))
+        return QStringLiteral("php");
+
+    const QByteArray lower = start.toLower();
+    if (lower.startsWith("<!doctype html") || lower.startsWith("<html"))
+        return QStringLiteral("html");
+
+    if (start.startsWith("diff --git ") || start.startsWith("Index: ") || (start.startsWith("--- ") && prefix.contains("\n+++ ")))
+        return QStringLiteral("diff");
+
+    if (start.startsWith("{") || start.startsWith("[")) {
+        // A quoted key followed by a colon is a good enough sign of a JSON object; arrays need
+        // to look like they hold JSON values rather than an ini section header
+        static const QRegularExpression jsonObject(QStringLiteral("^\\{\\s*(\\}|\"[^\"]*\"\\s*:)"));
+        static const QRegularExpression jsonArray(QStringLiteral("^\\[\\s*(\\]|[\\[{\"\\d-]|true|false|null)"));
+        const QString text = QString::fromUtf8(start);
+
+        if (jsonObject.match(text).hasMatch() || jsonArray.match(text).hasMatch())
+            return QStringLiteral("json");
+    }
+
+    if (start.startsWith("---\n") || start.startsWith("---\r\n") || start.startsWith("%YAML"))
+        return QStringLiteral("yml");
+
+    return QString();
+}
+
+QString ContentSniffer::fromTokens(const QByteArray &prefix)
+{
+    // Count lines that are characteristic of a few common formats. Only the complete lines
+    // in the prefix are used and a format has to account for a reasonable share of them.
+    int lines = 0;
+    int iniSections = 0;
+    int iniKeys = 0;
+    int cPreprocessor = 0;
+    int pythonLines = 0;
+
+    static const QRegularExpression iniSection(QStringLiteral("^\\[[^\\]]+\\]\\s*$"));
+    static const QRegularExpression iniKey(QStringLiteral("^[\\w.-]+\\s*=.*$"));
+    static const QRegularExpression preprocessor(QStringLiteral("^#\\s*(include|define|ifn?def|endif|pragma)\\b"));
+    static const QRegularExpression python(QStringLiteral("^(def |class \\w+.*:\\s*$|import \\w|from [\\w.]+ import )"));
+
+    const int end = prefix.lastIndexOf('\n');
+    if (end == -1) {
+        return QString();
+    }
+
+    for (QByteArray rawLine : prefix.left(end).split('\n')) {
+        if (rawLine.endsWith('\r'))
+            rawLine.chop(1);
+
+        const QString line = QString::fromUtf8(rawLine);
+
+        if (line.trimmed().isEmpty())
+            continue;
+
+        ++lines;
+
+        if (iniSection.match(line).hasMatch())
+            ++iniSections;
+        else if (iniKey.match(line).hasMatch())
+            ++iniKeys;
+
+        if (preprocessor.match(line).hasMatch())
+            ++cPreprocessor;
+        if (python.match(line).hasMatch())
+            ++pythonLines;
+    }
+
+    if (lines < 3)
+        return QString();
+
+    if (iniSections > 0 && iniSections + iniKeys >= lines * 3 / 4)
+        return QStringLiteral("ini");
+    if (cPreprocessor >= 2 && cPreprocessor * 10 >= lines)
+        return QStringLiteral("cpp");
+    if (pythonLines >= 2 && pythonLines * 10 >= lines)
+        return QStringLiteral("py");
+
+    return QString();
+}
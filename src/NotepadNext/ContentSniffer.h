@@ -0,0 +1,48 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CONTENTSNIFFER_H
+#define CONTENTSNIFFER_H
+
+#include <QByteArray>
+#include <QFileInfo>
+#include <QString>
+
+
+// Guesses what kind of file something is by looking at the start of its contents. The result is
+// given as a file extension (e.g. "py") so it can go through the same lookup as real extensions.
+// This is safe to call from any thread.
+class ContentSniffer
+{
+public:
+    // Only this much of the file is ever looked at
+    static const int PrefixSize = 4096;
+
+    static QString extensionForFileName(const QString &fileName);
+    static QString extensionForContent(const QFileInfo &fileInfo, const QByteArray &prefix);
+
+private:
+    static QString sniff(const QByteArray &prefix);
+    static QString fromShebang(const QByteArray &line);
+    static QString fromModeline(const QByteArray &prefix);
+    static QString fromSignature(const QByteArray &prefix);
+    static QString fromTokens(const QByteArray &prefix);
+};
+
+#endif // CONTENTSNIFFER_H
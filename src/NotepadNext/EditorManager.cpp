@@ -17,6 +17,7 @@
  */
 
 #include <QApplication>
+#include <QThread>
 
 #include "EditorManager.h"
 #include "ScintillaNext.h"
@@ -31,6 +32,7 @@
 #include "BetterMultiSelection.h"
 #include "AutoIndentation.h"
 #include "AutoCompletion.h"
+#include "BackgroundLexer.h"
 
 
 const int MARK_BOOKMARK = 24;
@@ -38,6 +40,16 @@ const int MARK_HIDELINESBEGIN = 23;
 const int MARK_HIDELINESEND = 22;
 const int MARK_HIDELINESUNDERLINE = 21;
 
+// Memory each editor may use to keep the layout of lines, rather than a fixed number of lines
+const int LAYOUT_CACHE_BUDGET = 1024 * 1024 * 16;
+
+// Memory for images of drawn lines. Enough for a couple of screens of a maximised window on a 4K
+// display, it is only held by visible editors as hidden ones drop their images
+const int LINE_PIXMAP_CACHE_BUDGET = 1024 * 1024 * 64;
+
+// Entries in the text width cache, which is shared by all editors so only resized by the first one
+const int POSITION_CACHE_SIZE = 0x10000;
+
 
 static int DefaultFontSize()
 {
@@ -131,6 +143,14 @@ void EditorManager::setupEditor(ScintillaNext *editor)
     }
 
     editor->setIdleStyling(SC_IDLESTYLING_TOVISIBLE);
+    editor->setLayoutCache(SC_CACHE_DOCUMENT);
+    editor->setLayoutCacheBudget(LAYOUT_CACHE_BUDGET);
+    editor->setLinePixmapCacheBudget(LINE_PIXMAP_CACHE_BUDGET);
+    editor->setPositionCache(POSITION_CACHE_SIZE);
+
+    // Measure long lines and wrap large files on all cores
+    editor->setLayoutThreads(QThread::idealThreadCount());
+
     editor->setEndAtLastLine(false);
 
     editor->setCodePage(SC_CP_UTF8);
@@ -253,6 +273,9 @@ void EditorManager::setupEditor(ScintillaNext *editor)
 
     AutoCompletion *ac = new AutoCompletion(editor);
     ac->setEnabled(true);
+
+    BackgroundLexer *bl = new BackgroundLexer(editor);
+    bl->setEnabled(true);
 }
 
 void EditorManager::purgeOldEditorPointers()
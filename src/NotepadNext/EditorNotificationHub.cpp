@@ -0,0 +1,191 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "EditorNotificationHub.h"
+#include "ScintillaNext.h"
+
+#include <algorithm>
+
+
+using namespace Scintilla;
+
+EditorNotificationHub::EditorNotificationHub(ScintillaNext *editor) :
+    QObject(editor),
+    editor(editor)
+{
+    connect(editor, &ScintillaEdit::notify, this, &EditorNotificationHub::notification);
+}
+
+void EditorNotificationHub::subscribe(QObject *receiver, Events interests, Callback callback)
+{
+    auto it = std::find_if(subscribers.begin(), subscribers.end(), [receiver](const Subscriber &s) { return s.receiver == receiver; });
+
+    if (it != subscribers.end()) {
+        it->interests = interests;
+        it->callback = callback;
+    }
+    else {
+        subscribers.append(Subscriber{receiver, interests, callback});
+    }
+
+    connect(receiver, &QObject::destroyed, this, &EditorNotificationHub::receiverDestroyed, Qt::UniqueConnection);
+}
+
+void EditorNotificationHub::unsubscribe(QObject *receiver)
+{
+    // While dispatching entries are only marked so the loop in flush() stays valid
+    for (Subscriber &subscriber : subscribers) {
+        if (subscriber.receiver == receiver) {
+            subscriber.receiver = Q_NULLPTR;
+        }
+    }
+
+    if (!dispatching) {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [](const Subscriber &s) { return s.receiver == Q_NULLPTR; }), subscribers.end());
+    }
+
+    disconnect(receiver, &QObject::destroyed, this, &EditorNotificationHub::receiverDestroyed);
+}
+
+const EditorNotificationHub::State &EditorNotificationHub::state()
+{
+    // Outside of a dispatch there is no guarantee the cached copy is current
+    if (!dispatching || !stateValid) {
+        refreshState();
+    }
+
+    return currentState;
+}
+
+const QByteArray &EditorNotificationHub::selectionText()
+{
+    if (!dispatching || !selectionTextValid) {
+        const State &s = state();
+
+        currentSelectionText = editor->get_text_range(s.mainSelectionStart, s.mainSelectionEnd);
+        selectionTextValid = true;
+    }
+
+    return currentSelectionText;
+}
+
+void EditorNotificationHub::flush()
+{
+    flushScheduled = false;
+
+    if (pending == NoEvent) {
+        return;
+    }
+
+    const Events events = pending;
+    pending = NoEvent;
+
+    stateValid = false;
+    selectionTextValid = false;
+    dispatching = true;
+
+    // Subscribers added during the dispatch will get the next batch
+    const int count = subscribers.size();
+    for (int i = 0; i < count; ++i) {
+        const Subscriber subscriber = subscribers[i];
+
+        if (subscriber.receiver && (subscriber.interests & events)) {
+            subscriber.callback(events & subscriber.interests, state());
+        }
+    }
+
+    dispatching = false;
+
+    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [](const Subscriber &s) { return s.receiver == Q_NULLPTR; }), subscribers.end());
+}
+
+void EditorNotificationHub::notification(const NotificationData *pscn)
+{
+    Events events = NoEvent;
+
+    if (pscn->nmhdr.code == Notification::UpdateUI) {
+        if (FlagSet(pscn->updated, Update::Content))
+            events |= ContentChanged;
+        if (FlagSet(pscn->updated, Update::Selection))
+            events |= SelectionChanged;
+        if (FlagSet(pscn->updated, Update::VScroll))
+            events |= VerticalScroll;
+        if (FlagSet(pscn->updated, Update::HScroll))
+            events |= HorizontalScroll;
+    }
+    else if (pscn->nmhdr.code == Notification::Modified) {
+        if (pscn->linesAdded != 0)
+            events |= LineCountChanged;
+        if (FlagSet(pscn->modificationType, ModificationFlags::ChangeMarker))
+            events |= MarkersChanged;
+    }
+    else if (pscn->nmhdr.code == Notification::Zoom) {
+        events |= ZoomChanged;
+    }
+
+    post(events);
+}
+
+void EditorNotificationHub::receiverDestroyed(QObject *receiver)
+{
+    unsubscribe(receiver);
+}
+
+void EditorNotificationHub::post(Events events)
+{
+    if (events == NoEvent) {
+        return;
+    }
+
+    pending |= events;
+
+    if (!flushScheduled) {
+        flushScheduled = true;
+        QMetaObject::invokeMethod(this, &EditorNotificationHub::flush, Qt::QueuedConnection);
+    }
+}
+
+void EditorNotificationHub::refreshState()
+{
+    State &s = currentState;
+
+    s.length = editor->length();
+    s.lineCount = editor->lineCount();
+
+    s.currentPos = editor->currentPos();
+    s.anchor = editor->anchor();
+    s.caretLine = editor->lineFromPosition(s.currentPos);
+
+    s.selections = editor->selections();
+    s.mainSelection = editor->mainSelection();
+    s.mainSelectionStart = editor->selectionNStart(s.mainSelection);
+    s.mainSelectionEnd = editor->selectionNEnd(s.mainSelection);
+    s.selectionStart = editor->selectionStart();
+    s.selectionEnd = editor->selectionEnd();
+    s.selectionEmpty = editor->selectionEmpty();
+
+    s.firstVisibleLine = editor->firstVisibleLine();
+    s.linesOnScreen = editor->linesOnScreen();
+    s.firstVisibleDocLine = editor->docLineFromVisible(s.firstVisibleLine);
+    s.lastVisibleDocLine = qMin(editor->docLineFromVisible(s.firstVisibleLine + s.linesOnScreen), s.lineCount - 1);
+    s.visibleStart = editor->positionFromLine(s.firstVisibleDocLine);
+    s.visibleEnd = editor->lineEndPosition(s.lastVisibleDocLine);
+
+    stateValid = true;
+}
@@ -0,0 +1,123 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef EDITORNOTIFICATIONHUB_H
+#define EDITORNOTIFICATIONHUB_H
+
+#include <QObject>
+#include <QVector>
+
+#include <functional>
+
+#include "Sci_Position.h"
+#include "ScintillaTypes.h"
+#include "ScintillaStructures.h"
+
+
+class ScintillaNext;
+
+// Collects the Scintilla notifications of a single editor and dispatches them at most once per
+// event loop turn. Anything derived from the editor (caret line, visible range, selection text)
+// is queried once per dispatch and shared between every subscriber.
+class EditorNotificationHub : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Event {
+        NoEvent = 0x00,
+        ContentChanged = 0x01,
+        SelectionChanged = 0x02,
+        VerticalScroll = 0x04,
+        HorizontalScroll = 0x08,
+        LineCountChanged = 0x10,
+        MarkersChanged = 0x20,
+        ZoomChanged = 0x40,
+        AllEvents = 0x7F
+    };
+    Q_DECLARE_FLAGS(Events, Event)
+
+    struct State {
+        Sci_Position length = 0;
+        Scintilla::Line lineCount = 0;
+
+        Sci_Position currentPos = 0;
+        Sci_Position anchor = 0;
+        Scintilla::Line caretLine = 0;
+
+        int selections = 0;
+        int mainSelection = 0;
+        Sci_Position mainSelectionStart = 0;
+        Sci_Position mainSelectionEnd = 0;
+        Sci_Position selectionStart = 0;
+        Sci_Position selectionEnd = 0;
+        bool selectionEmpty = true;
+
+        Scintilla::Line firstVisibleLine = 0;
+        Scintilla::Line linesOnScreen = 0;
+        Scintilla::Line firstVisibleDocLine = 0;
+        Scintilla::Line lastVisibleDocLine = 0;
+        Sci_Position visibleStart = 0;
+        Sci_Position visibleEnd = 0;
+    };
+
+    typedef std::function<void(EditorNotificationHub::Events, const EditorNotificationHub::State &)> Callback;
+
+    explicit EditorNotificationHub(ScintillaNext *editor);
+
+    // Subscribing again replaces the interests and callback given before
+    void subscribe(QObject *receiver, Events interests, Callback callback);
+    void unsubscribe(QObject *receiver);
+
+    const State &state();
+    const QByteArray &selectionText();
+
+public slots:
+    void flush();
+
+private slots:
+    void notification(const Scintilla::NotificationData *pscn);
+    void receiverDestroyed(QObject *receiver);
+
+private:
+    struct Subscriber {
+        QObject *receiver;
+        Events interests;
+        Callback callback;
+    };
+
+    void post(Events events);
+    void refreshState();
+
+    ScintillaNext *editor;
+    QVector<Subscriber> subscribers;
+
+    Events pending = NoEvent;
+    bool flushScheduled = false;
+    bool dispatching = false;
+
+    State currentState;
+    bool stateValid = false;
+    QByteArray currentSelectionText;
+    bool selectionTextValid = false;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(EditorNotificationHub::Events)
+
+#endif // EDITORNOTIFICATIONHUB_H
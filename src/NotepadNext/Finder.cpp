@@ -18,6 +18,7 @@
 
 
 #include "Finder.h"
+#include "PerformanceTrace.h"
 
 Finder::Finder(ScintillaNext *edit) :
     editor(edit)
@@ -41,6 +42,8 @@ void Finder::setSearchText(const QString &text)
 
 Sci_CharacterRange Finder::findNext(int startPos)
 {
+    TRACE_SCOPE("search", "Finder::findNext");
+
     if (text.isEmpty())
         return {INVALID_POSITION, INVALID_POSITION};
 
@@ -64,6 +67,8 @@ Sci_CharacterRange Finder::findNext(int startPos)
 
 Sci_CharacterRange Finder::findPrev()
 {
+    TRACE_SCOPE("search", "Finder::findPrev");
+
     if (text.isEmpty())
         return {INVALID_POSITION, INVALID_POSITION};
 
@@ -90,6 +95,8 @@ Sci_CharacterRange Finder::findPrev()
 // Count all occurrences in the document
 int Finder::count()
 {
+    TRACE_SCOPE("search", "Finder::count");
+
     int total = 0;
 
     if (text.length() > 0) {
@@ -124,6 +131,8 @@ Sci_CharacterRange Finder::replaceSelectionIfMatch(const QString &replaceText)
 
 int Finder::replaceAll(const QString &replaceText)
 {
+    TRACE_SCOPE("search", "Finder::replaceAll");
+
     if (text.isEmpty())
         return 0;
 
@@ -35,7 +35,9 @@ enum IFaceType {
     iface_stringresult,
     iface_cells, // This and everything else below is not "scriptable"
     iface_textrange,
+    iface_textrangefull,
     iface_findtext,
+    iface_findtextfull,
     iface_formatrange
 };
 
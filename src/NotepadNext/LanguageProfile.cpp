@@ -0,0 +1,272 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "LanguageProfile.h"
+#include "ScintillaNext.h"
+
+#include "lua.hpp"
+
+#include "ILexer.h"
+#include "Lexilla.h"
+
+#include <QStringList>
+
+
+static QByteArray fieldString(lua_State *L, int index, const char *field)
+{
+    QByteArray value;
+
+    lua_getfield(L, index, field);
+    if (lua_type(L, -1) == LUA_TSTRING) {
+        size_t length;
+        const char *s = lua_tolstring(L, -1, &length);
+        value = QByteArray(s, static_cast<int>(length));
+    }
+    lua_pop(L, 1);
+
+    return value;
+}
+
+static bool fieldInteger(lua_State *L, int index, const char *field, int &value)
+{
+    bool found = false;
+
+    lua_getfield(L, index, field);
+    if (lua_isnumber(L, -1)) {
+        value = static_cast<int>(lua_tointeger(L, -1));
+        found = true;
+    }
+    lua_pop(L, 1);
+
+    return found;
+}
+
+// Leaves languages[languageName] on the stack if it is a table
+static bool pushLanguage(lua_State *L, const QString &languageName)
+{
+    lua_getglobal(L, "languages");
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        return false;
+    }
+
+    lua_getfield(L, -1, languageName.toLatin1().constData());
+    lua_remove(L, -2);
+
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        return false;
+    }
+
+    return true;
+}
+
+bool LanguageProfile::fromLua(lua_State *L, const QString &languageName, LanguageProfile &profile)
+{
+    if (!pushLanguage(L, languageName)) {
+        return false;
+    }
+
+    const int language = lua_gettop(L);
+
+    profile.name = languageName;
+    profile.lexer = fieldString(L, language, "lexer");
+    profile.singleLineComment = fieldString(L, language, "singleLineComment");
+
+    const QByteArray tabSettings = fieldString(L, language, "tabSettings");
+    profile.useTabs = tabSettings.isEmpty() || tabSettings == "tabs";
+    if (!fieldInteger(L, language, "tabSize", profile.tabSize)) {
+        profile.tabSize = 4;
+    }
+
+    lua_getfield(L, language, "disableFoldMargin");
+    profile.disableFoldMargin = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+
+    lua_getfield(L, language, "styles");
+    if (lua_istable(L, -1)) {
+        const int styles = lua_gettop(L);
+
+        lua_pushnil(L);
+        while (lua_next(L, styles) != 0) {
+            if (lua_istable(L, -1)) {
+                const int entry = lua_gettop(L);
+                Style style = {};
+
+                if (fieldInteger(L, entry, "id", style.id)) {
+                    style.hasFore = fieldInteger(L, entry, "fgColor", style.fore);
+                    style.hasBack = fieldInteger(L, entry, "bgColor", style.back);
+                    fieldInteger(L, entry, "fontStyle", style.fontStyle);
+
+                    profile.styles.append(style);
+                }
+            }
+            lua_pop(L, 1);
+        }
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, language, "keywords");
+    if (lua_istable(L, -1)) {
+        const int keywords = lua_gettop(L);
+
+        lua_pushnil(L);
+        while (lua_next(L, keywords) != 0) {
+            if (lua_isnumber(L, -2) && lua_type(L, -1) == LUA_TSTRING) {
+                profile.keywords.append(qMakePair(static_cast<int>(lua_tointeger(L, -2)), QByteArray(lua_tostring(L, -1))));
+            }
+            lua_pop(L, 1);
+        }
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, language, "properties");
+    if (lua_istable(L, -1)) {
+        const int properties = lua_gettop(L);
+
+        lua_pushnil(L);
+        while (lua_next(L, properties) != 0) {
+            // Only look at string keys, lua_tostring() on a number key would confuse lua_next()
+            if (lua_type(L, -2) == LUA_TSTRING && lua_type(L, -1) == LUA_TSTRING) {
+                profile.properties.append(qMakePair(QByteArray(lua_tostring(L, -2)), QByteArray(lua_tostring(L, -1))));
+            }
+            lua_pop(L, 1);
+        }
+    }
+    lua_pop(L, 1);
+
+    lua_pop(L, 1); // languages[languageName]
+
+    return true;
+}
+
+QHash<QString, QString> LanguageProfile::extensionsFromLua(lua_State *L)
+{
+    QHash<QString, QString> extensions;
+    QStringList names;
+
+    lua_getglobal(L, "languages");
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        return extensions;
+    }
+
+    const int languages = lua_gettop(L);
+
+    lua_pushnil(L);
+    while (lua_next(L, languages) != 0) {
+        if (lua_type(L, -2) == LUA_TSTRING) {
+            names.append(QString(lua_tostring(L, -2)));
+        }
+        lua_pop(L, 1);
+    }
+
+    // Sort the names so an extension claimed by several languages always resolves the same way
+    names.sort(Qt::CaseInsensitive);
+
+    for (const QString &name : qAsConst(names)) {
+        lua_getfield(L, languages, name.toLatin1().constData());
+        lua_getfield(L, -1, "extensions");
+
+        if (lua_istable(L, -1)) {
+            const int count = static_cast<int>(lua_rawlen(L, -1));
+
+            for (int i = 1; i <= count; ++i) {
+                lua_rawgeti(L, -1, i);
+                if (lua_type(L, -1) == LUA_TSTRING) {
+                    const QString extension(lua_tostring(L, -1));
+
+                    if (!extensions.contains(extension)) {
+                        extensions.insert(extension, name);
+                    }
+                }
+                lua_pop(L, 1);
+            }
+        }
+
+        lua_pop(L, 2);
+    }
+
+    lua_pop(L, 1);
+
+    return extensions;
+}
+
+void LanguageProfile::applyTo(ScintillaNext *editor) const
+{
+    editor->languageName = name;
+    editor->languageSingleLineComment = singleLineComment;
+
+    auto lexerInstance = CreateLexer(lexer.constData());
+    editor->setILexer((sptr_t) lexerInstance);
+
+    editor->setUseTabs(useTabs);
+    editor->setTabWidth(tabSize);
+    editor->setMarginWidthN(2, disableFoldMargin ? 0 : 16);
+
+    for (const Style &style : styles) {
+        if (style.hasFore)
+            editor->styleSetFore(style.id, style.fore);
+        if (style.hasBack)
+            editor->styleSetBack(style.id, style.back);
+
+        // Like the Lua version this only turns attributes on, never off
+        if (style.fontStyle & 1)
+            editor->styleSetBold(style.id, true);
+        if (style.fontStyle & 2)
+            editor->styleSetItalic(style.id, true);
+        if (style.fontStyle & 4)
+            editor->styleSetUnderline(style.id, true);
+        if (style.fontStyle & 8)
+            editor->styleSetEOLFilled(style.id, true);
+    }
+
+    for (const auto &keyword : keywords) {
+        editor->setKeyWords(keyword.first, keyword.second.constData());
+    }
+
+    for (const auto &property : properties) {
+        editor->setProperty(property.first.constData(), property.second.constData());
+    }
+
+    editor->setProperty("fold", "1");
+    editor->setProperty("fold.compact", "0");
+}
+
+Scintilla::ILexer5 *LanguageProfile::createLexer() const
+{
+    Scintilla::ILexer5 *instance = CreateLexer(lexer.constData());
+
+    if (!instance) {
+        return nullptr;
+    }
+
+    for (const auto &keyword : keywords) {
+        instance->WordListSet(keyword.first, keyword.second.constData());
+    }
+
+    for (const auto &property : properties) {
+        instance->PropertySet(property.first.constData(), property.second.constData());
+    }
+
+    instance->PropertySet("fold", "1");
+    instance->PropertySet("fold.compact", "0");
+
+    return instance;
+}
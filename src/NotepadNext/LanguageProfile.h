@@ -0,0 +1,72 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LANGUAGEPROFILE_H
+#define LANGUAGEPROFILE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+
+struct lua_State;
+class ScintillaNext;
+
+namespace Scintilla {
+class ILexer5;
+}
+
+// Everything needed to set up an editor for a language, resolved from the Lua language
+// definitions once so that applying it does not need to go back through Lua.
+class LanguageProfile
+{
+public:
+    struct Style {
+        int id;
+        bool hasFore;
+        int fore;
+        bool hasBack;
+        int back;
+        int fontStyle;
+    };
+
+    static bool fromLua(lua_State *L, const QString &languageName, LanguageProfile &profile);
+    static QHash<QString, QString> extensionsFromLua(lua_State *L);
+
+    void applyTo(ScintillaNext *editor) const;
+
+    // A separate lexer instance set up with the keywords and properties, owned by the caller
+    Scintilla::ILexer5 *createLexer() const;
+
+    QString name;
+    QByteArray lexer;
+    QByteArray singleLineComment;
+
+    bool useTabs = true;
+    int tabSize = 4;
+    bool disableFoldMargin = false;
+
+    QVector<Style> styles;
+    QVector<QPair<int, QByteArray>> keywords;
+    QVector<QPair<QByteArray, QByteArray>> properties;
+};
+
+#endif // LANGUAGEPROFILE_H
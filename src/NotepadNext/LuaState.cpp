@@ -18,6 +18,7 @@
 
 
 #include "LuaState.h"
+#include "PerformanceTrace.h"
 #include "lua.hpp"
 
 #include <QFile>
@@ -118,6 +119,8 @@ LuaState::~LuaState()
 
 void LuaState::execute(const char *statement, bool clear)
 {
+    TRACE_SCOPE_DETAIL("lua", "LuaState::execute", QString::fromUtf8(statement).left(80));
+
     // There may be other things on the stack so save the top of it
     const int stacktop = lua_gettop(L);
 
@@ -146,6 +149,8 @@ void LuaState::execute(const char *statement, bool clear)
 
 void LuaState::executeFile(const QString &fileName)
 {
+    TRACE_SCOPE_DETAIL("lua", "LuaState::executeFile", fileName);
+
     QFile ff(fileName);
 
     if (!ff.open(QFile::ReadOnly)) {
@@ -18,6 +18,7 @@
 
 
 #include "MacroRecorder.h"
+#include "PerformanceTrace.h"
 #include "ScintillaNext.h"
 
 using namespace Scintilla;
@@ -92,7 +93,7 @@ Macro::~Macro()
 
 void Macro::addMacroStep(Message message, uptr_t wParam, sptr_t lParam)
 {
-    qInfo(Q_FUNC_INFO);
+    TRACE_SCOPE("macro", "Macro::addMacroStep");
 
     // Combine ReplaceSel messages into a single string
     if (message == Message::ReplaceSel && !actions.empty() && actions.constLast()->message == Message::ReplaceSel) {
@@ -221,7 +222,5 @@ Macro *MacroRecorder::stopRecording()
 
 void MacroRecorder::recordMacroStep(Message message, uptr_t wParam, sptr_t lParam)
 {
-    qInfo(Q_FUNC_INFO);
-
     macro->addMacroStep(message, wParam, lParam);
 }
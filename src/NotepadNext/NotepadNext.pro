@@ -15,7 +15,7 @@
 # along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
 
 
-QT += core widgets printsupport network
+QT += core widgets printsupport network concurrent
 
 TARGET = NotepadNext
 
@@ -60,13 +60,16 @@ license.path = $$OUT_PWD
 SOURCES += \
     ColorPickerDelegate.cpp \
     ComboBoxDelegate.cpp \
+    ContentSniffer.cpp \
     DockedEditor.cpp \
     EditorManager.cpp \
+    EditorNotificationHub.cpp \
     EditorPrintPreviewRenderer.cpp \
     Finder.cpp \
     IFaceTable.cpp \
     IFaceTableMixer.cpp \
     LanguageKeywordsModel.cpp \
+    LanguageProfile.cpp \
     LanguagePropertiesModel.cpp \
     LanguageStylesModel.cpp \
     LuaExtension.cpp \
@@ -74,6 +77,7 @@ SOURCES += \
     MacroRecorder.cpp \
     NotepadNextApplication.cpp \
     NppImporter.cpp \
+    PerformanceTrace.cpp \
     QRegexSearch.cpp \
     QuickFindWidget.cpp \
     RecentFilesListManager.cpp \
@@ -87,14 +91,18 @@ SOURCES += \
     decorators/ApplicationDecorator.cpp \
     decorators/AutoCompletion.cpp \
     decorators/AutoIndentation.cpp \
+    decorators/BackgroundLexer.cpp \
     decorators/BetterMultiSelection.cpp \
     decorators/EditorConfigAppDecorator.cpp \
+    decorators/PersistentUndoAppDecorator.cpp \
     decorators/SurroundSelection.cpp \
     docks/EditorInspectorDock.cpp \
     dialogs/FindReplaceDialog.cpp \
     docks/FolderAsWorkspaceDock.cpp \
     docks/LanguageInspectorDock.cpp \
     docks/LuaConsoleDock.cpp \
+    docks/MinimapDock.cpp \
+    docks/PerformanceDock.cpp \
     dialogs/MacroRunDialog.cpp \
     dialogs/MacroSaveDialog.cpp \
     dialogs/MainWindow.cpp \
@@ -106,20 +114,24 @@ SOURCES += \
     decorators/LineNumbers.cpp \
     decorators/SmartHighlighter.cpp \
     widgets/EditorInfoStatusBar.cpp \
+    widgets/MinimapWidget.cpp \
     widgets/StatusLabel.cpp
 
 HEADERS += \
     ColorPickerDelegate.h \
     ComboBoxDelegate.h \
+    ContentSniffer.h \
     DockedEditor.h \
     DockedEditorTitleBar.h \
     EditorManager.h \
+    EditorNotificationHub.h \
     EditorPrintPreviewRenderer.h \
     Finder.h \
     FocusWatcher.h \
     IFaceTable.h \
     IFaceTableMixer.h \
     LanguageKeywordsModel.h \
+    LanguageProfile.h \
     LanguagePropertiesModel.h \
     LanguageStylesModel.h \
     LuaExtension.h \
@@ -127,6 +139,7 @@ HEADERS += \
     MacroRecorder.h \
     NotepadNextApplication.h \
     NppImporter.h \
+    PerformanceTrace.h \
     QRegexSearch.h \
     QuickFindWidget.h \
     RecentFilesListManager.h \
@@ -140,14 +153,18 @@ HEADERS += \
     decorators/ApplicationDecorator.h \
     decorators/AutoCompletion.h \
     decorators/AutoIndentation.h \
+    decorators/BackgroundLexer.h \
     decorators/BetterMultiSelection.h \
     decorators/EditorConfigAppDecorator.h \
+    decorators/PersistentUndoAppDecorator.h \
     decorators/SurroundSelection.h \
     docks/EditorInspectorDock.h \
     dialogs/FindReplaceDialog.h \
     docks/FolderAsWorkspaceDock.h \
     docks/LanguageInspectorDock.h \
     docks/LuaConsoleDock.h \
+    docks/MinimapDock.h \
+    docks/PerformanceDock.h \
     dialogs/MacroRunDialog.h \
     dialogs/MacroSaveDialog.h \
     dialogs/MainWindow.h \
@@ -158,6 +175,7 @@ HEADERS += \
     decorators/LineNumbers.h \
     decorators/SmartHighlighter.h \
     widgets/EditorInfoStatusBar.h \
+    widgets/MinimapWidget.h \
     widgets/StatusLabel.h
 
 FORMS += \
@@ -168,6 +186,8 @@ FORMS += \
     dialogs/MainWindow.ui \
     dialogs/FindReplaceDialog.ui \
     docks/LuaConsoleDock.ui \
+    docks/MinimapDock.ui \
+    docks/PerformanceDock.ui \
     dialogs/MacroRunDialog.ui \
     dialogs/MacroSaveDialog.ui \
     dialogs/PreferencesDialog.ui
@@ -188,8 +208,8 @@ DEFINES += LUA_VERSION_NUM=503
 
 INCLUDEPATH += $$PWD/../lexilla/include
 
-win32-g++:LIBS += libUser32
-win32-msvc*:LIBS += User32.lib
+win32-g++:LIBS += libUser32 libPsapi
+win32-msvc*:LIBS += User32.lib Psapi.lib
 
 OBJECTS_DIR = build/obj
 MOC_DIR = build/moc
@@ -22,16 +22,16 @@
 #include "RecentFilesListManager.h"
 #include "EditorManager.h"
 #include "LuaExtension.h"
+#include "LanguageProfile.h"
+#include "PerformanceTrace.h"
 
 #include "LuaState.h"
 #include "lua.hpp"
 #include "LuaBridge.h"
 
+#include "BackgroundLexer.h"
 #include "EditorConfigAppDecorator.h"
-
-#include "ILexer.h"
-#include "Lexilla.h"
-#include "SciLexer.h"
+#include "PersistentUndoAppDecorator.h"
 
 #include <QCommandLineParser>
 #include <QSettings>
@@ -54,6 +54,18 @@ struct luabridge::Stack <QString const&>
 };
 
 
+static void addCommandLineOptions(QCommandLineParser &parser)
+{
+    parser.setApplicationDescription("Notepad Next");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    // TODO: add more options
+    parser.addOption(QCommandLineOption("trace", "Record a performance trace and save it to <file> on exit.", "file"));
+    parser.addPositionalArgument("files", "The files to open.");
+}
+
+
 NotepadNextApplication::NotepadNextApplication(int &argc, char **argv)
     : SingleApplication(argc, argv, true, opts)
 {
@@ -64,6 +76,20 @@ bool NotepadNextApplication::init()
 {
     qInfo(Q_FUNC_INFO);
 
+    // Start tracing before anything else so the whole of startup is recorded
+    QCommandLineParser parser;
+    addCommandLineOptions(parser);
+    if (parser.parse(SingleApplication::arguments()) && parser.isSet("trace")) {
+        const QString traceFilePath = parser.value("trace");
+
+        PerformanceTrace::setEnabled(true);
+        connect(this, &NotepadNextApplication::aboutToQuit, this, [=]() {
+            PerformanceTrace::writeChromeTrace(traceFilePath);
+        });
+    }
+
+    TRACE_SCOPE("startup", "NotepadNextApplication::init");
+
     luaState = new LuaState();
 
     recentFilesListManager = new RecentFilesListManager(this);
@@ -95,9 +121,16 @@ bool NotepadNextApplication::init()
     EditorConfigAppDecorator *ecad = new EditorConfigAppDecorator(this);
     ecad->setEnabled(true);
 
+    PersistentUndoAppDecorator *puad = new PersistentUndoAppDecorator(this);
+    puad->setEnabled(settings->persistUndoHistory());
+    connect(settings, &Settings::persistUndoHistoryChanged, puad, &PersistentUndoAppDecorator::setEnabled);
+
     luaState->executeFile(":/scripts/init.lua");
     LuaExtension::Instance().Initialise(luaState->L, Q_NULLPTR);
 
+    // The language definitions do not change once loaded so build the extension lookup once
+    languageExtensions = LanguageProfile::extensionsFromLua(luaState->L);
+
     // LuaBridge is not a long term solution
     // This is probably temporary, but it is quick and works
     luabridge::setHideMetatables(false);
@@ -108,6 +141,7 @@ bool NotepadNextApplication::init()
                 .addFunction("showToolBar", &Settings::setShowToolBar)
                 .addFunction("showTabBar", &Settings::setShowTabBar)
                 .addFunction("showStatusBar", &Settings::setShowStatusBar)
+                .addFunction("persistUndoHistory", &Settings::setPersistUndoHistory)
             .endClass()
         .endNamespace();
     luabridge::setGlobal(luaState->L, settings, "settings");
@@ -203,75 +237,31 @@ QStringList NotepadNextApplication::getLanguages() const
 
 void NotepadNextApplication::setEditorLanguage(ScintillaNext *editor, const QString &languageName) const
 {
-    LuaExtension::Instance().setEditor(editor);
-
-    getLuaState()->execute(QString("languageName = \"%1\"").arg(QString(languageName)).toLatin1().constData());
-    const QString lexer = getLuaState()->executeAndReturn<QString>("return languages[languageName].lexer");
-
-    editor->languageName = languageName;
-    editor->languageSingleLineComment = getLuaState()->executeAndReturn<QString>("return languages[languageName].singleLineComment or \"\"").toUtf8();
-
-    auto lexerInstance = CreateLexer(lexer.toLatin1().constData());
-    editor->setILexer((sptr_t) lexerInstance);
-
-    getLuaState()->execute(R"(
-        local L = languages[languageName]
-
-        editor.UseTabs = (L.tabSettings or "tabs") == "tabs"
-        editor.TabWidth = L.tabSize or 4
-        editor.MarginWidthN[2] = L.disableFoldMargin and 0 or 16
-        if L.styles then
-            for name, style in pairs(L.styles) do
-                editor.StyleFore[style.id] = style.fgColor
-                editor.StyleBack[style.id] = style.bgColor
-                if style.fontStyle then
-                    if style.fontStyle & 1 == 1 then
-                        editor.StyleBold[style.id] = true
-                    end
-                    if style.fontStyle & 2 == 2 then
-                        editor.StyleItalic[style.id] = true
-                    end
-                    if style.fontStyle & 4 == 4 then
-                        editor.StyleUnderline[style.id] = true
-                    end
-                    if style.fontStyle & 8 == 8 then
-                        editor.StyleEOLFilled[style.id] = true
-                    end
-                end
-            end
-        end
-        if L.keywords then
-            for id, kw in pairs(L.keywords) do
-                editor.KeyWords[id] = kw
-            end
-        end
-        if L.properties then
-            for p,v in pairs(L.properties) do
-                editor.Property[p] = v
-            end
-        end
-        editor.Property["fold"] = "1"
-        editor.Property["fold.compact"] = "0"
-    )");
+    auto it = languageProfiles.constFind(languageName);
+
+    // Resolve the language out of Lua the first time it is used, afterwards it is applied natively
+    if (it == languageProfiles.constEnd()) {
+        LanguageProfile profile;
+
+        if (!LanguageProfile::fromLua(getLuaState()->L, languageName, profile)) {
+            qWarning("Unknown language: %s", qUtf8Printable(languageName));
+            return;
+        }
+
+        it = languageProfiles.insert(languageName, profile);
+    }
+
+    it.value().applyTo(editor);
+
+    BackgroundLexer *backgroundLexer = editor->findChild<BackgroundLexer *>();
+    if (backgroundLexer) {
+        backgroundLexer->setLanguage(it.value());
+    }
 }
 
 QString NotepadNextApplication::detectLanguageFromExtension(const QString &extension) const
 {
-    qInfo(Q_FUNC_INFO);
-
-    return getLuaState()->executeAndReturn<QString>(QString(R"(
-    local ext = "%1"
-    for name, L in pairs(languages) do
-        if L.extensions then
-            for _, v in ipairs(L.extensions) do
-                if v == ext then
-                    return name
-                end
-            end
-        end
-    end
-    return "Text"
-    )").arg(extension).toLatin1().constData());
+    return languageExtensions.value(extension, QStringLiteral("Text"));
 }
 
 void NotepadNextApplication::loadSystemDefaultTranslation()
@@ -292,12 +282,7 @@ void NotepadNextApplication::applyArguments(const QStringList &args)
     qInfo(Q_FUNC_INFO);
 
     QCommandLineParser parser;
-    parser.setApplicationDescription("Notepad Next");
-    parser.addHelpOption();
-    parser.addVersionOption();
-
-    // TODO: add more options
-    parser.addPositionalArgument("files", "The files to open.");
+    addCommandLineOptions(parser);
 
     parser.process(args);
 
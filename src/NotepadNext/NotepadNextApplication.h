@@ -20,10 +20,12 @@
 #ifndef NOTEPADNEXTAPPLICATION_H
 #define NOTEPADNEXTAPPLICATION_H
 
+#include "LanguageProfile.h"
 #include "Settings.h"
 
 #include "SingleApplication"
 
+#include <QHash>
 #include <QPointer>
 #include <QTranslator>
 
@@ -63,6 +65,9 @@ private:
 
     LuaState *luaState = Q_NULLPTR;
 
+    QHash<QString, QString> languageExtensions;
+    mutable QHash<QString, LanguageProfile> languageProfiles;
+
     QList<MainWindow *> windows;
     QPointer<QWidget> currentlyFocusedWidget; // Keep a weak pointer to the QWidget since we don't own it
 
@@ -0,0 +1,213 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "PerformanceTrace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace PerformanceTrace
+{
+
+std::atomic<bool> enabled(false);
+
+namespace
+{
+
+// Enough for a few seconds of busy work on each thread
+const size_t EventsPerThread = 64 * 1024;
+
+struct Event {
+    const char *category;
+    const char *name;
+    qint64 start;
+    qint64 duration;
+    QByteArray detail;
+};
+
+// The owning thread is the only writer, the mutex is only ever contended while saving a trace
+struct ThreadBuffer {
+    int id;
+    QString name;
+    std::mutex mutex;
+    std::vector<Event> events;
+    size_t next = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+// Buffers outlive their threads so spans from finished worker threads can still be saved
+Registry &registry()
+{
+    static Registry r;
+    return r;
+}
+
+const QElapsedTimer &clock()
+{
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+ThreadBuffer &currentThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+    if (!buffer) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> guard(r.mutex);
+
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->id = static_cast<int>(r.buffers.size()) + 1;
+
+        QThread *thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+            buffer->name = QStringLiteral("Main Thread");
+        else if (!thread->objectName().isEmpty())
+            buffer->name = QStringLiteral("%1 %2").arg(thread->objectName()).arg(buffer->id);
+        else
+            buffer->name = QStringLiteral("Thread %1").arg(buffer->id);
+
+        buffer->events.reserve(EventsPerThread);
+        r.buffers.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+}
+
+void setEnabled(bool enable)
+{
+    // Start the clock so the first span does not have to
+    clock();
+
+    enabled = enable;
+}
+
+void clear()
+{
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+
+    for (const auto &buffer : r.buffers) {
+        std::lock_guard<std::mutex> bufferGuard(buffer->mutex);
+        buffer->events.clear();
+        buffer->next = 0;
+    }
+}
+
+qint64 now()
+{
+    return clock().nsecsElapsed();
+}
+
+void record(const char *category, const char *name, const QByteArray &detail, qint64 start)
+{
+    const qint64 end = now();
+    ThreadBuffer &buffer = currentThreadBuffer();
+    std::lock_guard<std::mutex> guard(buffer.mutex);
+
+    Event event{category, name, start, end - start, detail};
+
+    if (buffer.events.size() < EventsPerThread) {
+        buffer.events.push_back(std::move(event));
+    }
+    else {
+        buffer.events[buffer.next] = std::move(event);
+        buffer.next = (buffer.next + 1) % EventsPerThread;
+    }
+}
+
+bool writeChromeTrace(const QString &filePath)
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    traceEvents.append(QJsonObject{
+        {"name", "process_name"},
+        {"ph", "M"},
+        {"pid", pid},
+        {"args", QJsonObject{{"name", QCoreApplication::applicationName()}}},
+    });
+
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+
+    for (const auto &buffer : r.buffers) {
+        std::lock_guard<std::mutex> bufferGuard(buffer->mutex);
+
+        traceEvents.append(QJsonObject{
+            {"name", "thread_name"},
+            {"ph", "M"},
+            {"pid", pid},
+            {"tid", buffer->id},
+            {"args", QJsonObject{{"name", buffer->name}}},
+        });
+
+        for (const Event &event : buffer->events) {
+            // Chrome expects microseconds
+            QJsonObject object{
+                {"name", event.name},
+                {"cat", event.category},
+                {"ph", "X"},
+                {"ts", event.start / 1000.0},
+                {"dur", event.duration / 1000.0},
+                {"pid", pid},
+                {"tid", buffer->id},
+            };
+
+            if (!event.detail.isEmpty())
+                object.insert("args", QJsonObject{{"detail", QString::fromUtf8(event.detail)}});
+
+            traceEvents.append(object);
+        }
+    }
+
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Cannot write trace to \"%s\": %s", qUtf8Printable(filePath), qUtf8Printable(file.errorString()));
+        return false;
+    }
+
+    file.write(QJsonDocument(QJsonObject{{"traceEvents", traceEvents}, {"displayTimeUnit", "ms"}}).toJson(QJsonDocument::Compact));
+
+    return file.commit();
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PERFORMANCETRACE_H
+#define PERFORMANCETRACE_H
+
+#include <QByteArray>
+#include <QString>
+
+#include <atomic>
+
+
+// Records how long scoped spans of work take so a trace can be saved and opened in
+// chrome://tracing or https://ui.perfetto.dev to see where the time goes.
+//
+// Recording is off until setEnabled(true) is called, so a span costs a single check when it is
+// not wanted. Each thread writes to its own fixed size ring buffer, so only the most recent spans
+// are kept. Building with CONFIG+=notracing removes the spans completely.
+namespace PerformanceTrace
+{
+
+extern std::atomic<bool> enabled;
+
+inline bool isEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void setEnabled(bool enable);
+void clear();
+
+// Writes everything recorded so far in the Chrome trace event format
+bool writeChromeTrace(const QString &filePath);
+
+// Nanoseconds since tracing was first used
+qint64 now();
+void record(const char *category, const char *name, const QByteArray &detail, qint64 start);
+
+// The category and name must be string literals as only the pointers are kept
+class Span
+{
+public:
+    Span(const char *category, const char *name) :
+        category(category), name(name), start(isEnabled() ? now() : -1) {}
+    // The detail is only worked out when recording
+    template<typename Detail>
+    Span(const char *category, const char *name, Detail detail) :
+        category(category), name(name), start(isEnabled() ? now() : -1)
+    {
+        if (start >= 0)
+            this->detail = QString(detail()).toUtf8();
+    }
+    ~Span()
+    {
+        if (start >= 0)
+            record(category, name, detail, start);
+    }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+private:
+    const char *category;
+    const char *name;
+    qint64 start;
+    QByteArray detail;
+};
+
+}
+
+#ifdef NOTEPADNEXT_NO_TRACING
+#define TRACE_SCOPE(category, name) ((void)0)
+#define TRACE_SCOPE_DETAIL(category, name, detail) ((void)0)
+#else
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(category, name) const PerformanceTrace::Span TRACE_CONCAT(traceSpan, __LINE__)(category, name)
+#define TRACE_SCOPE_DETAIL(category, name, detail) const PerformanceTrace::Span TRACE_CONCAT(traceSpan, __LINE__)(category, name, [&]() { return detail; })
+#endif
+
+#endif // PERFORMANCETRACE_H
@@ -18,6 +18,7 @@
 
 
 #include "QRegexSearch.h"
+#include "PerformanceTrace.h"
 
 #include <QtGlobal>
 #include <QRegularExpression>
@@ -52,6 +53,8 @@ Sci::Position QRegexSearch::FindText(Document *doc, Sci::Position minPos, Sci::P
     //qInfo("\tflags %d", flags);
     //qInfo("length %d", length);
 
+    TRACE_SCOPE("search", "QRegexSearch::FindText");
+
     // No need to search an empty range
     if (minPos == maxPos)
         return -1;
@@ -85,7 +88,7 @@ const char *QRegexSearch::SubstituteByPosition(Document *doc, const char *text,
 {
     Q_UNUSED(doc);
 
-    qInfo(Q_FUNC_INFO);
+    TRACE_SCOPE("search", "QRegexSearch::SubstituteByPosition");
 
     Q_ASSERT(match.isValid());
     Q_ASSERT(match.hasMatch());
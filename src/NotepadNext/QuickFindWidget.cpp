@@ -26,6 +26,7 @@
 #include <QLineEdit>
 #include <QShortcut>
 #include <QScrollBar>
+#include <QVector>
 
 QuickFindWidget::QuickFindWidget(QWidget *parent) :
     QFrame(parent),
@@ -108,17 +109,16 @@ void QuickFindWidget::highlightMatches()
 {
     qInfo(Q_FUNC_INFO);
 
-    clearHighlights();
-
     const QString text = ui->lineEdit->text();
 
     if (text.isEmpty()) {
+        clearHighlights();
         setSearchContextColor("blue");
         return;
     }
 
     bool foundOne = false;
-    editor->setIndicatorCurrent(28);
+    QVector<Sci_Position> ranges;
     editor->setSearchFlags(computeSearchFlags());
     editor->forEachMatch(text, [&](int start, int end) {
         foundOne = true;
@@ -126,13 +126,19 @@ void QuickFindWidget::highlightMatches()
         const int length = end - start;
 
         // Don't highlight 0 length matches
-        if (length > 0)
-            editor->indicatorFillRange(start, length);
+        if (length > 0) {
+            ranges.append(start);
+            ranges.append(length);
+        }
 
         // Advance at least 1 character to prevent infinite loop
         return qMax(start + 1, end);
     });
 
+    // Matches come back in order so they can replace the old highlights in one go
+    editor->setIndicatorCurrent(28);
+    editor->indicatorReplaceRanges(ranges.size() / 2, reinterpret_cast<sptr_t>(ranges.constData()));
+
     if (foundOne == false) {
         setSearchContextColor("red");
     }
@@ -1869,6 +1869,7 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_CALLTIPSETPOSSTART", 2214 },
     { "SCI_CALLTIPUSESTYLE", 2212 },
     { "SCI_DISTANCETOSECONDARYSTYLES", 4025 },
+    { "SCI_FINDTEXTFULL", 2196 },
     { "SCI_FOLDDISPLAYTEXTSETSTYLE", 2701 },
     { "SCI_GETACCESSIBILITY", 2703 },
     { "SCI_GETADDITIONALCARETFORE", 2605 },
@@ -1925,12 +1926,16 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_GETHSCROLLBAR", 2131 },
     { "SCI_GETIDENTIFIER", 2623 },
     { "SCI_GETIDLESTYLING", 2693 },
+    { "SCI_GETIDLETASKS", 7011 },
     { "SCI_GETIMEINTERACTION", 2678 },
     { "SCI_GETINDENT", 2123 },
     { "SCI_GETINDENTATIONGUIDES", 2133 },
     { "SCI_GETINDICATORCURRENT", 2501 },
+    { "SCI_GETINDICATORRUNS", 7012 },
     { "SCI_GETINDICATORVALUE", 2503 },
     { "SCI_GETLAYOUTCACHE", 2273 },
+    { "SCI_GETLAYOUTCACHEBUDGET", 7004 },
+    { "SCI_GETLAYOUTCACHESTATISTIC", 7005 },
     { "SCI_GETLENGTH", 2006 },
     { "SCI_GETLEXER", 4002 },
     { "SCI_GETLEXERLANGUAGE", 4012 },
@@ -1957,6 +1962,7 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_GETMARGINWIDTHN", 2243 },
     { "SCI_GETMAXLINESTATE", 2094 },
     { "SCI_GETMODEVENTMASK", 2378 },
+    { "SCI_GETMODIFICATIONCOUNT", 7017 },
     { "SCI_GETMODIFY", 2159 },
     { "SCI_GETMOUSEDOWNCAPTURES", 2385 },
     { "SCI_GETMOUSEDWELLTIME", 2265 },
@@ -2002,6 +2008,7 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_GETSELEOLFILLED", 2479 },
     { "SCI_GETSTATUS", 2383 },
     { "SCI_GETSTYLEAT", 2010 },
+    { "SCI_GETSTYLEDTEXTFULL", 2778 },
     { "SCI_GETSTYLEFROMSUBSTYLE", 4027 },
     { "SCI_GETSUBSTYLEBASES", 4026 },
     { "SCI_GETSUBSTYLESLENGTH", 4022 },
@@ -2015,7 +2022,17 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_GETTARGETTEXT", 2687 },
     { "SCI_GETTECHNOLOGY", 2631 },
     { "SCI_GETTEXTLENGTH", 2183 },
+    { "SCI_GETTEXTRANGEFULL", 2039 },
+    { "SCI_GETTEXTSEGMENT", 7015 },
+    { "SCI_GETUNDOACTIONPOSITION", 2803 },
+    { "SCI_GETUNDOACTIONS", 2790 },
+    { "SCI_GETUNDOACTIONTEXT", 2804 },
+    { "SCI_GETUNDOACTIONTYPE", 2802 },
     { "SCI_GETUNDOCOLLECTION", 2019 },
+    { "SCI_GETUNDOCURRENT", 2798 },
+    { "SCI_GETUNDOMEMORY", 7002 },
+    { "SCI_GETUNDOMEMORYLIMIT", 7001 },
+    { "SCI_GETUNDOSAVEPOINT", 2792 },
     { "SCI_GETUSETABS", 2125 },
     { "SCI_GETVIEWEOL", 2355 },
     { "SCI_GETVIEWWS", 2020 },
@@ -2122,6 +2139,7 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_SETINDICATORVALUE", 2502 },
     { "SCI_SETKEYWORDS", 4005 },
     { "SCI_SETLAYOUTCACHE", 2272 },
+    { "SCI_SETLAYOUTCACHEBUDGET", 7003 },
     { "SCI_SETLEXER", 4001 },
     { "SCI_SETLEXERLANGUAGE", 4006 },
     { "SCI_SETLINEENDTYPESALLOWED", 2656 },
@@ -2176,6 +2194,7 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_SETSELECTIONSTART", 2142 },
     { "SCI_SETSELEOLFILLED", 2480 },
     { "SCI_SETSTATUS", 2382 },
+    { "SCI_SETSTYLINGCHECKPOINT", 7016 },
     { "SCI_SETTABDRAWMODE", 2699 },
     { "SCI_SETTABINDENTS", 2260 },
     { "SCI_SETTABWIDTH", 2036 },
@@ -2183,6 +2202,9 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SCI_SETTARGETSTART", 2190 },
     { "SCI_SETTECHNOLOGY", 2630 },
     { "SCI_SETUNDOCOLLECTION", 2012 },
+    { "SCI_SETUNDOCURRENT", 2797 },
+    { "SCI_SETUNDOMEMORYLIMIT", 7000 },
+    { "SCI_SETUNDOSAVEPOINT", 2791 },
     { "SCI_SETUSETABS", 2124 },
     { "SCI_SETVIEWEOL", 2356 },
     { "SCI_SETVIEWWS", 2021 },
@@ -2449,6 +2471,7 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SC_CURSORREVERSEARROW", 7 },
     { "SC_CURSORWAIT", 4 },
     { "SC_DOCUMENTOPTION_DEFAULT", 0 },
+    { "SC_DOCUMENTOPTION_PIECE_TABLE", 0x200 },
     { "SC_DOCUMENTOPTION_STYLES_NONE", 0x1 },
     { "SC_DOCUMENTOPTION_TEXT_LARGE", 0x100 },
     { "SC_EFF_QUALITY_ANTIALIASED", 2 },
@@ -2480,6 +2503,12 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SC_IDLESTYLING_ALL", 3 },
     { "SC_IDLESTYLING_NONE", 0 },
     { "SC_IDLESTYLING_TOVISIBLE", 1 },
+    { "SC_IDLETASK_ACTIVE", 16 },
+    { "SC_IDLETASK_LAYOUT", 4 },
+    { "SC_IDLETASK_NONE", 0 },
+    { "SC_IDLETASK_QUEUED", 8 },
+    { "SC_IDLETASK_STYLE", 2 },
+    { "SC_IDLETASK_WRAP", 1 },
     { "SC_IME_INLINE", 1 },
     { "SC_IME_WINDOWED", 0 },
     { "SC_INDICFLAG_VALUEFORE", 1 },
@@ -2490,6 +2519,11 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SC_IV_NONE", 0 },
     { "SC_IV_REAL", 1 },
     { "SC_LASTSTEPINUNDOREDO", 0x100 },
+    { "SC_LAYOUTCACHE_ENTRIES", 3 },
+    { "SC_LAYOUTCACHE_EVICTIONS", 2 },
+    { "SC_LAYOUTCACHE_HITS", 0 },
+    { "SC_LAYOUTCACHE_MEMORY", 4 },
+    { "SC_LAYOUTCACHE_MISSES", 1 },
     { "SC_LINECHARACTERINDEX_NONE", 0 },
     { "SC_LINECHARACTERINDEX_UTF16", 2 },
     { "SC_LINECHARACTERINDEX_UTF32", 1 },
@@ -2604,6 +2638,11 @@ static std::vector<IFaceConstant> ifaceConstants = {
     { "SC_TYPE_BOOLEAN", 0 },
     { "SC_TYPE_INTEGER", 1 },
     { "SC_TYPE_STRING", 2 },
+    { "SC_UNDO_ACTION_CONTAINER", 3 },
+    { "SC_UNDO_ACTION_INSERT", 0 },
+    { "SC_UNDO_ACTION_MAY_COALESCE", 0x100 },
+    { "SC_UNDO_ACTION_REMOVE", 1 },
+    { "SC_UNDO_ACTION_START", 2 },
     { "SC_UPDATE_CONTENT", 0x1 },
     { "SC_UPDATE_H_SCROLL", 0x8 },
     { "SC_UPDATE_SELECTION", 0x2 },
@@ -2679,6 +2718,7 @@ static std::vector<IFaceFunction> ifaceFunctions = {
     { "CanUndo", 2174, iface_bool, { iface_void, iface_void } },
     { "Cancel", 2325, iface_void, { iface_void, iface_void } },
     { "ChangeInsertion", 2672, iface_void, { iface_length, iface_string } },
+    { "ChangeLastUndoActionText", 2801, iface_void, { iface_position, iface_string } },
     { "ChangeLexerState", 2617, iface_int, { iface_position, iface_position } },
     { "CharLeft", 2304, iface_void, { iface_void, iface_void } },
     { "CharLeftExtend", 2305, iface_void, { iface_void, iface_void } },
@@ -2739,6 +2779,7 @@ static std::vector<IFaceFunction> ifaceFunctions = {
     { "FindIndicatorHide", 2642, iface_void, { iface_void, iface_void } },
     { "FindIndicatorShow", 2640, iface_void, { iface_position, iface_position } },
     { "FindText", 2150, iface_position, { iface_int, iface_findtext } },
+    { "FindTextFull", 2196, iface_position, { iface_int, iface_findtextfull } },
     { "FoldAll", 2662, iface_void, { iface_int, iface_void } },
     { "FoldChildren", 2238, iface_void, { iface_int, iface_int } },
     { "FoldLine", 2237, iface_void, { iface_int, iface_int } },
@@ -2757,8 +2798,11 @@ static std::vector<IFaceFunction> ifaceFunctions = {
     { "GetRangePointer", 2643, iface_int, { iface_position, iface_int } },
     { "GetSelText", 2161, iface_int, { iface_void, iface_stringresult } },
     { "GetStyledText", 2015, iface_int, { iface_void, iface_textrange } },
+    { "GetStyledTextFull", 2778, iface_position, { iface_void, iface_textrangefull } },
     { "GetText", 2182, iface_int, { iface_length, iface_stringresult } },
     { "GetTextRange", 2162, iface_int, { iface_void, iface_textrange } },
+    { "GetTextRangeFull", 2039, iface_position, { iface_void, iface_textrangefull } },
+    { "GetTextSegment", 7015, iface_int, { iface_position, iface_int } },
     { "GotoLine", 2024, iface_void, { iface_int, iface_void } },
     { "GotoPos", 2025, iface_void, { iface_position, iface_void } },
     { "GrabFocus", 2400, iface_void, { iface_void, iface_void } },
@@ -2776,6 +2820,8 @@ static std::vector<IFaceFunction> ifaceFunctions = {
     { "IndicatorClearRange", 2505, iface_void, { iface_position, iface_int } },
     { "IndicatorEnd", 2509, iface_int, { iface_int, iface_position } },
     { "IndicatorFillRange", 2504, iface_void, { iface_position, iface_int } },
+    { "IndicatorFillRanges", 7009, iface_void, { iface_position, iface_int } },
+    { "IndicatorReplaceRanges", 7010, iface_void, { iface_position, iface_int } },
     { "IndicatorStart", 2508, iface_int, { iface_int, iface_position } },
     { "IndicatorValueAt", 2507, iface_int, { iface_int, iface_position } },
     { "InsertText", 2003, iface_void, { iface_position, iface_string } },
@@ -2857,6 +2903,7 @@ static std::vector<IFaceFunction> ifaceFunctions = {
     { "PrivateLexerCall", 4013, iface_int, { iface_int, iface_int } },
     { "PropertyNames", 4014, iface_int, { iface_void, iface_stringresult } },
     { "PropertyType", 4015, iface_int, { iface_string, iface_void } },
+    { "PushUndoActionType", 2800, iface_void, { iface_int, iface_position } },
     { "Redo", 2011, iface_void, { iface_void, iface_void } },
     { "RegisterImage", 2405, iface_void, { iface_int, iface_string } },
     { "RegisterRGBAImage", 2627, iface_void, { iface_int, iface_string } },
@@ -2866,6 +2913,8 @@ static std::vector<IFaceFunction> ifaceFunctions = {
     { "ReplaceSel", 2170, iface_void, { iface_void, iface_string } },
     { "ReplaceTarget", 2194, iface_int, { iface_length, iface_string } },
     { "ReplaceTargetRE", 2195, iface_int, { iface_length, iface_string } },
+    { "ResetLayoutCacheStatistics", 7006, iface_void, { iface_void, iface_void } },
+    { "ResetPositionCacheStatistics", 7008, iface_void, { iface_void, iface_void } },
     { "RotateSelection", 2606, iface_void, { iface_void, iface_void } },
     { "ScrollCaret", 2169, iface_void, { iface_void, iface_void } },
     { "ScrollRange", 2569, iface_void, { iface_position, iface_position } },
@@ -2890,6 +2939,7 @@ static std::vector<IFaceFunction> ifaceFunctions = {
     { "SetSelFore", 2067, iface_void, { iface_bool, iface_colour } },
     { "SetSelection", 2572, iface_void, { iface_position, iface_position } },
     { "SetStyling", 2033, iface_void, { iface_length, iface_int } },
+    { "SetStylingCheckpoint", 7016, iface_bool, { iface_length, iface_string } },
     { "SetStylingEx", 2073, iface_void, { iface_length, iface_string } },
     { "SetTargetRange", 2686, iface_void, { iface_position, iface_position } },
     { "SetText", 2181, iface_void, { iface_void, iface_string } },
@@ -3041,6 +3091,7 @@ static std::vector<IFaceProperty> ifaceProperties = {
     { "Identifier", 2623, 2622, iface_int, iface_void },
     { "Identifiers", 0, 4024, iface_string, iface_int },
     { "IdleStyling", 2693, 2692, iface_int, iface_void },
+    { "IdleTasks", 7011, 0, iface_int, iface_void },
     { "Indent", 2123, 2122, iface_int, iface_void },
     { "IndentationGuides", 2133, 2132, iface_int, iface_void },
     { "IndicAlpha", 2524, 2523, iface_int, iface_int },
@@ -3052,9 +3103,12 @@ static std::vector<IFaceProperty> ifaceProperties = {
     { "IndicStyle", 2081, 2080, iface_int, iface_int },
     { "IndicUnder", 2511, 2510, iface_bool, iface_int },
     { "IndicatorCurrent", 2501, 2500, iface_int, iface_void },
+    { "IndicatorRuns", 7012, 0, iface_position, iface_int },
     { "IndicatorValue", 2503, 2502, iface_int, iface_void },
     { "KeyWords", 0, 4005, iface_string, iface_int },
     { "LayoutCache", 2273, 2272, iface_int, iface_void },
+    { "LayoutCacheBudget", 7004, 7003, iface_position, iface_void },
+    { "LayoutCacheStatistic", 7005, 0, iface_position, iface_int },
     { "Length", 2006, 0, iface_int, iface_void },
     { "Lexer", 4002, 4001, iface_int, iface_void },
     { "LexerLanguage", 4012, 4006, iface_stringresult, iface_void },
@@ -3066,6 +3120,7 @@ static std::vector<IFaceProperty> ifaceProperties = {
     { "LineEndTypesSupported", 4018, 0, iface_int, iface_void },
     { "LineIndentPosition", 2128, 0, iface_position, iface_int },
     { "LineIndentation", 2127, 2126, iface_int, iface_int },
+    { "LinePixmapCacheBudget", 7014, 7013, iface_position, iface_void },
     { "LineState", 2093, 2092, iface_int, iface_int },
     { "LineVisible", 2228, 0, iface_bool, iface_int },
     { "LinesOnScreen", 2370, 0, iface_int, iface_void },
@@ -3090,6 +3145,7 @@ static std::vector<IFaceProperty> ifaceProperties = {
     { "MarkerFore", 0, 2041, iface_colour, iface_int },
     { "MaxLineState", 2094, 0, iface_int, iface_void },
     { "ModEventMask", 2378, 2359, iface_int, iface_void },
+    { "ModificationCount", 7017, 0, iface_position, iface_void },
     { "Modify", 2159, 0, iface_bool, iface_void },
     { "MouseDownCaptures", 2385, 2384, iface_bool, iface_void },
     { "MouseDwellTime", 2265, 2264, iface_int, iface_void },
@@ -3103,6 +3159,7 @@ static std::vector<IFaceProperty> ifaceProperties = {
     { "PasteConvertEndings", 2468, 2467, iface_bool, iface_void },
     { "PhasesDraw", 2673, 2674, iface_int, iface_void },
     { "PositionCache", 2515, 2514, iface_int, iface_void },
+    { "PositionCacheStatistic", 7007, 0, iface_position, iface_int },
     { "PrimaryStyleFromStyle", 4028, 0, iface_int, iface_int },
     { "PrintColourMode", 2149, 2148, iface_int, iface_void },
     { "PrintMagnification", 2147, 2146, iface_int, iface_void },
@@ -3167,7 +3224,15 @@ static std::vector<IFaceProperty> ifaceProperties = {
     { "TargetText", 2687, 0, iface_stringresult, iface_void },
     { "Technology", 2631, 2630, iface_int, iface_void },
     { "TextLength", 2183, 0, iface_int, iface_void },
+    { "UndoActionPosition", 2803, 0, iface_position, iface_int },
+    { "UndoActionText", 2804, 0, iface_stringresult, iface_int },
+    { "UndoActionType", 2802, 0, iface_int, iface_int },
+    { "UndoActions", 2790, 0, iface_int, iface_void },
     { "UndoCollection", 2019, 2012, iface_bool, iface_void },
+    { "UndoCurrent", 2798, 2797, iface_int, iface_void },
+    { "UndoMemory", 7002, 0, iface_position, iface_void },
+    { "UndoMemoryLimit", 7001, 7000, iface_position, iface_void },
+    { "UndoSavePoint", 2792, 2791, iface_int, iface_void },
     { "UseTabs", 2125, 2124, iface_bool, iface_void },
     { "VScrollBar", 2281, 2280, iface_bool, iface_void },
     { "ViewEOL", 2355, 2356, iface_bool, iface_void },
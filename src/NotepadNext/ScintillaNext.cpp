@@ -19,18 +19,26 @@
 
 #include "ScintillaNext.h"
 #include "ScintillaCommenter.h"
+#include "EditorNotificationHub.h"
+#include "ContentSniffer.h"
+#include "PerformanceTrace.h"
 
 #include "uchardet.h"
 #include <cinttypes>
 
 #include <QDir>
+#include <QElapsedTimer>
 #include <QMouseEvent>
 #include <QSaveFile>
 #include <QTextCodec>
+#include <QtConcurrent>
 
 
 const int CHUNK_SIZE = 1024 * 1024 * 4; // Not sure what is best
 
+// Files at least this big get a piece table document so scattered edits stay cheap
+const qint64 PIECE_TABLE_SIZE = 1024 * 1024 * 64;
+
 
 static bool writeToDisk(const QByteArray &data, const QString &path)
 {
@@ -52,12 +60,15 @@ static bool writeToDisk(const QByteArray &data, const QString &path)
 
 ScintillaNext::ScintillaNext(QString name, QWidget *parent) :
     ScintillaEdit(parent),
-    name(name)
+    name(name),
+    hub(new EditorNotificationHub(this))
 {
 }
 
 ScintillaNext *ScintillaNext::fromFile(const QString &filePath)
 {
+    TRACE_SCOPE_DETAIL("file", "ScintillaNext::fromFile", filePath);
+
     QFileInfo info(filePath);
 
     // TODO: check file permissions
@@ -68,6 +79,12 @@ ScintillaNext *ScintillaNext::fromFile(const QString &filePath)
 
     ScintillaNext *editor = new ScintillaNext(info.fileName());
 
+    if (info.size() >= PIECE_TABLE_SIZE) {
+        sptr_t doc = editor->createDocument(info.size(), SC_DOCUMENTOPTION_PIECE_TABLE);
+        editor->setDocPointer(doc);
+        editor->releaseDocument(doc);
+    }
+
     QFile file(filePath);
     bool readSuccessful = editor->readFromDisk(file);
 
@@ -135,6 +152,18 @@ void ScintillaNext::setFoldMarkers(const QString &type)
     markerDefine(SC_MARKNUM_FOLDERMIDTAIL, types[6]);
 }
 
+void ScintillaNext::startRecord()
+{
+    recordingMacro = true;
+    ScintillaEdit::startRecord();
+}
+
+void ScintillaNext::stopRecord()
+{
+    ScintillaEdit::stopRecord();
+    recordingMacro = false;
+}
+
 void ScintillaNext::close()
 {
     emit closed();
@@ -190,6 +219,8 @@ void ScintillaNext::reload()
         setSavePoint();
     }
 
+    emit reloaded();
+
     return;
 }
 
@@ -320,6 +351,26 @@ void ScintillaNext::uncommentLineSelection()
     sc.uncommentSelection();
 }
 
+void ScintillaNext::paintEvent(QPaintEvent *event)
+{
+    // Scintilla styles and lays out the visible lines as they are painted
+    TRACE_SCOPE("paint", "ScintillaNext::paintEvent");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    ScintillaEdit::paintEvent(event);
+
+    lastPaintTime = timer.nsecsElapsed();
+}
+
+void ScintillaNext::resizeEvent(QResizeEvent *event)
+{
+    TRACE_SCOPE("layout", "ScintillaNext::resizeEvent");
+
+    ScintillaEdit::resizeEvent(event);
+}
+
 void ScintillaNext::dragEnterEvent(QDragEnterEvent *event)
 {
     // Ignore all drag and drop events with urls and let the main application handle it
@@ -342,6 +393,8 @@ void ScintillaNext::dropEvent(QDropEvent *event)
 
 bool ScintillaNext::readFromDisk(QFile &file)
 {
+    TRACE_SCOPE("file", "ScintillaNext::readFromDisk");
+
     if (!file.exists()) {
         qWarning("Cannot read \"%s\": doesn't exist", qUtf8Printable(file.fileName()));
         return false;
@@ -381,8 +434,19 @@ bool ScintillaNext::readFromDisk(QFile &file)
         // - determine space vs tabs
         // - determine indentation size
         if (first_read) {
+            TRACE_SCOPE("file", "detect encoding");
+
             first_read = false;
 
+            // Guess the language from the contents while the encoding is being detected, only files
+            // without any extension need it
+            const QFileInfo info(file);
+            const bool sniffContent = info.suffix().isEmpty() && ContentSniffer::extensionForFileName(info.fileName()).isEmpty();
+            QFuture<QString> sniffedExtension;
+            if (sniffContent) {
+                sniffedExtension = QtConcurrent::run(&ContentSniffer::extensionForContent, info, chunk.left(ContentSniffer::PrefixSize));
+            }
+
             // Try uchardet library first
             uchardet_t ud = uchardet_new();
             if (uchardet_handle_data(ud, chunk.constData(), chunk.size()) != 0) {
@@ -410,8 +474,12 @@ bool ScintillaNext::readFromDisk(QFile &file)
 
                 qWarning("Using: %s", qUtf8Printable(codec->name()));
             }
+
+            contentExtension = sniffContent ? sniffedExtension.result() : QString();
         }
 
+        TRACE_SCOPE("file", "decode and append");
+
         QByteArray utf8_data = decoder->toUnicode(chunk).toUtf8();
         appendText(utf8_data.size(), utf8_data.constData());
     } while (!file.atEnd() && status() == SC_STATUS_OK);
@@ -454,9 +522,16 @@ void ScintillaNext::updateTimestamp()
 
 void ScintillaNext::setFileInfo(const QString &filePath)
 {
+    const QString previousFilePath = fileInfo.absoluteFilePath();
+
     fileInfo.setFile(filePath);
     fileInfo.makeAbsolute();
 
+    // What the contents looked like only applies to the name they were read under
+    if (!previousFilePath.isEmpty() && previousFilePath != fileInfo.absoluteFilePath()) {
+        contentExtension.clear();
+    }
+
     Q_ASSERT(fileInfo.exists());
 
     name = fileInfo.fileName();
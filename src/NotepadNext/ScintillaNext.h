@@ -27,6 +27,8 @@
 #include <QFileInfo>
 
 
+class EditorNotificationHub;
+
 class ScintillaNext : public ScintillaEdit
 {
     Q_OBJECT
@@ -47,14 +49,30 @@ public:
     template<typename Func>
     void forEachLineInSelection(int selection, Func callback);
 
+    // Calls callback(const char *text, Sci_Position length) for each run of the text from start to
+    // end as it is stored, so the document is read in place without being moved or flattened
+    template<typename Func>
+    void forEachTextSegment(Sci_Position start, Sci_Position end, Func callback) const;
+
     bool isFile() const;
     bool isSavedToDisk() const;
     QFileInfo getFileInfo() const;
 
+    // When the file was last modified as of the last time it was read or written
+    QDateTime getModifiedTime() const { return modifiedTime; }
+
     QString getName() const { return name; }
     QString getPath() const;
     QString getFilePath() const;
 
+    // Extension guessed from the file's contents when it was read, empty if nothing was recognized
+    QString getContentExtension() const { return contentExtension; }
+
+    EditorNotificationHub *notificationHub() const { return hub; }
+
+    // How long the most recent paint took, in nanoseconds
+    qint64 lastPaintDuration() const { return lastPaintTime; }
+
     enum FileStateChange {
         NoChange,
         Modified,
@@ -70,6 +88,11 @@ public:
 
     void setFoldMarkers(const QString &type);
 
+    // Hide ScintillaEdit's versions so it is known whether a macro is being recorded
+    void startRecord();
+    void stopRecord();
+    bool isRecordingMacro() const { return recordingMacro; }
+
     QString languageName;
     QByteArray languageSingleLineComment;
 
@@ -92,16 +115,23 @@ signals:
     void saved();
     void closed();
     void renamed();
+    void reloaded();
 
 protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
     void dragEnterEvent(QDragEnterEvent *event) override;
     void dropEvent(QDropEvent *event) override;
 
 private:
     QString name;
+    EditorNotificationHub *hub;
     BufferType bufferType = BufferType::Temporary;
     QFileInfo fileInfo;
     QDateTime modifiedTime;
+    QString contentExtension;
+    qint64 lastPaintTime = 0;
+    bool recordingMacro = false;
 
     bool readFromDisk(QFile &file);
     QDateTime fileTimestamp();
@@ -120,6 +150,22 @@ void ScintillaNext::forEachLineInSelection(int selection, Func callback)
     }
 }
 
+template<typename Func>
+void ScintillaNext::forEachTextSegment(Sci_Position start, Sci_Position end, Func callback) const
+{
+    for (Sci_Position position = start; position < end;) {
+        Sci_Position length = 0;
+        const char *segment = reinterpret_cast<const char *>(textSegment(position, reinterpret_cast<sptr_t>(&length)));
+
+        if (!segment || length <= 0)
+            return;
+
+        length = qMin(length, end - position);
+        callback(segment, length);
+        position += length;
+    }
+}
+
 // Stick this in the header file...because C++, that's why
 template<typename Func>
 void ScintillaNext::forEachMatchInRange(const QByteArray &text, Func callback, Sci_CharacterRange range)
@@ -31,6 +31,8 @@ bool Settings::showStatusBar() const { return m_showStatusBar; }
 
 bool Settings::tabsClosable() const { return m_tabsClosable; }
 
+bool Settings::persistUndoHistory() const { return m_persistUndoHistory; }
+
 
 void Settings::setShowMenuBar(bool showMenuBar)
 {
@@ -76,3 +78,12 @@ void Settings::setTabsClosable(bool tabsClosable)
     m_tabsClosable = tabsClosable;
     emit tabsClosableChanged(m_tabsClosable);
 }
+
+void Settings::setPersistUndoHistory(bool persistUndoHistory)
+{
+    if (m_persistUndoHistory == persistUndoHistory)
+        return;
+
+    m_persistUndoHistory = persistUndoHistory;
+    emit persistUndoHistoryChanged(m_persistUndoHistory);
+}
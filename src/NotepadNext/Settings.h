@@ -34,6 +34,8 @@ class Settings : public QObject
 
     Q_PROPERTY(bool tabsClosable READ tabsClosable WRITE setTabsClosable NOTIFY tabsClosableChanged)
 
+    Q_PROPERTY(bool persistUndoHistory READ persistUndoHistory WRITE setPersistUndoHistory NOTIFY persistUndoHistoryChanged)
+
 
     bool m_showMenuBar = true;
     bool m_showToolBar = true;
@@ -42,6 +44,8 @@ class Settings : public QObject
 
     bool m_tabsClosable = true;
 
+    bool m_persistUndoHistory = false;
+
 public:
     explicit Settings(QObject *parent = nullptr);
 
@@ -52,6 +56,8 @@ public:
 
     bool tabsClosable() const;
 
+    bool persistUndoHistory() const;
+
 signals:
     void showMenuBarChanged(bool showMenuBar);
     void showToolBarChanged(bool showToolBar);
@@ -60,6 +66,8 @@ signals:
 
     void tabsClosableChanged(bool tabsClosable);
 
+    void persistUndoHistoryChanged(bool persistUndoHistory);
+
 public slots:
     void setShowMenuBar(bool showMenuBar);
     void setShowToolBar(bool showToolBar);
@@ -67,6 +75,8 @@ public slots:
     void setShowStatusBar(bool showStatusBar);
 
     void setTabsClosable(bool tabsClosable);
+
+    void setPersistUndoHistory(bool persistUndoHistory);
 };
 
 #endif // SETTINGS_H
@@ -0,0 +1,724 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "BackgroundLexer.h"
+#include "PerformanceTrace.h"
+
+#include "ILexer.h"
+#include "Scintilla.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+using namespace Scintilla;
+
+
+namespace {
+
+// Each batch covers about this much text, enough to be worth a trip to the GUI thread but
+// small enough that committing it does not hold up the event loop
+const Sci_Position BatchSize = 256 * 1024;
+
+// Lexers only look a little way back from where they start, so this much of the editor's
+// existing styling is copied
+const Sci_Position StyleLookBehind = 4096;
+const Sci_Position LineLookBehind = 64;
+
+// Lexers that take checkpoints get a chance to reach one past the edit before the worker starts
+const Sci_Position ConvergenceLines = 128;
+
+// The worker runs lexers that take checkpoints in pieces of this many lines, as the editor does,
+// and hands the editor a checkpoint at the end of each piece
+const Sci_Position LinesPerCheckpoint = 64;
+
+// Give loading and typing a chance to settle before lexing
+const int StartDelay = 500;
+
+// The copy of the text is kept in blocks of about this size, an edit copies the block it lands in
+// if the worker is still reading it and a block is split once it has grown to twice this size
+const int SnapshotBlockSize = 1024 * 1024;
+
+// Styling already in the editor from just before the point where lexing starts
+struct Seed {
+    Sci_Position stylesStart = 0;
+    QByteArray styles;
+    Sci_Position firstLine = 0;
+    QVector<int> levels;
+    QVector<int> lineStates;
+};
+
+// An IDocument over a copy of the editor's text that is only used from the worker thread.
+// Line ends are CR, LF and CR+LF which matches how the editor is set up.
+class SnapshotDocument : public IDocumentSegments
+{
+public:
+    SnapshotDocument(const QVector<QByteArray> &blocks, int codePage, int tabWidth, const Seed &seed) :
+        blocks(blocks),
+        codePage(codePage),
+        tabWidth(std::max(tabWidth, 1))
+    {
+        lineStarts.push_back(0);
+
+        char previous = 0;
+        for (const QByteArray &block : blocks) {
+            blockStarts.push_back(length);
+
+            const char *data = block.constData();
+            for (int i = 0; i < block.size(); ++i) {
+                const char ch = data[i];
+
+                // The LF of a CR+LF moves the start of the line the CR began
+                if (ch == '\n' && previous == '\r') {
+                    lineStarts.back() = length + i + 1;
+                }
+                else if (ch == '\r' || ch == '\n') {
+                    lineStarts.push_back(length + i + 1);
+                }
+                previous = ch;
+            }
+
+            length += block.size();
+        }
+
+        styles.resize(length, 0);
+        levels.resize(lineStarts.size(), SC_FOLDLEVELBASE);
+        lineStates.resize(lineStarts.size(), 0);
+
+        std::copy(seed.styles.cbegin(), seed.styles.cend(), styles.begin() + seed.stylesStart);
+        std::copy(seed.levels.cbegin(), seed.levels.cend(), levels.begin() + seed.firstLine);
+        std::copy(seed.lineStates.cbegin(), seed.lineStates.cend(), lineStates.begin() + seed.firstLine);
+    }
+
+    Sci_Position lines() const { return static_cast<Sci_Position>(lineStarts.size()); }
+    const char *stylesAt(Sci_Position position) const { return styles.data() + position; }
+
+    int SCI_METHOD Version() const override { return dvRelease5; }
+
+    void SCI_METHOD SetErrorStatus(int) override {}
+
+    Sci_Position SCI_METHOD Length() const override { return length; }
+
+    void SCI_METHOD GetCharRange(char *buffer, Sci_Position position, Sci_Position lengthRetrieve) const override
+    {
+        if (position < 0 || lengthRetrieve < 0 || position + lengthRetrieve > Length())
+            return;
+
+        while (lengthRetrieve > 0) {
+            const int index = blockIndex(position);
+            const Sci_Position offset = position - blockStarts[index];
+            const Sci_Position count = std::min<Sci_Position>(lengthRetrieve, blocks[index].size() - offset);
+
+            memcpy(buffer, blocks[index].constData() + offset, count);
+            buffer += count;
+            position += count;
+            lengthRetrieve -= count;
+        }
+    }
+
+    const char * SCI_METHOD TextSegment(Sci_Position position, Sci_Position *segmentStart, Sci_Position *segmentEnd) const override
+    {
+        if (position < 0 || position >= Length())
+            return nullptr;
+
+        // Lexers read each block in place
+        const int index = blockIndex(position);
+        *segmentStart = blockStarts[index];
+        *segmentEnd = blockStarts[index] + blocks[index].size();
+        return blocks[index].constData();
+    }
+
+    char SCI_METHOD StyleAt(Sci_Position position) const override
+    {
+        if (position < 0 || position >= Length())
+            return 0;
+
+        return styles[position];
+    }
+
+    Sci_Position SCI_METHOD LineFromPosition(Sci_Position position) const override
+    {
+        auto it = std::upper_bound(lineStarts.cbegin(), lineStarts.cend(), position);
+        return std::max<Sci_Position>(std::distance(lineStarts.cbegin(), it) - 1, 0);
+    }
+
+    Sci_Position SCI_METHOD LineStart(Sci_Position line) const override
+    {
+        if (line < 0)
+            return 0;
+        if (line >= lines())
+            return Length();
+
+        return lineStarts[line];
+    }
+
+    int SCI_METHOD GetLevel(Sci_Position line) const override
+    {
+        return (line >= 0 && line < lines()) ? levels[line] : SC_FOLDLEVELBASE;
+    }
+
+    int SCI_METHOD SetLevel(Sci_Position line, int level) override
+    {
+        if (line < 0 || line >= lines())
+            return SC_FOLDLEVELBASE;
+
+        return std::exchange(levels[line], level);
+    }
+
+    int SCI_METHOD GetLineState(Sci_Position line) const override
+    {
+        return (line >= 0 && line < lines()) ? lineStates[line] : 0;
+    }
+
+    int SCI_METHOD SetLineState(Sci_Position line, int state) override
+    {
+        if (line < 0 || line >= lines())
+            return 0;
+
+        return std::exchange(lineStates[line], state);
+    }
+
+    void SCI_METHOD StartStyling(Sci_Position position) override { endStyled = position; }
+
+    bool SCI_METHOD SetStyleFor(Sci_Position length, char style) override
+    {
+        length = std::min(length, Length() - endStyled);
+        std::fill_n(styles.begin() + endStyled, length, style);
+        endStyled += length;
+        return true;
+    }
+
+    bool SCI_METHOD SetStyles(Sci_Position length, const char *newStyles) override
+    {
+        length = std::min(length, Length() - endStyled);
+        std::copy(newStyles, newStyles + length, styles.begin() + endStyled);
+        endStyled += length;
+        return true;
+    }
+
+    // Indicators set by lexers are left for the editor's own lexer to add when it gets there
+    void SCI_METHOD DecorationSetCurrentIndicator(int) override {}
+    void SCI_METHOD DecorationFillRange(Sci_Position, int, Sci_Position) override {}
+
+    void SCI_METHOD ChangeLexerState(Sci_Position, Sci_Position) override {}
+
+    int SCI_METHOD CodePage() const override { return codePage; }
+
+    // Only used for double byte code pages which are not lexed in the background
+    bool SCI_METHOD IsDBCSLeadByte(char) const override { return false; }
+
+    const char * SCI_METHOD BufferPointer() override
+    {
+        if (blocks.size() == 1)
+            return blocks.first().constData();
+
+        // Only lexers that need all of the text at once pay for joining the blocks
+        if (flattened.size() != length) {
+            flattened.resize(length);
+            GetCharRange(flattened.data(), 0, length);
+        }
+
+        return flattened.constData();
+    }
+
+    int SCI_METHOD GetLineIndentation(Sci_Position line) override
+    {
+        int indent = 0;
+
+        for (Sci_Position position = LineStart(line); position < Length(); ++position) {
+            const char ch = charAt(position);
+
+            if (ch == ' ')
+                ++indent;
+            else if (ch == '\t')
+                indent = (indent / tabWidth + 1) * tabWidth;
+            else
+                break;
+        }
+
+        return indent;
+    }
+
+    Sci_Position SCI_METHOD LineEnd(Sci_Position line) const override
+    {
+        if (line >= lines() - 1)
+            return LineStart(line + 1);
+
+        const Sci_Position position = LineStart(line + 1);
+        if (position > 1 && charAt(position - 2) == '\r' && charAt(position - 1) == '\n')
+            return position - 2;
+
+        return position - 1;
+    }
+
+    Sci_Position SCI_METHOD GetRelativePosition(Sci_Position positionStart, Sci_Position characterOffset) const override
+    {
+        Sci_Position position = positionStart;
+
+        if (codePage != SC_CP_UTF8) {
+            position += characterOffset;
+            return (position < 0 || position > Length()) ? INVALID_POSITION : position;
+        }
+
+        while (characterOffset > 0) {
+            if (position >= Length())
+                return INVALID_POSITION;
+
+            Sci_Position width = 1;
+            GetCharacterAndWidth(position, &width);
+            position += width;
+            --characterOffset;
+        }
+
+        while (characterOffset < 0) {
+            if (position <= 0)
+                return INVALID_POSITION;
+
+            // Step back over continuation bytes to the start of the character
+            Sci_Position previous = position - 1;
+            while (previous > 0 && position - previous < 4 && (static_cast<unsigned char>(charAt(previous)) & 0xC0) == 0x80)
+                --previous;
+
+            Sci_Position width = 1;
+            GetCharacterAndWidth(previous, &width);
+            position = (previous + width == position) ? previous : position - 1;
+            ++characterOffset;
+        }
+
+        return position;
+    }
+
+    int SCI_METHOD GetCharacterAndWidth(Sci_Position position, Sci_Position *pWidth) const override
+    {
+        if (position < 0 || position >= Length()) {
+            if (pWidth)
+                *pWidth = 1;
+            return 0;
+        }
+
+        const unsigned char lead = static_cast<unsigned char>(charAt(position));
+        int character = lead;
+        Sci_Position width = 1;
+
+        if (codePage == SC_CP_UTF8 && lead >= 0x80) {
+            const int bytes = (lead >= 0xF5) ? 0 : (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC2) ? 2 : 0;
+            bool valid = bytes > 0 && position + bytes <= Length();
+
+            if (valid) {
+                character = lead & (0xFF >> (bytes + 1));
+
+                for (int i = 1; i < bytes && valid; ++i) {
+                    const unsigned char trail = static_cast<unsigned char>(charAt(position + i));
+                    valid = (trail & 0xC0) == 0x80;
+                    character = (character << 6) | (trail & 0x3F);
+                }
+            }
+
+            if (valid) {
+                width = bytes;
+            }
+            else {
+                // Same as the editor, invalid bytes are reported as lone surrogates
+                character = 0xDC80 + lead;
+            }
+        }
+
+        if (pWidth)
+            *pWidth = width;
+
+        return character;
+    }
+
+private:
+    int blockIndex(Sci_Position position) const
+    {
+        auto it = std::upper_bound(blockStarts.cbegin(), blockStarts.cend(), position);
+        return static_cast<int>(std::distance(blockStarts.cbegin(), it)) - 1;
+    }
+
+    char charAt(Sci_Position position) const
+    {
+        const int index = blockIndex(position);
+        return blocks[index].at(static_cast<int>(position - blockStarts[index]));
+    }
+
+    QVector<QByteArray> blocks;
+    Sci_Position length = 0;
+    int codePage;
+    int tabWidth;
+    QByteArray flattened;
+
+    std::vector<Sci_Position> blockStarts;
+    std::vector<Sci_Position> lineStarts;
+    std::vector<char> styles;
+    std::vector<int> levels;
+    std::vector<int> lineStates;
+    Sci_Position endStyled = 0;
+};
+
+}
+
+
+BackgroundLexer::BackgroundLexer(ScintillaNext *editor) :
+    EditorDecorator(editor),
+    generation(0)
+{
+    setObjectName("BackgroundLexer");
+
+    delay.setSingleShot(true);
+    delay.setInterval(StartDelay);
+    connect(&delay, &QTimer::timeout, this, &BackgroundLexer::start);
+
+    // Edits are not seen while disabled so the copy can not be kept up to date
+    connect(this, &EditorDecorator::stateChanged, this, [=](bool on) {
+        if (!on) {
+            dropSnapshot();
+        }
+    });
+}
+
+BackgroundLexer::~BackgroundLexer()
+{
+    cancel();
+    worker.waitForFinished();
+}
+
+void BackgroundLexer::setLanguage(const LanguageProfile &profile)
+{
+    language = profile;
+
+    cancel();
+    delay.start();
+}
+
+void BackgroundLexer::notify(const NotificationData *pscn)
+{
+    if (pscn->nmhdr.code == Notification::Modified &&
+            FlagSet(pscn->modificationType, ModificationFlags::InsertText | ModificationFlags::DeleteText)) {
+        if (!snapshot.isEmpty()) {
+            if (FlagSet(pscn->modificationType, ModificationFlags::DeleteText)) {
+                deleteFromSnapshot(pscn->position, pscn->length);
+            }
+            else if (pscn->text) {
+                insertIntoSnapshot(pscn->position, pscn->text, pscn->length);
+            }
+            else {
+                dropSnapshot();
+            }
+
+            // Only the edits seen here are counted so a missed one still shows up as a mismatch
+            if (!snapshot.isEmpty()) {
+                ++snapshotModification;
+            }
+        }
+
+        cancel();
+        delay.start();
+    }
+}
+
+void BackgroundLexer::start()
+{
+    // Double byte code pages would need their lead bytes from the editor
+    const int codePage = editor->codePage();
+
+    if (!enabled || language.lexer.isEmpty() || editor->length() < MinimumLength ||
+            (codePage != 0 && codePage != SC_CP_UTF8)) {
+        dropSnapshot();
+        return;
+    }
+
+    // A cancelled run is still winding down, try again once it has
+    if (worker.isRunning()) {
+        delay.start();
+        return;
+    }
+
+    // Lex a little here first since the lexer often gets back to the state it was in before the
+    // text changed within a few lines, and then the editor keeps the styles it already had
+    const Sci_Position lineStyled = editor->lineFromPosition(editor->endStyled());
+    editor->colourise(editor->endStyled(), editor->positionFromLine(lineStyled + ConvergenceLines));
+
+    const Sci_Position length = editor->length();
+    const Sci_Position startLine = editor->lineFromPosition(editor->endStyled());
+    const Sci_Position start = editor->positionFromLine(startLine);
+
+    if (start >= length)
+        return;
+
+    ILexer5 *lexer = language.createLexer();
+    if (!lexer)
+        return;
+
+    // The editor's lexer may have had properties changed since the language was set
+    for (const QByteArray &name : editor->propertyNames().split('\n')) {
+        if (!name.isEmpty()) {
+            lexer->PropertySet(name.constData(), editor->property(name.constData()).constData());
+        }
+    }
+
+    Seed seed;
+    seed.stylesStart = std::max<Sci_Position>(start - StyleLookBehind, 0);
+    for (Sci_Position position = seed.stylesStart; position < start; ++position) {
+        seed.styles.append(static_cast<char>(editor->styleAt(position)));
+    }
+    seed.firstLine = std::max<Sci_Position>(startLine - LineLookBehind, 0);
+    for (Sci_Position line = seed.firstLine; line < startLine; ++line) {
+        seed.levels.append(editor->foldLevel(line));
+        seed.lineStates.append(editor->lineState(line));
+    }
+
+    // Only the first run copies the whole text, after that the copy has been kept up to date. Edits
+    // made while modification notifications were turned off leave it behind the editor.
+    if (snapshot.isEmpty() || snapshotLength != length || snapshotModification != editor->modificationCount()) {
+        buildSnapshot();
+    }
+
+    const QVector<QByteArray> text = snapshot;
+    const int tabWidth = editor->tabWidth();
+    const int runGeneration = generation;
+
+    worker = QtConcurrent::run([this, lexer, text, codePage, tabWidth, seed, start, runGeneration]() {
+        SnapshotDocument document(text, codePage, tabWidth, seed);
+        ILexerCheckpoint *checkpointer = static_cast<ILexerCheckpoint *>(lexer->PrivateCall(lpcCheckpoint, nullptr));
+        const Sci_Position length = document.Length();
+        Sci_Position position = start;
+
+        // Where the lexer can not take a checkpoint pieces grow just as they do in the editor
+        Sci_Position linesPiece = LinesPerCheckpoint;
+
+        while (position < length && generation == runGeneration) {
+            Batch batch;
+            batch.generation = runGeneration;
+            batch.start = position;
+            batch.firstLine = document.LineFromPosition(position);
+
+            const Sci_Position batchEnd = std::min(position + BatchSize, length);
+
+            TRACE_SCOPE("lexing", "BackgroundLexer lex batch");
+            while (position < batchEnd) {
+                const Sci_Position line = document.LineFromPosition(position);
+                const Sci_Position lineCheckpoint = checkpointer ? line + linesPiece - 1 : document.LineFromPosition(batchEnd);
+                const Sci_Position end = document.LineStart(lineCheckpoint + 1);
+                const int initStyle = (position > 0) ? static_cast<unsigned char>(document.StyleAt(position - 1)) : 0;
+
+                lexer->Lex(position, end - position, initStyle, &document);
+                lexer->Fold(position, end - position, initStyle, &document);
+                position = end;
+
+                if (!checkpointer || end >= length)
+                    continue;
+
+                // The editor clears its own checkpoints in the lines before each one it is given, so
+                // a grown piece also hands over empty ones to clear those it passed over
+                for (Sci_Position passed = line + LinesPerCheckpoint - 1; passed < lineCheckpoint; passed += LinesPerCheckpoint) {
+                    batch.checkpoints.append({passed, false, QByteArray()});
+                }
+
+                Sci_Position lengthState = 0;
+                const char *state = checkpointer->CheckpointState(lineCheckpoint, &lengthState, &document);
+                linesPiece = state ? LinesPerCheckpoint : linesPiece * 2;
+                batch.checkpoints.append({lineCheckpoint, state != nullptr, state ? QByteArray(state, static_cast<int>(lengthState)) : QByteArray()});
+            }
+
+            // Folding may set the level of the line following the batch, so include it
+            batch.styles = QByteArray(document.stylesAt(batch.start), position - batch.start);
+            for (Sci_Position line = batch.firstLine; line <= document.LineFromPosition(position); ++line) {
+                batch.levels.append(document.GetLevel(line));
+                batch.lineStates.append(document.GetLineState(line));
+            }
+
+            QMetaObject::invokeMethod(this, [this, batch]() { commit(batch); }, Qt::QueuedConnection);
+        }
+
+        lexer->Release();
+    });
+}
+
+void BackgroundLexer::cancel()
+{
+    ++generation;
+}
+
+void BackgroundLexer::commit(const Batch &batch)
+{
+    TRACE_SCOPE("lexing", "BackgroundLexer::commit");
+
+    if (batch.generation != generation)
+        return;
+
+    const Sci_Position batchEnd = batch.start + batch.styles.size();
+    const Sci_Position endStyled = editor->endStyled();
+
+    // Styling was thrown away without the text changing, e.g. a lexer property was set
+    if (endStyled < batch.start) {
+        cancel();
+        delay.start();
+        return;
+    }
+
+    // The editor has already lexed this far itself
+    if (endStyled >= batchEnd)
+        return;
+
+    // Each checkpoint is recorded once the lines up to it have been styled
+    Sci_Position position = endStyled;
+    for (const Batch::Checkpoint &checkpoint : batch.checkpoints) {
+        const Sci_Position lineEnd = editor->positionFromLine(checkpoint.line + 1);
+
+        if (lineEnd <= position)
+            continue;
+
+        commitRange(batch, position, lineEnd);
+        position = lineEnd;
+
+        // Lexing is back in the state it was in before the text changed and the editor has kept
+        // the styles that follow, so the rest of the work is not needed
+        if (editor->setStylingCheckpoint(checkpoint.state.size(), checkpoint.restartable ? checkpoint.state.constData() : Q_NULLPTR)) {
+            cancel();
+            return;
+        }
+    }
+
+    commitRange(batch, position, batchEnd);
+}
+
+void BackgroundLexer::commitRange(const Batch &batch, Sci_Position start, Sci_Position end)
+{
+    editor->startStyling(start, 0);
+    editor->setStylingEx(end - start, batch.styles.constData() + (start - batch.start));
+
+    const Sci_Position fromLine = editor->lineFromPosition(start);
+    const Sci_Position toLine = editor->lineFromPosition(end);
+    for (int i = 0; i < batch.levels.size(); ++i) {
+        const Sci_Position line = batch.firstLine + i;
+
+        if (line >= fromLine && line <= toLine) {
+            editor->setLineState(line, batch.lineStates[i]);
+            editor->setFoldLevel(line, batch.levels[i]);
+        }
+    }
+}
+
+void BackgroundLexer::buildSnapshot()
+{
+    TRACE_SCOPE("lexing", "BackgroundLexer::buildSnapshot");
+
+    dropSnapshot();
+
+    // Read the text where it is stored rather than asking for a pointer, which would move it all
+    // together in the editor as well
+    QByteArray block;
+    editor->forEachTextSegment(0, editor->length(), [&](const char *text, Sci_Position length) {
+        while (length > 0) {
+            if (block.isEmpty()) {
+                block.reserve(SnapshotBlockSize);
+            }
+
+            const int count = static_cast<int>(std::min<Sci_Position>(length, SnapshotBlockSize - block.size()));
+            block.append(text, count);
+            text += count;
+            length -= count;
+            snapshotLength += count;
+
+            if (block.size() == SnapshotBlockSize) {
+                snapshot.append(block);
+                block.clear();
+            }
+        }
+    });
+
+    if (!block.isEmpty()) {
+        snapshot.append(block);
+    }
+
+    snapshotModification = editor->modificationCount();
+}
+
+void BackgroundLexer::dropSnapshot()
+{
+    snapshot.clear();
+    snapshotLength = 0;
+    snapshotModification = -1;
+}
+
+void BackgroundLexer::insertIntoSnapshot(Sci_Position position, const char *text, Sci_Position length)
+{
+    // Text inserted where two blocks meet goes on the end of the first one
+    int index = 0;
+    Sci_Position blockStart = 0;
+    while (index < snapshot.size() - 1 && blockStart + snapshot.at(index).size() < position) {
+        blockStart += snapshot.at(index).size();
+        ++index;
+    }
+
+    if (position < blockStart || position > blockStart + snapshot.at(index).size()) {
+        dropSnapshot();
+        return;
+    }
+
+    snapshot[index].insert(static_cast<int>(position - blockStart), text, static_cast<int>(length));
+    snapshotLength += length;
+
+    if (snapshot.at(index).size() >= 2 * SnapshotBlockSize) {
+        const QByteArray grown = snapshot.takeAt(index);
+
+        for (int offset = 0; offset < grown.size(); offset += SnapshotBlockSize) {
+            snapshot.insert(index++, grown.mid(offset, SnapshotBlockSize));
+        }
+    }
+}
+
+void BackgroundLexer::deleteFromSnapshot(Sci_Position position, Sci_Position length)
+{
+    int index = 0;
+    Sci_Position blockStart = 0;
+
+    while (length > 0 && index < snapshot.size()) {
+        const int size = snapshot.at(index).size();
+
+        if (position >= blockStart + size) {
+            blockStart += size;
+            ++index;
+            continue;
+        }
+
+        const int offset = static_cast<int>(position - blockStart);
+        const int count = static_cast<int>(std::min<Sci_Position>(length, size - offset));
+        snapshot[index].remove(offset, count);
+        length -= count;
+        snapshotLength -= count;
+
+        // The rest of the deletion starts at the beginning of the next block
+        if (snapshot.at(index).isEmpty()) {
+            snapshot.remove(index);
+        }
+        else {
+            blockStart += snapshot.at(index).size();
+            ++index;
+        }
+    }
+
+    if (length > 0) {
+        dropSnapshot();
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BACKGROUNDLEXER_H
+#define BACKGROUNDLEXER_H
+
+#include "EditorDecorator.h"
+#include "LanguageProfile.h"
+
+#include <QFuture>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+
+
+// Styles and folds large documents on a worker thread so that jumping to the end or folding
+// everything does not have to lex the whole document on the GUI thread first.
+//
+// The worker lexes a copy of the text with its own lexer instance and hands back batches of
+// styles, line states and fold levels which are committed in order, just as if Scintilla had
+// lexed that far itself. Any change to the text makes the work out of date so the generation
+// is bumped, which drops anything still queued, and lexing starts again a little later from
+// wherever the editor's own styling has got to. The checkpoints of lexers that take them are
+// handed back with each batch too so that the editor can stop restyling after a later edit.
+//
+// The copy is kept between runs in blocks that are shared with the worker. Edits are applied
+// to it as they are made, so a block is only copied again when an edit lands in it. The copy
+// records the editor's modification count it matches so that edits it did not see, such as
+// those made while modification events were masked, cause it to be copied again.
+class BackgroundLexer : public EditorDecorator
+{
+    Q_OBJECT
+
+public:
+    // Smaller documents are quick enough to lex when they are shown
+    static const int MinimumLength = 4 * 1024 * 1024;
+
+    explicit BackgroundLexer(ScintillaNext *editor);
+    ~BackgroundLexer() override;
+
+    void setLanguage(const LanguageProfile &profile);
+
+public slots:
+    void notify(const Scintilla::NotificationData *pscn) override;
+
+private slots:
+    void start();
+
+private:
+    struct Batch {
+        // The lexer's state at the end of a line, as described by ILexerCheckpoint
+        struct Checkpoint {
+            Sci_Position line;
+            bool restartable;
+            QByteArray state;
+        };
+
+        int generation;
+        Sci_Position start;
+        QByteArray styles;
+        Sci_Position firstLine;
+        QVector<int> levels;
+        QVector<int> lineStates;
+        QVector<Checkpoint> checkpoints;
+    };
+
+    void cancel();
+    void commit(const Batch &batch);
+    void commitRange(const Batch &batch, Sci_Position start, Sci_Position end);
+
+    void buildSnapshot();
+    void dropSnapshot();
+    void insertIntoSnapshot(Sci_Position position, const char *text, Sci_Position length);
+    void deleteFromSnapshot(Sci_Position position, Sci_Position length);
+
+    LanguageProfile language;
+    QVector<QByteArray> snapshot;
+    Sci_Position snapshotLength = 0;
+    Sci_Position snapshotModification = -1;
+    QTimer delay;
+    std::atomic<int> generation;
+    QFuture<void> worker;
+};
+
+#endif // BACKGROUNDLEXER_H
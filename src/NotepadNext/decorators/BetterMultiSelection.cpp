@@ -33,10 +33,19 @@ struct Selection {
     int start() const { return qMin(caret, anchor); }
     int end() const { return qMax(caret, anchor); }
     int length() const { return end() - start(); }
+    bool empty() const { return caret == anchor; }
     void set(int pos) { anchor = caret = pos; }
     void offset(int offset) { anchor += offset; caret += offset; }
 };
 
+// Replaces the range [start, end) with text. Positions are always relative to the document
+// before any of the edits in the batch have been applied.
+struct SelectionEdit {
+    int start;
+    int end;
+    QByteArray text;
+};
+
 template<typename It>
 It uniquify(It begin, It const end)
 {
@@ -166,6 +175,27 @@ bool BetterMultiSelection::eventFilter(QObject *obj, QEvent *event)
                     }
                     // else just let Scintilla handle the navigation of autocompletion
                 }
+                else if (keyEvent->key() == Qt::Key_Backspace) {
+                    if (!editor->autoCActive() && BatchEdit(DeleteBackEdit())) {
+                        return true;
+                    }
+                    // else just let Scintilla handle the deletion so autocompletion follows it
+                }
+                else if (keyEvent->key() == Qt::Key_Delete) {
+                    if (!editor->autoCActive() && BatchEdit(DeleteForwardEdit())) {
+                        return true;
+                    }
+                    // else just let Scintilla handle the deletion so autocompletion follows it
+                }
+                else if (!keyEvent->text().isEmpty() && keyEvent->text().at(0).isPrint()) {
+                    const QByteArray text = keyEvent->text().toUtf8();
+
+                    if (!editor->autoCActive() && !editor->overtype() && BatchEdit(InsertEdit(text))) {
+                        NotifyTyped(text);
+                        return true;
+                    }
+                    // else just let Scintilla handle the typing
+                }
             }
         }
     }
@@ -237,3 +267,126 @@ std::function<void(Selection &selection)> BetterMultiSelection::SimpleEdit(int m
         selection.anchor = editor->selectionNAnchor(0);
     };
 }
+
+bool BetterMultiSelection::BatchEdit(std::function<bool(const Selection &selection, SelectionEdit &edit)> calculate) {
+    const int num = editor->selections();
+
+    // Virtual space needs padding inserted which Scintilla already knows how to do
+    for (int i = 0; i < num; ++i) {
+        if (editor->selectionNCaretVirtualSpace(i) > 0 || editor->selectionNAnchorVirtualSpace(i) > 0)
+            return false;
+    }
+
+    auto selections = GetSelections();
+
+    std::sort(selections.begin(), selections.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.start() < rhs.start() || (!(rhs.start() < lhs.start()) && lhs.end() < rhs.end());
+    });
+
+    // Work out every edit up front against the unmodified document. If any of them can't be
+    // expressed as a simple replacement the whole thing is handed back to Scintilla.
+    QVector<SelectionEdit> edits;
+    edits.reserve(selections.size());
+
+    for (const Selection &selection : qAsConst(selections)) {
+        SelectionEdit edit{selection.start(), selection.end(), QByteArray()};
+
+        if (!calculate(selection, edit))
+            return false;
+
+        // Sorted selections can still produce touching ranges, make sure they never overlap
+        if (!edits.isEmpty() && edit.start < edits.last().end) {
+            edit.start = edits.last().end;
+            edit.end = qMax(edit.start, edit.end);
+        }
+
+        edits.append(edit);
+    }
+
+    // Apply them from the end of the document to the start so no position needs adjusting
+    editor->beginUndoAction();
+
+    for (auto it = edits.crbegin(); it != edits.crend(); ++it) {
+        editor->setTargetRange(it->start, it->end);
+        editor->replaceTarget(it->text.size(), it->text.constData());
+    }
+
+    editor->endUndoAction();
+
+    // Single pass over the edits to find where each caret ended up
+    QVector<Selection> newSelections;
+    newSelections.reserve(edits.size());
+
+    int totalOffset = 0;
+    for (const SelectionEdit &edit : qAsConst(edits)) {
+        const int caret = edit.start + totalOffset + edit.text.size();
+
+        if (newSelections.isEmpty() || newSelections.last().caret != caret)
+            newSelections.append(Selection{ caret, caret });
+
+        totalOffset += edit.text.size() - (edit.end - edit.start);
+    }
+
+    editor->clearSelections();
+    SetSelections(newSelections);
+
+    return true;
+}
+
+std::function<bool(const Selection &selection, SelectionEdit &edit)> BetterMultiSelection::InsertEdit(const QByteArray &text) {
+    return [=](const Selection &selection, SelectionEdit &edit) {
+        // Typing over selections might be handled by other decorators (e.g. SurroundSelection)
+        if (!selection.empty())
+            return false;
+
+        edit.text = text;
+        return true;
+    };
+}
+
+std::function<bool(const Selection &selection, SelectionEdit &edit)> BetterMultiSelection::DeleteBackEdit() {
+    return [=](const Selection &selection, SelectionEdit &edit) {
+        if (!selection.empty())
+            return true;
+
+        const int line = editor->lineFromPosition(selection.caret);
+        const int lineStart = editor->positionFromLine(line);
+
+        // Let Scintilla take care of unindenting
+        if (editor->backSpaceUnIndents() && selection.caret > lineStart && selection.caret <= editor->lineIndentPosition(line))
+            return false;
+
+        edit.start = editor->positionBefore(selection.caret);
+        return true;
+    };
+}
+
+std::function<bool(const Selection &selection, SelectionEdit &edit)> BetterMultiSelection::DeleteForwardEdit() {
+    return [=](const Selection &selection, SelectionEdit &edit) {
+        if (selection.empty())
+            edit.end = editor->positionAfter(selection.caret);
+
+        return true;
+    };
+}
+
+// Typing through the target bypasses Scintilla's own handling of typed characters, so send the
+// notifications it would have sent once the text was inserted at every caret
+void BetterMultiSelection::NotifyTyped(const QByteArray &text)
+{
+    const QVector<uint> characters = QString::fromUtf8(text).toUcs4();
+
+    Scintilla::NotificationData scn = {};
+    scn.nmhdr.code = Scintilla::Notification::CharAdded;
+    scn.ch = characters.isEmpty() ? 0 : static_cast<int>(characters.first());
+    scn.characterSource = Scintilla::CharacterSource::DirectInput;
+    editor->notifyParent(scn);
+
+    if (editor->isRecordingMacro()) {
+        scn = {};
+        scn.nmhdr.code = Scintilla::Notification::MacroRecord;
+        scn.message = Scintilla::Message::ReplaceSel;
+        scn.lParam = reinterpret_cast<Scintilla::sptr_t>(text.constData());
+        editor->notifyParent(scn);
+    }
+}
@@ -28,6 +28,7 @@
 
 
 struct Selection;
+struct SelectionEdit;
 
 class BetterMultiSelection : public EditorDecorator
 {
@@ -47,6 +48,12 @@ private:
     void SetSelections(const QVector<Selection> &selections);
     void EditSelections(std::function<void(Selection &selection)> edit);
     std::function<void(Selection &selection)> SimpleEdit(int message);
+
+    bool BatchEdit(std::function<bool(const Selection &selection, SelectionEdit &edit)> calculate);
+    std::function<bool(const Selection &selection, SelectionEdit &edit)> InsertEdit(const QByteArray &text);
+    std::function<bool(const Selection &selection, SelectionEdit &edit)> DeleteBackEdit();
+    std::function<bool(const Selection &selection, SelectionEdit &edit)> DeleteForwardEdit();
+    void NotifyTyped(const QByteArray &text);
 };
 
 #endif // BETTERMULTISELECTION_H
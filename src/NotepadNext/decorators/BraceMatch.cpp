@@ -48,9 +48,11 @@ BraceMatch::BraceMatch(ScintillaNext *editor) :
 
     editor->setIndentationGuides(SC_IV_LOOKBOTH);
 
+    setInterests(EditorNotificationHub::ContentChanged | EditorNotificationHub::SelectionChanged);
+
     connect(this, &EditorDecorator::stateChanged, [=](bool b) {
         if (b) {
-            doHighlighting();
+            doHighlighting(editor->currentPos());
         }
         else {
             clearHighlighting();
@@ -58,14 +60,12 @@ BraceMatch::BraceMatch(ScintillaNext *editor) :
     });
 }
 
-void BraceMatch::doHighlighting()
+void BraceMatch::doHighlighting(Sci_Position pos)
 {
     static const QList<char> braces = {'[', ']', '(', ')', '{', '}'};
 
-    const Sci_Position pos = static_cast<Sci_Position>(editor->currentPos());
-
     // Check the character before the caret first
-    int match = editor->braceMatch(pos - 1, 0);
+    Sci_Position match = editor->braceMatch(pos - 1, 0);
 
     if (match != INVALID_POSITION) {
          editor->braceHighlight(pos - 1, match);
@@ -104,11 +104,9 @@ void BraceMatch::clearHighlighting()
     editor->setHighlightGuide(0);
 }
 
-void BraceMatch::notify(const NotificationData *pscn)
+void BraceMatch::editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state)
 {
-    if (pscn->nmhdr.code == Notification::UpdateUI) {
-        if (FlagSet(pscn->updated, Update::Content) || FlagSet(pscn->updated, Update::Selection)) {
-            doHighlighting();
-        }
-    }
+    Q_UNUSED(events);
+
+    doHighlighting(state.currentPos);
 }
@@ -30,12 +30,12 @@ class BraceMatch : public EditorDecorator
 public:
     BraceMatch(ScintillaNext *editor);
 
+protected:
+    void editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state) override;
+
 private:
-    void doHighlighting();
+    void doHighlighting(Sci_Position pos);
     void clearHighlighting();
-
-public slots:
-    void notify(const Scintilla::NotificationData *pscn) override;
 };
 
 #endif // BRACEMATCH_H
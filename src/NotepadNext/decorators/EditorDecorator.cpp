@@ -24,11 +24,54 @@ void EditorDecorator::setEnabled(bool b)
     enabled = b;
 
     if (enabled) {
-        connect(editor, &ScintillaEdit::notify, this, &EditorDecorator::notify);
+        connectToEditor();
     }
     else {
-        disconnect(editor, nullptr, this, nullptr);
+        disconnectFromEditor();
     }
 
     emit stateChanged(enabled);
 }
+
+void EditorDecorator::setInterests(EditorNotificationHub::Events events)
+{
+    // Refresh the subscription if the decorator is already running
+    if (enabled) {
+        disconnectFromEditor();
+    }
+
+    interests = events;
+
+    if (enabled) {
+        connectToEditor();
+    }
+}
+
+void EditorDecorator::notify(const Scintilla::NotificationData *pscn)
+{
+    Q_UNUSED(pscn);
+}
+
+void EditorDecorator::editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state)
+{
+    Q_UNUSED(events);
+    Q_UNUSED(state);
+}
+
+void EditorDecorator::connectToEditor()
+{
+    if (interests == EditorNotificationHub::NoEvent) {
+        connect(editor, &ScintillaEdit::notify, this, &EditorDecorator::notify);
+    }
+    else {
+        editor->notificationHub()->subscribe(this, interests, [=](EditorNotificationHub::Events events, const EditorNotificationHub::State &state) {
+            editorUpdated(events, state);
+        });
+    }
+}
+
+void EditorDecorator::disconnectFromEditor()
+{
+    disconnect(editor, nullptr, this, nullptr);
+    editor->notificationHub()->unsubscribe(this);
+}
@@ -23,6 +23,7 @@
 #include <QObject>
 
 #include "ScintillaNext.h"
+#include "EditorNotificationHub.h"
 
 class EditorDecorator : public QObject
 {
@@ -38,14 +39,24 @@ public:
 
 public slots:
     void setEnabled(bool b);
-    virtual void notify(const Scintilla::NotificationData *pscn) = 0;
+    virtual void notify(const Scintilla::NotificationData *pscn);
 
 signals:
     void stateChanged(bool b);
 
 protected:
+    // Decorators that only need the coalesced editor state declare their interests here and
+    // override editorUpdated() instead of receiving every raw notification through notify()
+    void setInterests(EditorNotificationHub::Events events);
+    virtual void editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state);
+
     ScintillaNext *editor;
     bool enabled = false;
+    EditorNotificationHub::Events interests = EditorNotificationHub::NoEvent;
+
+private:
+    void connectToEditor();
+    void disconnectFromEditor();
 };
 
 #endif // EDITORDECORATOR_H
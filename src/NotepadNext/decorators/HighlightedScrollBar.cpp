@@ -35,20 +35,20 @@ HighlightedScrollBarDecorator::HighlightedScrollBarDecorator(ScintillaNext *edit
     connect(scrollBar, &QScrollBar::valueChanged, editor, &ScintillaEdit::scrollVertical);
 
     editor->setVerticalScrollBar(scrollBar);
+
+    setInterests(EditorNotificationHub::ContentChanged | EditorNotificationHub::SelectionChanged | EditorNotificationHub::MarkersChanged);
 }
 
 HighlightedScrollBarDecorator::~HighlightedScrollBarDecorator()
 {
 }
 
-void HighlightedScrollBarDecorator::notify(const NotificationData *pscn)
+void HighlightedScrollBarDecorator::editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state)
 {
-    if (pscn->nmhdr.code == Notification::UpdateUI && (FlagSet(pscn->updated, Update::Content) || FlagSet(pscn->updated, Update::Selection))) {
-        scrollBar->update();
-    }
-    else if (pscn->nmhdr.code == Notification::Modified && FlagSet(pscn->modificationType, ModificationFlags::ChangeMarker)) {
-        scrollBar->update();
-    }
+    Q_UNUSED(events);
+    Q_UNUSED(state);
+
+    scrollBar->update();
 }
 
 
@@ -36,8 +36,8 @@ public:
     HighlightedScrollBarDecorator(ScintillaNext *editor);
     ~HighlightedScrollBarDecorator() override;
 
-public slots:
-    void notify(const Scintilla::NotificationData *pscn) override;
+protected:
+    void editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state) override;
 
 private:
     HighlightedScrollBar *scrollBar;
@@ -39,11 +39,19 @@ static inline int countDigits(quint32 x)
 LineNumbers::LineNumbers(ScintillaNext *editor) :
     EditorDecorator(editor)
 {
+    setObjectName("LineNumbers");
+
     editor->setMarginWidthN(0, 0);
 
+    setInterests(neededEvents());
+
     connect(this, &EditorDecorator::stateChanged, editor, [=](bool b) {
         if (b) {
-            adjustMarginWidth();
+            adjustMarginWidth(editor->lineCount(), true);
+
+            if (relative) {
+                updateRelativeNumbers(editor->notificationHub()->state(), true);
+            }
         }
         else {
             editor->setMarginWidthN(0, 0);
@@ -51,16 +59,100 @@ LineNumbers::LineNumbers(ScintillaNext *editor) :
     });
 }
 
-void LineNumbers::adjustMarginWidth()
+void LineNumbers::setRelativeLineNumbers(bool b)
+{
+    if (relative == b) {
+        return;
+    }
+
+    relative = b;
+
+    if (relative) {
+        editor->setMarginTypeN(0, SC_MARGIN_RTEXT);
+        updateRelativeNumbers(editor->notificationHub()->state(), true);
+    }
+    else {
+        editor->marginTextClearAll();
+        editor->setMarginTypeN(0, SC_MARGIN_NUMBER);
+    }
+
+    setInterests(neededEvents());
+}
+
+void LineNumbers::adjustMarginWidth(int lineCount, bool force)
 {
-    int lineCount = editor->lineCount();
-    int pixelWidth = 8 + (qMax(countDigits(lineCount), 3)) * editor->textWidth(STYLE_LINENUMBER, "8");
-    editor->setMarginWidthN(0, pixelWidth);
+    const int newDigits = qMax(countDigits(lineCount), 3);
+
+    // Most edits never change the number of digits so don't bother touching the margin
+    if (newDigits == digits && !force) {
+        return;
+    }
+
+    digits = newDigits;
+    editor->setMarginWidthN(0, 8 + digits * glyphWidth());
 }
 
-void LineNumbers::notify(const NotificationData *pscn)
+int LineNumbers::glyphWidth()
 {
-    if ((pscn->nmhdr.code == Notification::UpdateUI && FlagSet(pscn->updated, Update::VScroll)) || (pscn->nmhdr.code == Notification::Zoom)) {
-        adjustMarginWidth();
+    // Measuring text goes through the platform layer, so only do it once per zoom level and font
+    const QByteArray key = editor->styleFont(STYLE_LINENUMBER)
+            + '/' + QByteArray::number(editor->styleSizeFractional(STYLE_LINENUMBER))
+            + '/' + QByteArray::number(editor->styleWeight(STYLE_LINENUMBER))
+            + '/' + QByteArray::number(editor->zoom());
+
+    auto it = glyphWidths.constFind(key);
+    if (it != glyphWidths.constEnd()) {
+        return it.value();
+    }
+
+    const int width = editor->textWidth(STYLE_LINENUMBER, "8");
+    glyphWidths.insert(key, width);
+
+    return width;
+}
+
+void LineNumbers::updateRelativeNumbers(const EditorNotificationHub::State &state, bool force)
+{
+    if (!force && state.caretLine == numberedCaretLine && state.lineCount == numberedLineCount
+            && state.firstVisibleDocLine == numberedFirstLine && state.lastVisibleDocLine == numberedLastLine) {
+        return;
+    }
+
+    numberedCaretLine = state.caretLine;
+    numberedLineCount = state.lineCount;
+    numberedFirstLine = state.firstVisibleDocLine;
+    numberedLastLine = state.lastVisibleDocLine;
+
+    // Only the lines on screen are numbered, anything else gets updated once it is scrolled into view
+    for (Scintilla::Line line = state.firstVisibleDocLine; line <= state.lastVisibleDocLine; ++line) {
+        const Scintilla::Line number = (line == state.caretLine) ? line + 1 : qAbs(line - state.caretLine);
+
+        editor->marginSetText(line, QByteArray::number(number).constData());
+        editor->marginSetStyle(line, STYLE_LINENUMBER);
+    }
+}
+
+EditorNotificationHub::Events LineNumbers::neededEvents() const
+{
+    EditorNotificationHub::Events events = EditorNotificationHub::ContentChanged | EditorNotificationHub::LineCountChanged | EditorNotificationHub::ZoomChanged;
+
+    if (relative) {
+        events |= EditorNotificationHub::SelectionChanged | EditorNotificationHub::VerticalScroll;
+    }
+
+    return events;
+}
+
+void LineNumbers::editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state)
+{
+    if (events.testFlag(EditorNotificationHub::ZoomChanged)) {
+        adjustMarginWidth(state.lineCount, true);
+    }
+    else if (events & (EditorNotificationHub::ContentChanged | EditorNotificationHub::LineCountChanged)) {
+        adjustMarginWidth(state.lineCount, false);
+    }
+
+    if (relative) {
+        updateRelativeNumbers(state, false);
     }
 }
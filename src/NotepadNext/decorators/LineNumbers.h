@@ -21,6 +21,7 @@
 #define LINENUMBERS_H
 
 #include <QObject>
+#include <QHash>
 
 #include "EditorDecorator.h"
 
@@ -28,14 +29,34 @@ class LineNumbers : public EditorDecorator
 {
     Q_OBJECT
 
+    Q_PROPERTY(bool relativeLineNumbers READ relativeLineNumbers WRITE setRelativeLineNumbers)
+
 public:
     LineNumbers(ScintillaNext *editor);
 
-private:
-    void adjustMarginWidth();
+    bool relativeLineNumbers() const { return relative; }
 
 public slots:
-    void notify(const Scintilla::NotificationData *pscn) override;
+    void setRelativeLineNumbers(bool b);
+
+protected:
+    void editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state) override;
+
+private:
+    void adjustMarginWidth(int lineCount, bool force);
+    int glyphWidth();
+
+    void updateRelativeNumbers(const EditorNotificationHub::State &state, bool force);
+    EditorNotificationHub::Events neededEvents() const;
+
+    QHash<QByteArray, int> glyphWidths;
+    int digits = 0;
+
+    bool relative = false;
+    Scintilla::Line numberedCaretLine = -1;
+    Scintilla::Line numberedLineCount = -1;
+    Scintilla::Line numberedFirstLine = -1;
+    Scintilla::Line numberedLastLine = -1;
 };
 
 #endif // LINENUMBERS_H
@@ -0,0 +1,313 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "PersistentUndoAppDecorator.h"
+#include "EditorManager.h"
+#include "ScintillaNext.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QPointer>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QVector>
+#include <QtConcurrent>
+
+
+// Written at the start of each history file, bump the version if the layout changes
+static const quint32 HISTORY_MAGIC = 0x4E4E5548; // "NNUH"
+static const quint32 HISTORY_VERSION = 2;
+
+// Histories bigger than this are not worth writing out
+static const qint64 HISTORY_MAX_SIZE = Q_INT64_C(1024) * 1024 * 64;
+
+// Once all the histories together are bigger than this the least recently used are removed
+static const qint64 HISTORY_CACHE_SIZE = Q_INT64_C(1024) * 1024 * 256;
+
+
+// Everything needed to write a history out without going back to the editor
+struct PersistentUndoAppDecorator::History {
+    struct Action {
+        quint16 type;
+        qint64 position;
+        QByteArray text;
+    };
+
+    QString path;
+    QString filePath;
+    qint64 length;
+    qint64 modified;
+    qint32 actions;
+    qint32 savePoint;
+    QVector<Action> steps;
+};
+
+
+PersistentUndoAppDecorator::PersistentUndoAppDecorator(NotepadNextApplication *app)
+    : ApplicationDecorator(app)
+{
+    writer.setMaxThreadCount(1);
+
+    EditorManager *manager = app->getEditorManager();
+
+    connect(manager, &EditorManager::editorCreated, this, &PersistentUndoAppDecorator::editorCreated);
+}
+
+PersistentUndoAppDecorator::~PersistentUndoAppDecorator()
+{
+    writer.waitForDone();
+}
+
+void PersistentUndoAppDecorator::editorCreated(ScintillaNext *editor)
+{
+    connect(editor, &ScintillaNext::saved, this, &PersistentUndoAppDecorator::writeHistory);
+    connect(editor, &ScintillaNext::closed, this, &PersistentUndoAppDecorator::writeHistoryIfUnmodified);
+    connect(editor, &ScintillaNext::reloaded, this, &PersistentUndoAppDecorator::discardHistory);
+
+    if (this->isEnabled() && editor->isFile()) {
+        restoreHistory(editor);
+    }
+}
+
+void PersistentUndoAppDecorator::writeHistory()
+{
+    ScintillaNext *editor = qobject_cast<ScintillaNext *>(sender());
+
+    if (this->isEnabled() && editor->isFile()) {
+        writeHistory(editor);
+    }
+}
+
+void PersistentUndoAppDecorator::writeHistoryIfUnmodified()
+{
+    ScintillaNext *editor = qobject_cast<ScintillaNext *>(sender());
+
+    // If there are unsaved changes the text no longer matches the file on disk, so whatever was
+    // written when it was last saved is kept instead
+    if (this->isEnabled() && editor->isFile() && !editor->modify()) {
+        writeHistory(editor);
+    }
+}
+
+void PersistentUndoAppDecorator::discardHistory()
+{
+    ScintillaNext *editor = qobject_cast<ScintillaNext *>(sender());
+
+    // The text now comes from whatever is on disk so the history that led to it is gone
+    if (editor->isFile()) {
+        const QString path = historyPath(editor->getFilePath());
+        QtConcurrent::run(&writer, [path]() { QFile::remove(path); });
+    }
+}
+
+QString PersistentUndoAppDecorator::historyDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/undo");
+}
+
+QString PersistentUndoAppDecorator::historyPath(const QString &filePath)
+{
+    const QByteArray name = QCryptographicHash::hash(filePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    return historyDirectory() + QLatin1Char('/') + QString::fromLatin1(name) + QStringLiteral(".undo");
+}
+
+bool PersistentUndoAppDecorator::writeHistory(ScintillaNext *editor)
+{
+    const QString path = historyPath(editor->getFilePath());
+    const int savePoint = editor->undoSavePoint();
+    const int actions = editor->undoActions();
+
+    // Nothing to keep, or the text on disk can not be reached by undoing so the history is useless
+    if (actions <= 1 || savePoint < 0 || editor->undoMemory() > HISTORY_MAX_SIZE) {
+        QtConcurrent::run(&writer, [path]() { QFile::remove(path); });
+        return false;
+    }
+
+    History history;
+    history.path = path;
+    history.filePath = editor->getFilePath();
+    history.length = editor->textLength();
+    history.modified = editor->getModifiedTime().toMSecsSinceEpoch();
+    history.actions = actions;
+    history.savePoint = savePoint;
+
+    // Action 0 is always a start action so is not written
+    history.steps.reserve(actions - 1);
+    for (int action = 1; action < actions; ++action) {
+        history.steps.append({static_cast<quint16>(editor->undoActionType(action)), static_cast<qint64>(editor->undoActionPosition(action)), editor->undoActionText(action)});
+    }
+
+    QtConcurrent::run(&writer, [history]() {
+        if (saveHistory(history)) {
+            pruneHistories();
+        }
+    });
+
+    return true;
+}
+
+// Runs on the writer thread
+bool PersistentUndoAppDecorator::saveHistory(const History &history)
+{
+    QDir().mkpath(historyDirectory());
+
+    QSaveFile file(history.path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Cannot write undo history \"%s\": %s", qUtf8Printable(history.path), qUtf8Printable(file.errorString()));
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << HISTORY_MAGIC << HISTORY_VERSION;
+    stream << history.filePath;
+    stream << history.length << history.modified;
+    stream << history.actions << history.savePoint;
+
+    for (const History::Action &action : history.steps) {
+        stream << action.type << action.position << action.text;
+    }
+
+    return file.commit();
+}
+
+// Runs on the writer thread
+void PersistentUndoAppDecorator::pruneHistories()
+{
+    // Newest first, restoring a history touches it so this is the order they were last used in
+    const QFileInfoList histories = QDir(historyDirectory()).entryInfoList({QStringLiteral("*.undo")}, QDir::Files, QDir::Time);
+    qint64 total = 0;
+
+    for (const QFileInfo &history : histories) {
+        total += history.size();
+
+        if (total > HISTORY_CACHE_SIZE) {
+            QFile::remove(history.absoluteFilePath());
+        }
+    }
+}
+
+void PersistentUndoAppDecorator::restoreHistory(ScintillaNext *editor)
+{
+    // Only a freshly loaded document can have its history replaced, e.g. not a clone
+    if (editor->undoActions() > 1 || editor->modify()) {
+        return;
+    }
+
+    History history;
+    history.path = historyPath(editor->getFilePath());
+    history.filePath = editor->getFilePath();
+    history.length = editor->textLength();
+    history.modified = editor->getModifiedTime().toMSecsSinceEpoch();
+
+    // Read on the writer thread so that a history still on its way to disk, because the file was
+    // only just closed, is read once it has been written
+    QPointer<ScintillaNext> target(editor);
+    QtConcurrent::run(&writer, [this, target, history]() {
+        History loaded = history;
+
+        if (loadHistory(loaded)) {
+            QMetaObject::invokeMethod(this, [this, target, loaded]() {
+                if (target) {
+                    applyHistory(target, loaded);
+                }
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+// Runs on the writer thread, reads the history if it was written for the file described by history
+bool PersistentUndoAppDecorator::loadHistory(History &history)
+{
+    // Opened for writing as well so that it can be touched
+    QFile file(history.path);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != HISTORY_MAGIC || version != HISTORY_VERSION) {
+        return false;
+    }
+
+    QString filePath;
+    qint64 length = 0;
+    qint64 modified = 0;
+    qint32 actions = 0;
+    qint32 savePoint = 0;
+    stream >> filePath >> length >> modified >> actions >> savePoint;
+
+    if (stream.status() != QDataStream::Ok || filePath != history.filePath || length != history.length || modified != history.modified) {
+        return false;
+    }
+    if (savePoint < 0 || savePoint >= actions) {
+        return false;
+    }
+
+    history.actions = actions;
+    history.savePoint = savePoint;
+    history.steps.reserve(actions - 1);
+    for (int action = 1; action < actions; ++action) {
+        History::Action step;
+        stream >> step.type >> step.position >> step.text;
+
+        if (stream.status() != QDataStream::Ok) {
+            qWarning("Undo history for \"%s\" is damaged", qUtf8Printable(filePath));
+            return false;
+        }
+
+        history.steps.append(step);
+    }
+
+    // Keep it from being pruned for a while
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    return true;
+}
+
+bool PersistentUndoAppDecorator::applyHistory(ScintillaNext *editor, const History &history)
+{
+    // The text may have been changed while the history was being read
+    if (editor->undoActions() > 1 || editor->modify() || !editor->isFile()) {
+        return false;
+    }
+    if (history.filePath != editor->getFilePath() || history.length != editor->textLength()) {
+        return false;
+    }
+
+    for (const History::Action &action : history.steps) {
+        editor->pushUndoActionType(action.type, action.position);
+        if (!action.text.isEmpty()) {
+            editor->changeLastUndoActionText(action.text.size(), action.text.constData());
+        }
+    }
+
+    // The text is what was on disk, which is the save point
+    editor->setUndoCurrent(history.savePoint);
+    editor->setUndoSavePoint(history.savePoint);
+
+    return true;
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PERSISTENTUNDOAPPDECORATOR_H
+#define PERSISTENTUNDOAPPDECORATOR_H
+
+#include "ApplicationDecorator.h"
+
+#include <QThreadPool>
+
+class ScintillaNext;
+
+// Keeps the undo history of files in a cache on disk when they are saved or closed, and gives it
+// back when the same file is opened again. The history is only restored when the file has the
+// same length and modification time as when the history was written.
+//
+// Histories are gathered from the editor on the GUI thread and written out and read back on a
+// thread of their own. The cache is limited in size by removing the histories that were least
+// recently used.
+class PersistentUndoAppDecorator : public ApplicationDecorator
+{
+    Q_OBJECT
+
+public:
+    explicit PersistentUndoAppDecorator(NotepadNextApplication *app);
+    ~PersistentUndoAppDecorator() override;
+
+private slots:
+    void editorCreated(ScintillaNext *editor);
+
+    void writeHistory();
+    void writeHistoryIfUnmodified();
+    void discardHistory();
+
+private:
+    struct History;
+
+    static QString historyDirectory();
+    static QString historyPath(const QString &filePath);
+    static bool saveHistory(const History &history);
+    static bool loadHistory(History &history);
+    static void pruneHistories();
+
+    bool writeHistory(ScintillaNext *editor);
+    void restoreHistory(ScintillaNext *editor);
+    bool applyHistory(ScintillaNext *editor, const History &history);
+
+    // A single thread so that everything done to the same file happens in order
+    QThreadPool writer;
+};
+
+#endif // PERSISTENTUNDOAPPDECORATOR_H
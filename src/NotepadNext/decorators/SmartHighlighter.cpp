@@ -19,9 +19,20 @@
 
 #include "SmartHighlighter.h"
 
+#include "IdleScheduler.h"
+
+#include <QElapsedTimer>
+
 using namespace Scintilla;
 
 
+// Documents up to this size are searched all at once, larger ones in idle time
+static const Sci_Position WholeSearchSize = 1024 * 1024;
+
+// Idle time searches go a small chunk at a time until they have used their share of the slice
+static const Sci_Position SearchChunkSize = 64 * 1024;
+static const qint64 SearchMilliseconds = 2;
+
 SmartHighlighter::SmartHighlighter(ScintillaNext *editor) :
     EditorDecorator(editor)
 {
@@ -32,61 +43,115 @@ SmartHighlighter::SmartHighlighter(ScintillaNext *editor) :
     editor->indicSetOutlineAlpha(29, 150);
     editor->indicSetAlpha(29, 100);
     editor->indicSetUnder(29, true);
+
+    setInterests(EditorNotificationHub::ContentChanged | EditorNotificationHub::SelectionChanged);
+
+    connect(this, &EditorDecorator::stateChanged, this, [=](bool b) {
+        if (!b) {
+            IdleScheduler::instance()->cancel(this);
+        }
+    });
 }
 
-void SmartHighlighter::notify(const NotificationData *pscn)
+void SmartHighlighter::editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state)
 {
-    if (pscn->nmhdr.code == Notification::UpdateUI && (FlagSet(pscn->updated, Update::Content) || FlagSet(pscn->updated, Update::Selection))) {
-        highlightCurrentView();
-    }
+    Q_UNUSED(events);
+
+    highlightCurrentView(state);
 }
 
-void SmartHighlighter::highlightCurrentView()
+void SmartHighlighter::highlightCurrentView(const EditorNotificationHub::State &state)
 {
-    editor->setIndicatorCurrent(29);
-    editor->indicatorClearRange(0, editor->length());
+    IdleScheduler::instance()->cancel(this);
+    matches.clear();
 
-    if (editor->selectionEmpty()) {
+    if (!canHighlight(state)) {
+        // Replacing all of the ranges at once also clears the old highlights when there are none
+        setHighlights(matches);
         return;
     }
 
-    const int mainSelection = editor->mainSelection();
-    const int selectionStart = editor->selectionNStart(mainSelection);
-    const int selectionEnd = editor->selectionNEnd(mainSelection);
+    searchText = editor->notificationHub()->selectionText();
 
-    // Make sure the current selection is valid
-    if (selectionStart == selectionEnd) {
+    if (state.length <= WholeSearchSize) {
+        findMatches(0, state.length, matches);
+        setHighlights(matches);
         return;
     }
 
-    const int curPos = editor->currentPos();
-    const int wordStart = editor->wordStartPosition(curPos, true);
-    const int wordEnd = editor->wordEndPosition(wordStart, true);
+    // Highlight what can be seen straight away then find the rest without holding up the editor.
+    // The highlighted scroll bar shows every match once the whole document has been searched.
+    QVector<Sci_Position> visibleMatches;
+    findMatches(state.visibleStart, state.visibleEnd, visibleMatches);
+    setHighlights(visibleMatches);
 
-    // Make sure the selection is on word boundaries
-    if (wordStart == wordEnd || wordStart != selectionStart || wordEnd != selectionEnd) {
-        return;
+    searchPosition = 0;
+    IdleScheduler::instance()->schedule(this, [=]() { return searchNextChunk(); });
+}
+
+bool SmartHighlighter::canHighlight(const EditorNotificationHub::State &state) const
+{
+    if (state.selectionEmpty) {
+        return false;
     }
 
-    const QByteArray selText = editor->get_text_range(selectionStart, selectionEnd);
+    const Sci_Position selectionStart = state.mainSelectionStart;
+    const Sci_Position selectionEnd = state.mainSelectionEnd;
+
+    // Make sure the current selection is valid
+    if (selectionStart == selectionEnd) {
+        return false;
+    }
 
-    // TODO: Handle large files. By default Notepad++ only monitors the text on screen. However,
-    // that will not work when using a highlighted scroll bar. Testing with small files seems to
-    // have minimal impact. For large files, Qt can have a timer set to 0 to do heavier procesing.
-    // Using threads seems to be a bit overkill and too burdensome to do it properly.
+    const Sci_Position wordStart = editor->wordStartPosition(state.currentPos, true);
+    const Sci_Position wordEnd = editor->wordEndPosition(wordStart, true);
 
-    //const int startLine = editor->firstVisibleLine();
-    //const int linesOnScreen = editor->linesOnScreen();
-    //const int startPos = editor->positionFromLine(startLine);
-    //const int endPos = editor->lineEndPosition(startLine + linesOnScreen);
+    // Make sure the selection is on word boundaries
+    return !(wordStart == wordEnd || wordStart != selectionStart || wordEnd != selectionEnd);
+}
 
+// Appends the matches that start between start and end
+void SmartHighlighter::findMatches(Sci_Position start, Sci_Position end, QVector<Sci_Position> &ranges) const
+{
     // TODO: skip hidden or folded lines?
 
-    Sci_TextToFind ttf {{0, (Sci_PositionCR)editor->length()}, selText.constData(), {-1, -1}};
+    // Let a match that starts before end finish after it
+    const Sci_Position searchEnd = qMin<Sci_Position>(end + searchText.size(), editor->length());
+    Sci_TextToFindFull ttf {{start, searchEnd}, searchText.constData(), {-1, -1}};
     const int flags = SCFIND_MATCHCASE | SCFIND_WHOLEWORD;
 
-    while (editor->send(SCI_FINDTEXT, flags, (sptr_t)&ttf) != -1) {
-        editor->indicatorFillRange(ttf.chrgText.cpMin, ttf.chrgText.cpMax - ttf.chrgText.cpMin);
+    while (editor->send(SCI_FINDTEXTFULL, flags, (sptr_t)&ttf) != -1 && ttf.chrgText.cpMin < end) {
+        ranges.append(ttf.chrgText.cpMin);
+        ranges.append(ttf.chrgText.cpMax - ttf.chrgText.cpMin);
         ttf.chrg.cpMin = ttf.chrgText.cpMax;
     }
 }
+
+bool SmartHighlighter::searchNextChunk()
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    const Sci_Position length = editor->length();
+    do {
+        const Sci_Position chunkEnd = qMin(searchPosition + SearchChunkSize, length);
+
+        findMatches(searchPosition, chunkEnd, matches);
+        searchPosition = chunkEnd;
+    } while (searchPosition < length && elapsed.elapsed() < SearchMilliseconds);
+
+    if (searchPosition < length) {
+        return true;
+    }
+
+    setHighlights(matches);
+    matches.clear();
+
+    return false;
+}
+
+void SmartHighlighter::setHighlights(const QVector<Sci_Position> &ranges)
+{
+    editor->setIndicatorCurrent(29);
+    editor->indicatorReplaceRanges(ranges.size() / 2, reinterpret_cast<sptr_t>(ranges.constData()));
+}
@@ -22,6 +22,8 @@
 
 #include "EditorDecorator.h"
 
+#include <QVector>
+
 
 class SmartHighlighter : public EditorDecorator
 {
@@ -30,11 +32,20 @@ class SmartHighlighter : public EditorDecorator
 public:
     SmartHighlighter(ScintillaNext *editor);
 
-private:
-    void highlightCurrentView();
+protected:
+    void editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state) override;
 
-public slots:
-    void notify(const Scintilla::NotificationData *pscn) override;
+private:
+    void highlightCurrentView(const EditorNotificationHub::State &state);
+    bool canHighlight(const EditorNotificationHub::State &state) const;
+    void findMatches(Sci_Position start, Sci_Position end, QVector<Sci_Position> &ranges) const;
+    bool searchNextChunk();
+    void setHighlights(const QVector<Sci_Position> &ranges);
+
+    // The rest of a large document is searched in idle time
+    QByteArray searchText;
+    Sci_Position searchPosition = 0;
+    QVector<Sci_Position> matches;
 };
 
 #endif // SMARTHIGHLIGHTER_H
@@ -48,16 +48,20 @@
 #include "Settings.h"
 
 #include "ScintillaNext.h"
+#include "ContentSniffer.h"
 
 #include "RecentFilesListManager.h"
 #include "EditorManager.h"
 
 #include "MacroRecorder.h"
+#include "PerformanceTrace.h"
 
 #include "LuaConsoleDock.h"
 #include "LanguageInspectorDock.h"
 #include "EditorInspectorDock.h"
 #include "FolderAsWorkspaceDock.h"
+#include "MinimapDock.h"
+#include "PerformanceDock.h"
 
 #include "FindReplaceDialog.h"
 #include "MacroRunDialog.h"
@@ -65,6 +69,7 @@
 #include "PreferencesDialog.h"
 
 #include "QuickFindWidget.h"
+#include "LineNumbers.h"
 
 #include "EditorPrintPreviewRenderer.h"
 
@@ -391,6 +396,12 @@ MainWindow::MainWindow(NotepadNextApplication *app) :
         }
     });
 
+    connect(ui->actionRelativeLineNumbers, &QAction::triggered, [=](bool b) {
+        for (auto &editor : dockedEditor->editors()) {
+            editor->findChild<LineNumbers *>()->setRelativeLineNumbers(b);
+        }
+    });
+
     connect(ui->actionZoomIn, &QAction::triggered, [=]() { dockedEditor->getCurrentEditor()->zoomIn(); });
     connect(ui->actionZoomOut, &QAction::triggered, [=]() { dockedEditor->getCurrentEditor()->zoomOut(); });
     connect(ui->actionZoomReset, &QAction::triggered, [=]() { dockedEditor->getCurrentEditor()->setZoom(0); });
@@ -528,6 +539,25 @@ MainWindow::MainWindow(NotepadNextApplication *app) :
                                 .arg(QApplication::applicationDisplayName(), APP_VERSION, QStringLiteral(APP_COPYRIGHT).toHtmlEscaped()));
     });
 
+    // Tracing may already have been started from the command line
+    ui->actionRecordPerformanceTrace->setChecked(PerformanceTrace::isEnabled());
+    connect(ui->actionRecordPerformanceTrace, &QAction::toggled, this, [=](bool checked) {
+        if (checked)
+            PerformanceTrace::clear();
+
+        PerformanceTrace::setEnabled(checked);
+    });
+    connect(ui->actionSavePerformanceTrace, &QAction::triggered, this, [=]() {
+        QString fileName = QFileDialog::getSaveFileName(this, tr("Save Performance Trace"), QString(), tr("Trace Files (*.json)"));
+
+        if (fileName.isEmpty())
+            return;
+
+        if (!PerformanceTrace::writeChromeTrace(fileName)) {
+            QMessageBox::warning(this, tr("Error Saving Trace"), tr("Cannot save the performance trace to %1").arg(fileName));
+        }
+    });
+
     QAction *separator = ui->menuHelp->insertSeparator(ui->actionCheckForUpdates);
 
     EditorInspectorDock *editorInspectorDock = new EditorInspectorDock(this);
@@ -545,6 +575,11 @@ MainWindow::MainWindow(NotepadNextApplication *app) :
     addDockWidget(Qt::BottomDockWidgetArea, luaConsoleDock);
     ui->menuHelp->insertAction(languageInspectorDock->toggleViewAction(), luaConsoleDock->toggleViewAction());
 
+    PerformanceDock *performanceDock = new PerformanceDock(this);
+    performanceDock->hide();
+    addDockWidget(Qt::RightDockWidgetArea, performanceDock);
+    ui->menuHelp->insertAction(separator, performanceDock->toggleViewAction());
+
     FolderAsWorkspaceDock *fawDock = new FolderAsWorkspaceDock(this);
     fawDock->hide();
     addDockWidget(Qt::LeftDockWidgetArea, fawDock);
@@ -552,6 +587,11 @@ MainWindow::MainWindow(NotepadNextApplication *app) :
     ui->menuView->addAction(fawDock->toggleViewAction());
     connect(fawDock, &FolderAsWorkspaceDock::fileDoubleClicked, this, &MainWindow::openFile);
 
+    MinimapDock *minimapDock = new MinimapDock(this);
+    minimapDock->hide();
+    addDockWidget(Qt::RightDockWidgetArea, minimapDock);
+    ui->menuView->addAction(minimapDock->toggleViewAction());
+
     connect(app->getSettings(), &Settings::showMenuBarChanged, [=](bool showMenuBar) {
         // Don't 'hide' it, else the actions won't be enabled
         ui->menuBar->setMaximumHeight(showMenuBar ? QWIDGETSIZE_MAX : 0);
@@ -1193,19 +1233,15 @@ void MainWindow::updateGui(ScintillaNext *editor)
     updateLanguageBasedUi(editor);
 }
 
-void MainWindow::updateDocumentBasedUi(Scintilla::Update updated)
+void MainWindow::updateDocumentBasedUi(ScintillaNext *editor, EditorNotificationHub::Events events)
 {
-    ScintillaNext *editor = qobject_cast<ScintillaNext *>(sender());
-
     // TODO: what if this is triggered by an editor that is not the active editor?
 
-    if (Scintilla::FlagSet(updated, Scintilla::Update::Content)) {
+    if (events.testFlag(EditorNotificationHub::ContentChanged)) {
         updateSelectionBasedUi(editor);
     }
 
-    if (Scintilla::FlagSet(updated, Scintilla::Update::Content) || Scintilla::FlagSet(updated, Scintilla::Update::Selection)) {
-        updateContentBasedUi(editor);
-    }
+    updateContentBasedUi(editor);
 }
 
 void MainWindow::updateSelectionBasedUi(ScintillaNext *editor)
@@ -1233,9 +1269,17 @@ void MainWindow::detectLanguage(ScintillaNext *editor)
         return;
     }
     else {
-        // Only real files have extensions
-        const QString ext = editor->getFileInfo().suffix();
-        const QString language_name = app->detectLanguageFromExtension(ext);
+        // Well known file names take priority, then real extensions, then whatever the contents look like
+        QString ext = ContentSniffer::extensionForFileName(editor->getFileInfo().fileName());
+        if (ext.isEmpty()) {
+            ext = editor->getFileInfo().suffix();
+        }
+
+        QString language_name = app->detectLanguageFromExtension(ext);
+
+        if (ext.isEmpty() && !editor->getContentExtension().isEmpty()) {
+            language_name = app->detectLanguageFromExtension(editor->getContentExtension());
+        }
 
         setLanguage(editor, language_name);
     }
@@ -1330,11 +1374,14 @@ void MainWindow::saveSettings() const
     settings.setValue("Gui/ShowToolBar", app->getSettings()->showToolBar());
     settings.setValue("Gui/ShowStatusBar", app->getSettings()->showStatusBar());
 
+    settings.setValue("Editor/PersistUndoHistory", app->getSettings()->persistUndoHistory());
+
     settings.setValue("Editor/ShowWhitespace", ui->actionShowWhitespace->isChecked());
     settings.setValue("Editor/ShowEndOfLine", ui->actionShowEndofLine->isChecked());
     settings.setValue("Editor/ShowWrapSymbol", ui->actionShowWrapSymbol->isChecked());
 
     settings.setValue("Editor/WordWrap", ui->actionWordWrap->isChecked());
+    settings.setValue("Editor/RelativeLineNumbers", ui->actionRelativeLineNumbers->isChecked());
     settings.setValue("Editor/IndentGuide", ui->actionShowIndentGuide->isChecked());
 
     FolderAsWorkspaceDock *fawDock = findChild<FolderAsWorkspaceDock *>();
@@ -1351,11 +1398,14 @@ void MainWindow::restoreSettings()
     app->getSettings()->setShowToolBar(settings.value("Gui/ShowToolBar", true).toBool());
     app->getSettings()->setShowStatusBar(settings.value("Gui/ShowStatusBar", true).toBool());
 
+    app->getSettings()->setPersistUndoHistory(settings.value("Editor/PersistUndoHistory", false).toBool());
+
     ui->actionShowWhitespace->setChecked(settings.value("Editor/ShowWhitespace", false).toBool());
     ui->actionShowEndofLine->setChecked(settings.value("Editor/ShowEndOfLine", false).toBool());
     ui->actionShowWrapSymbol->setChecked(settings.value("Editor/ShowWrapSymbol", false).toBool());
 
     ui->actionWordWrap->setChecked(settings.value("Editor/WordWrap", false).toBool());
+    ui->actionRelativeLineNumbers->setChecked(settings.value("Editor/RelativeLineNumbers", false).toBool());
     ui->actionShowIndentGuide->setChecked(settings.value("Editor/IndentGuide", true).toBool());
 }
 
@@ -1392,7 +1442,10 @@ void MainWindow::addEditor(ScintillaNext *editor)
     connect(editor, &ScintillaNext::savePointChanged, this, [=]() { updateSaveStatusBasedUi(editor); });
     connect(editor, &ScintillaNext::renamed, this, [=]() { detectLanguage(editor); });
     connect(editor, &ScintillaNext::renamed, this, [=]() { updateFileStatusBasedUi(editor); });
-    connect(editor, &ScintillaNext::updateUi, this, &MainWindow::updateDocumentBasedUi);
+    editor->notificationHub()->subscribe(this, EditorNotificationHub::ContentChanged | EditorNotificationHub::SelectionChanged, [=](EditorNotificationHub::Events events, const EditorNotificationHub::State &state) {
+        Q_UNUSED(state);
+        updateDocumentBasedUi(editor, events);
+    });
     connect(editor, &ScintillaNext::marginClicked, [editor](Scintilla::Position position, Scintilla::KeyMod modifiers, int margin) {
         Q_UNUSED(modifiers);
 
@@ -1413,6 +1466,9 @@ void MainWindow::addEditor(ScintillaNext *editor)
     if (ui->actionWordWrap->isChecked())
         editor->setWrapMode(SC_WRAP_WHITESPACE);
 
+    if (ui->actionRelativeLineNumbers->isChecked())
+        editor->findChild<LineNumbers *>()->setRelativeLineNumbers(true);
+
     if (ui->actionShowIndentGuide->isChecked())
         editor->setIndentationGuides(SC_IV_LOOKBOTH);
 
@@ -27,6 +27,7 @@
 #include "DockedEditor.h"
 
 #include "ScintillaNext.h"
+#include "EditorNotificationHub.h"
 #include "NppImporter.h"
 
 namespace Ui {
@@ -92,7 +93,7 @@ public slots:
 
     void updateFileStatusBasedUi(ScintillaNext *editor);
     void updateEOLBasedUi(ScintillaNext *editor);
-    void updateDocumentBasedUi(Scintilla::Update updated);
+    void updateDocumentBasedUi(ScintillaNext *editor, EditorNotificationHub::Events events);
     void updateSelectionBasedUi(ScintillaNext *editor);
     void updateContentBasedUi(ScintillaNext *editor);
     void updateSaveStatusBasedUi(ScintillaNext *editor);
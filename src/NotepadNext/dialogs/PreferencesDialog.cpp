@@ -40,6 +40,10 @@ PreferencesDialog::PreferencesDialog(Settings *settings, QWidget *parent) :
     ui->checkBoxStatusBar->setChecked(settings->showStatusBar());
     connect(settings, &Settings::showStatusBarChanged, ui->checkBoxStatusBar, &QCheckBox::setChecked);
     connect(ui->checkBoxStatusBar, &QCheckBox::clicked, settings, &Settings::setShowStatusBar);
+
+    ui->checkBoxPersistUndoHistory->setChecked(settings->persistUndoHistory());
+    connect(settings, &Settings::persistUndoHistoryChanged, ui->checkBoxPersistUndoHistory, &QCheckBox::setChecked);
+    connect(ui->checkBoxPersistUndoHistory, &QCheckBox::clicked, settings, &Settings::setPersistUndoHistory);
 }
 
 PreferencesDialog::~PreferencesDialog()
@@ -126,7 +126,13 @@ void EditorInspectorDock::connectToEditor(ScintillaNext *editor)
 {
     disconnectFromEditor();
 
-    editorConnection = connect(editor, &ScintillaNext::updateUi, this, &EditorInspectorDock::editorUIUpdated);
+    connectedEditor = editor;
+    editor->notificationHub()->subscribe(this,
+        EditorNotificationHub::ContentChanged | EditorNotificationHub::SelectionChanged | EditorNotificationHub::VerticalScroll | EditorNotificationHub::HorizontalScroll,
+        [=](EditorNotificationHub::Events events, const EditorNotificationHub::State &state) {
+            Q_UNUSED(state);
+            editorUIUpdated(events);
+        });
 
     updateEditorInfo(editor);
 }
@@ -134,21 +140,17 @@ void EditorInspectorDock::connectToEditor(ScintillaNext *editor)
 
 void EditorInspectorDock::disconnectFromEditor()
 {
-    if (editorConnection) {
-        disconnect(editorConnection);
+    if (connectedEditor) {
+        connectedEditor->notificationHub()->unsubscribe(this);
+        connectedEditor = Q_NULLPTR;
     }
 }
 
-void EditorInspectorDock::editorUIUpdated(Scintilla::Update updated)
+void EditorInspectorDock::editorUIUpdated(EditorNotificationHub::Events events)
 {
-    if (FlagSet(updated, Scintilla::Update::Content)
-            || FlagSet(updated, Scintilla::Update::Selection)
-            || FlagSet(updated, Scintilla::Update::VScroll)
-            || FlagSet(updated, Scintilla::Update::HScroll)) {
-        ScintillaNext *editor = qobject_cast<ScintillaNext*>(sender());
+    Q_UNUSED(events);
 
-        updateEditorInfo(editor);
-    }
+    updateEditorInfo(connectedEditor);
 }
 
 void EditorInspectorDock::updateEditorInfo(ScintillaNext *editor)
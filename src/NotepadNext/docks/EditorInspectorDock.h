@@ -22,8 +22,9 @@
 
 #include <QDockWidget>
 #include <QTreeWidgetItem>
+#include <QPointer>
 
-#include "ScintillaTypes.h"
+#include "EditorNotificationHub.h"
 
 
 class MainWindow;
@@ -45,7 +46,7 @@ public:
 
 private slots:
     void connectToEditor(ScintillaNext *editor);
-    void editorUIUpdated(Scintilla::Update updated);
+    void editorUIUpdated(EditorNotificationHub::Events events);
     void updateEditorInfo(ScintillaNext *editor);
 
 private:
@@ -54,7 +55,7 @@ private:
 
     Ui::EditorInspectorDock *ui;
     QTreeWidgetItem *selectionsInfo;
-    QMetaObject::Connection editorConnection;
+    QPointer<ScintillaNext> connectedEditor;
     QVector<QPair<QTreeWidgetItem *, EditorFunction>> items;
 };
 
@@ -0,0 +1,53 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "MinimapDock.h"
+#include "ui_MinimapDock.h"
+
+#include "MainWindow.h"
+#include "ScintillaNext.h"
+
+
+MinimapDock::MinimapDock(MainWindow *parent) :
+    QDockWidget(parent),
+    ui(new Ui::MinimapDock)
+{
+    ui->setupUi(this);
+
+    connect(this, &QDockWidget::visibilityChanged, this, [=](bool visible) {
+        if (visible) {
+            connectToEditor(parent->currentEditor());
+            connect(parent, &MainWindow::editorActivated, this, &MinimapDock::connectToEditor);
+        }
+        else {
+            disconnect(parent, &MainWindow::editorActivated, this, &MinimapDock::connectToEditor);
+            connectToEditor(Q_NULLPTR);
+        }
+    });
+}
+
+MinimapDock::~MinimapDock()
+{
+    delete ui;
+}
+
+void MinimapDock::connectToEditor(ScintillaNext *editor)
+{
+    ui->minimap->setEditor(editor);
+}
@@ -0,0 +1,222 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "PerformanceDock.h"
+#include "ui_PerformanceDock.h"
+
+#include "MainWindow.h"
+#include "ScintillaNext.h"
+
+#include <QFile>
+#include <QLocale>
+
+#if defined(Q_OS_WIN)
+#include <Windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#elif defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+
+
+// Refreshing more often than this would start to show up in the numbers being displayed
+static const int RefreshInterval = 1000;
+
+static qint64 residentMemory()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return info.resident_size;
+    }
+#elif defined(Q_OS_UNIX)
+    // The second field is the resident set size in pages
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (statm.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+
+    return -1;
+}
+
+static inline QString dataSize(qint64 bytes) {
+    return bytes < 0 ? QStringLiteral("Unknown") : QLocale::system().formattedDataSize(bytes);
+}
+
+static QString hitRate(sptr_t hits, sptr_t misses)
+{
+    const sptr_t total = hits + misses;
+
+    if (total == 0)
+        return QStringLiteral("-");
+
+    return QStringLiteral("%1% (%2 of %3)").arg(100.0 * hits / total, 0, 'f', 1).arg(hits).arg(total);
+}
+
+static QString idleTasks(ScintillaNext *editor)
+{
+    const int tasks = editor->idleTasks();
+    QStringList names;
+
+    if (tasks & SC_IDLETASK_WRAP)
+        names.append(QStringLiteral("Wrap"));
+    if (tasks & SC_IDLETASK_STYLE)
+        names.append(QStringLiteral("Style"));
+    if (tasks & SC_IDLETASK_LAYOUT)
+        names.append(QStringLiteral("Layout"));
+    if (tasks & SC_IDLETASK_QUEUED)
+        names.append(QStringLiteral("Queued"));
+    if (tasks & SC_IDLETASK_ACTIVE)
+        names.append(QStringLiteral("Active"));
+
+    return names.isEmpty() ? QStringLiteral("None") : names.join(QStringLiteral(", "));
+}
+
+PerformanceDock::PerformanceDock(MainWindow *parent) :
+    QDockWidget(parent),
+    ui(new Ui::PerformanceDock)
+{
+    ui->setupUi(this);
+
+    QTreeWidgetItem *documentInfo = new QTreeWidgetItem(ui->treeWidget);
+    documentInfo->setText(0, tr("Document"));
+    documentInfo->setExpanded(true);
+
+    newItem(documentInfo, tr("Size"), [](ScintillaNext *editor) { return dataSize(editor->length()); });
+    newItem(documentInfo, tr("Line Count"), [](ScintillaNext *editor) { return QString::number(editor->lineCount()); });
+    newItem(documentInfo, tr("Undo Memory"), [](ScintillaNext *editor) { return dataSize(editor->undoMemory()); });
+    newItem(documentInfo, tr("Undo Actions"), [](ScintillaNext *editor) { return QString::number(editor->undoActions()); });
+    newItem(documentInfo, tr("Styled Up To"), [](ScintillaNext *editor) {
+        const sptr_t length = editor->length();
+        const sptr_t endStyled = editor->endStyled();
+        const double percent = length ? 100.0 * endStyled / length : 100.0;
+        return QStringLiteral("%1 of %2 (%3%)").arg(endStyled).arg(length).arg(percent, 0, 'f', 1);
+    });
+
+
+    QTreeWidgetItem *layoutInfo = new QTreeWidgetItem(ui->treeWidget);
+    layoutInfo->setText(0, tr("Layout"));
+    layoutInfo->setExpanded(true);
+
+    newItem(layoutInfo, tr("Layout Cache Hit Rate"), [](ScintillaNext *editor) { return hitRate(editor->layoutCacheStatistic(SC_LAYOUTCACHE_HITS), editor->layoutCacheStatistic(SC_LAYOUTCACHE_MISSES)); });
+    newItem(layoutInfo, tr("Layout Cache Entries"), [](ScintillaNext *editor) { return QString::number(editor->layoutCacheStatistic(SC_LAYOUTCACHE_ENTRIES)); });
+    newItem(layoutInfo, tr("Layout Cache Memory"), [](ScintillaNext *editor) { return dataSize(editor->layoutCacheStatistic(SC_LAYOUTCACHE_MEMORY)); });
+    newItem(layoutInfo, tr("Layout Cache Evictions"), [](ScintillaNext *editor) { return QString::number(editor->layoutCacheStatistic(SC_LAYOUTCACHE_EVICTIONS)); });
+    newItem(layoutInfo, tr("Position Cache Hit Rate"), [](ScintillaNext *editor) { return hitRate(editor->positionCacheStatistic(SC_LAYOUTCACHE_HITS), editor->positionCacheStatistic(SC_LAYOUTCACHE_MISSES)); });
+    newItem(layoutInfo, tr("Position Cache Entries"), [](ScintillaNext *editor) { return QString::number(editor->positionCacheStatistic(SC_LAYOUTCACHE_ENTRIES)); });
+    newItem(layoutInfo, tr("Idle Work"), [](ScintillaNext *editor) { return idleTasks(editor); });
+    newItem(layoutInfo, tr("Last Paint Time"), [](ScintillaNext *editor) { return QStringLiteral("%1 ms").arg(editor->lastPaintDuration() / 1000000.0, 0, 'f', 2); });
+
+
+    indicatorInfo = new QTreeWidgetItem(ui->treeWidget);
+    indicatorInfo->setText(0, tr("Indicator Runs"));
+    indicatorInfo->setExpanded(true);
+
+
+    QTreeWidgetItem *appInfo = new QTreeWidgetItem(ui->treeWidget);
+    appInfo->setText(0, tr("Application"));
+    appInfo->setExpanded(true);
+
+    newItem(appInfo, tr("Resident Memory"), [](ScintillaNext *editor) { Q_UNUSED(editor); return dataSize(residentMemory()); });
+
+    connect(ui->resetButton, &QPushButton::clicked, this, [=]() {
+        if (connectedEditor) {
+            connectedEditor->resetLayoutCacheStatistics();
+            connectedEditor->resetPositionCacheStatistics();
+            updatePerformanceInfo();
+        }
+    });
+
+    refreshTimer.setInterval(RefreshInterval);
+    connect(&refreshTimer, &QTimer::timeout, this, &PerformanceDock::updatePerformanceInfo);
+
+    connect(this, &QDockWidget::visibilityChanged, this, [=](bool visible) {
+        if (visible) {
+            connectToEditor(parent->currentEditor());
+            connect(parent, &MainWindow::editorActivated, this, &PerformanceDock::connectToEditor);
+            refreshTimer.start();
+        }
+        else {
+            refreshTimer.stop();
+            disconnect(parent, &MainWindow::editorActivated, this, &PerformanceDock::connectToEditor);
+            connectedEditor = Q_NULLPTR;
+        }
+    });
+}
+
+PerformanceDock::~PerformanceDock()
+{
+    delete ui;
+}
+
+void PerformanceDock::connectToEditor(ScintillaNext *editor)
+{
+    connectedEditor = editor;
+
+    updatePerformanceInfo();
+}
+
+void PerformanceDock::updatePerformanceInfo()
+{
+    if (!connectedEditor)
+        return;
+
+    for (const QPair<QTreeWidgetItem *, CounterFunction> &pair : qAsConst(items)) {
+        QTreeWidgetItem *item = pair.first;
+
+        if (item->parent()->isExpanded()) {
+            CounterFunction func = pair.second;
+            item->setText(1, func(connectedEditor));
+        }
+    }
+
+    if (indicatorInfo->isExpanded()) {
+        qDeleteAll(indicatorInfo->takeChildren());
+
+        for (int indicator = 0; indicator <= INDICATOR_MAX; ++indicator) {
+            const sptr_t runs = connectedEditor->indicatorRuns(indicator);
+
+            if (runs > 0) {
+                QTreeWidgetItem *item = new QTreeWidgetItem(indicatorInfo);
+                item->setText(0, tr("Indicator %1").arg(indicator));
+                item->setText(1, QString::number(runs));
+            }
+        }
+    }
+
+    ui->treeWidget->resizeColumnToContents(0);
+}
+
+void PerformanceDock::newItem(QTreeWidgetItem *parent, const QString &label, CounterFunction func)
+{
+    QTreeWidgetItem *item = new QTreeWidgetItem(parent);
+    item->setText(0, label);
+    items.append(qMakePair(item, func));
+}
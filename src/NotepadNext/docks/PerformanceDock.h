@@ -0,0 +1,64 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PERFORMANCEDOCK_H
+#define PERFORMANCEDOCK_H
+
+#include <QDockWidget>
+#include <QTreeWidgetItem>
+#include <QPointer>
+#include <QTimer>
+
+#include <functional>
+
+
+class MainWindow;
+class ScintillaNext;
+
+namespace Ui {
+class PerformanceDock;
+}
+
+// Shows what the active editor is costing. The counters are polled at a low rate while the dock
+// is visible rather than being updated by the editor, so nothing is added to editing itself.
+class PerformanceDock : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PerformanceDock(MainWindow *parent);
+    ~PerformanceDock();
+
+private slots:
+    void connectToEditor(ScintillaNext *editor);
+    void updatePerformanceInfo();
+
+private:
+    typedef std::function<QString(ScintillaNext *)> CounterFunction;
+
+    void newItem(QTreeWidgetItem *parent, const QString &label, CounterFunction func);
+
+    Ui::PerformanceDock *ui;
+    QTreeWidgetItem *indicatorInfo;
+    QPointer<ScintillaNext> connectedEditor;
+    QVector<QPair<QTreeWidgetItem *, CounterFunction>> items;
+    QTimer refreshTimer;
+};
+
+#endif // PERFORMANCEDOCK_H
@@ -70,48 +70,59 @@ void EditorInfoStatusBar::refresh(ScintillaNext *editor)
 void EditorInfoStatusBar::connectToEditor(ScintillaNext *editor)
 {
     // Remove any previous connections
-    disconnect(editorUiUpdated);
+    if (connectedEditor) {
+        connectedEditor->notificationHub()->unsubscribe(this);
+    }
     disconnect(documentLexerChanged);
 
     // Connect to the new editor
-    editorUiUpdated = connect(editor, &ScintillaNext::updateUi, this, &EditorInfoStatusBar::editorUpdated);
+    connectedEditor = editor;
+    editor->notificationHub()->subscribe(this, EditorNotificationHub::ContentChanged | EditorNotificationHub::SelectionChanged, [=](EditorNotificationHub::Events events, const EditorNotificationHub::State &state) {
+        editorUpdated(events, state);
+    });
     documentLexerChanged = connect(editor->get_doc(), &ScintillaDocument::lexer_changed, this, [=]() { updateLanguage(editor); });
 
     refresh(editor);
 }
 
-void EditorInfoStatusBar::editorUpdated(Scintilla::Update updated)
+void EditorInfoStatusBar::editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state)
 {
-    ScintillaNext *editor = qobject_cast<ScintillaNext *>(sender());
-
-    if (Scintilla::FlagSet(updated, Scintilla::Update::Content)) {
-        updateDocumentSize(editor);
+    if (events.testFlag(EditorNotificationHub::ContentChanged)) {
+        updateDocumentSize(state);
     }
 
-    if (Scintilla::FlagSet(updated, Scintilla::Update::Content) || Scintilla::FlagSet(updated, Scintilla::Update::Selection)) {
-        updateSelectionInfo(editor);
-    }
+    updateSelectionInfo(connectedEditor, state);
 }
 
 void EditorInfoStatusBar::updateDocumentSize(ScintillaNext *editor)
+{
+    updateDocumentSize(editor->notificationHub()->state());
+}
+
+void EditorInfoStatusBar::updateDocumentSize(const EditorNotificationHub::State &state)
 {
     QString sizeText = tr("Length: %1    Lines: %2").arg(
-            QLocale::system().toString(editor->length()),
-            QLocale::system().toString(editor->lineCount()));
+            QLocale::system().toString(state.length),
+            QLocale::system().toString(state.lineCount));
     docSize->setText(sizeText);
 }
 
 void EditorInfoStatusBar::updateSelectionInfo(ScintillaNext *editor)
+{
+    updateSelectionInfo(editor, editor->notificationHub()->state());
+}
+
+void EditorInfoStatusBar::updateSelectionInfo(ScintillaNext *editor, const EditorNotificationHub::State &state)
 {
     QString selectionText;
 
-    if (editor->selections() > 1) {
+    if (state.selections > 1) {
         selectionText = tr("Sel: N/A");
     }
     else {
-        int start = editor->selectionStart();
-        int end = editor->selectionEnd();
-        int lines = editor->lineFromPosition(end) - editor->lineFromPosition(start);
+        const Sci_Position start = state.selectionStart;
+        const Sci_Position end = state.selectionEnd;
+        Scintilla::Line lines = editor->lineFromPosition(end) - editor->lineFromPosition(start);
 
         if (end > start)
             lines++;
@@ -121,10 +132,9 @@ void EditorInfoStatusBar::updateSelectionInfo(ScintillaNext *editor)
                 QLocale::system().toString(lines));
     }
 
-    const int pos = editor->currentPos();
     QString positionText = tr("Ln: %1    Col: %2    ").arg(
-            QLocale::system().toString(editor->lineFromPosition(pos) + 1),
-            QLocale::system().toString(editor->column(pos) + 1));
+            QLocale::system().toString(state.caretLine + 1),
+            QLocale::system().toString(editor->column(state.currentPos) + 1));
     docPos->setText(positionText + selectionText);
 }
 
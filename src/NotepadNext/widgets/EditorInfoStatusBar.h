@@ -21,8 +21,9 @@
 #define EDITORINFOSTATUSBAR_H
 
 #include <QStatusBar>
+#include <QPointer>
 
-#include "ScintillaTypes.h"
+#include "EditorNotificationHub.h"
 
 
 class QLabel;
@@ -41,10 +42,12 @@ public:
 private slots:
     void connectToEditor(ScintillaNext *editor);
 
-    void editorUpdated(Scintilla::Update updated);
+    void editorUpdated(EditorNotificationHub::Events events, const EditorNotificationHub::State &state);
 
     void updateDocumentSize(ScintillaNext *editor);
+    void updateDocumentSize(const EditorNotificationHub::State &state);
     void updateSelectionInfo(ScintillaNext *editor);
+    void updateSelectionInfo(ScintillaNext *editor, const EditorNotificationHub::State &state);
     void updateLanguage(ScintillaNext *editor);
     void updateEol(ScintillaNext *editor);
     void updateEncoding(ScintillaNext *editor);
@@ -56,7 +59,7 @@ private:
     QLabel *unicodeType;
     QLabel *eolFormat;
 
-    QMetaObject::Connection editorUiUpdated;
+    QPointer<ScintillaNext> connectedEditor;
     QMetaObject::Connection documentLexerChanged;
 };
 
@@ -0,0 +1,351 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "MinimapWidget.h"
+
+#include "IdleScheduler.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QWheelEvent>
+
+#include <climits>
+
+
+using namespace Scintilla;
+
+// Pixels for each line of the document, the second row is left blank to separate lines
+static const int LineHeight = 2;
+
+// Lines drawn together, also the smallest area redrawn after a modification
+static const int LinesPerTile = 256;
+
+// Each character is a pixel wide, anything past this column is not shown
+static const int TileWidth = 160;
+
+// About 8 MB of images, many more than are needed to fill the tallest screen
+static const int MaxTiles = 24;
+
+static inline QRgb rgbFromColour(sptr_t colour)
+{
+    return qRgb(colour & 0xFF, (colour >> 8) & 0xFF, (colour >> 16) & 0xFF);
+}
+
+MinimapWidget::MinimapWidget(QWidget *parent) :
+    QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumWidth(40);
+}
+
+void MinimapWidget::setEditor(ScintillaNext *editor)
+{
+    if (this->editor) {
+        disconnect(this->editor, Q_NULLPTR, this, Q_NULLPTR);
+    }
+
+    IdleScheduler::instance()->cancel(this);
+    tiles.clear();
+    styleColours.clear();
+
+    this->editor = editor;
+
+    if (editor) {
+        connect(editor, &ScintillaNext::notify, this, &MinimapWidget::notification);
+    }
+
+    update();
+}
+
+void MinimapWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter p(this);
+    p.fillRect(rect(), QColor(background));
+
+    if (!editor) {
+        return;
+    }
+
+    const int first = firstLine();
+    const int last = qMin<int>(first + height() / LineHeight, editor->lineCount() - 1);
+    bool needRendering = false;
+
+    for (int index = first / LinesPerTile; index <= last / LinesPerTile; ++index) {
+        auto it = tiles.constFind(index);
+
+        if (it == tiles.constEnd() || it->dirty) {
+            needRendering = true;
+        }
+
+        // A modified tile is still shown until it has been redrawn
+        if (it != tiles.constEnd() && !it->image.isNull()) {
+            p.drawImage(0, (index * LinesPerTile - first) * LineHeight, it->image);
+        }
+    }
+
+    if (needRendering) {
+        scheduleRendering();
+    }
+
+    // Show where the editor is looking
+    const int firstVisible = editor->docLineFromVisible(editor->firstVisibleLine());
+    const int lastVisible = editor->docLineFromVisible(editor->firstVisibleLine() + editor->linesOnScreen());
+    QColor highlight = palette().color(QPalette::Highlight);
+    highlight.setAlpha(60);
+    p.fillRect(0, (firstVisible - first) * LineHeight, width(), (lastVisible - firstVisible + 1) * LineHeight, highlight);
+}
+
+void MinimapWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        scrollEditorTo(event->pos().y());
+    }
+}
+
+void MinimapWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (event->buttons() & Qt::LeftButton) {
+        scrollEditorTo(event->pos().y());
+    }
+}
+
+void MinimapWidget::wheelEvent(QWheelEvent *event)
+{
+    if (editor) {
+        // Three lines for each step of the wheel as the editor does
+        editor->lineScroll(0, -event->angleDelta().y() / 40);
+    }
+}
+
+void MinimapWidget::notification(const NotificationData *pscn)
+{
+    if (pscn->nmhdr.code == Notification::Modified) {
+        if (FlagSet(pscn->modificationType, ModificationFlags::InsertText | ModificationFlags::DeleteText | ModificationFlags::ChangeStyle)) {
+            const int first = static_cast<int>(editor->lineFromPosition(pscn->position));
+
+            if (pscn->linesAdded != 0) {
+                // Every line after the change has moved
+                invalidateLines(first, INT_MAX);
+            }
+            else if (FlagSet(pscn->modificationType, ModificationFlags::DeleteText)) {
+                invalidateLines(first, first);
+            }
+            else {
+                invalidateLines(first, static_cast<int>(editor->lineFromPosition(pscn->position + pscn->length)));
+            }
+        }
+    }
+    else if (pscn->nmhdr.code == Notification::UpdateUI) {
+        if (FlagSet(pscn->updated, Update::VScroll)) {
+            update();
+        }
+    }
+}
+
+// The top line moves in proportion to the editor's so that both reach the end together
+int MinimapWidget::firstLine() const
+{
+    const int lineCount = editor->lineCount();
+    const int capacity = height() / LineHeight;
+
+    if (lineCount <= capacity) {
+        return 0;
+    }
+
+    const int top = editor->docLineFromVisible(editor->firstVisibleLine());
+    const int scrollable = qMax<int>(1, lineCount - editor->linesOnScreen());
+
+    return qBound(0, static_cast<int>(static_cast<qint64>(top) * (lineCount - capacity) / scrollable), lineCount - capacity);
+}
+
+void MinimapWidget::scrollEditorTo(int y)
+{
+    if (!editor) {
+        return;
+    }
+
+    const int lineCount = editor->lineCount();
+    const int capacity = height() / LineHeight;
+
+    // Dragging over a map that moves itself would jump around, so long documents map the whole
+    // height of the widget onto the whole document instead
+    int line;
+    if (lineCount <= capacity) {
+        line = y / LineHeight;
+    }
+    else {
+        line = static_cast<int>(static_cast<qint64>(qBound(0, y, height())) * lineCount / qMax(1, height()));
+    }
+
+    const int visibleLine = editor->visibleFromDocLine(qBound(0, line, lineCount - 1));
+    editor->setFirstVisibleLine(qMax<int>(0, visibleLine - editor->linesOnScreen() / 2));
+}
+
+void MinimapWidget::invalidateLines(int first, int last)
+{
+    const int firstTile = first / LinesPerTile;
+    const int lastTile = last / LinesPerTile;
+
+    for (auto it = tiles.begin(); it != tiles.end(); ++it) {
+        if (it.key() >= firstTile && it.key() <= lastTile) {
+            it->dirty = true;
+        }
+    }
+
+    if (isVisible()) {
+        scheduleRendering();
+    }
+}
+
+void MinimapWidget::scheduleRendering()
+{
+    if (!IdleScheduler::instance()->isScheduled(this)) {
+        IdleScheduler::instance()->schedule(this, [=]() { return renderNextTile(); });
+    }
+}
+
+// Draws a single tile so other work is not held up, returning whether more are needed
+bool MinimapWidget::renderNextTile()
+{
+    if (!editor || !isVisible()) {
+        return false;
+    }
+
+    updatePalette();
+
+    const int first = firstLine();
+    const int lastTileInDocument = (editor->lineCount() - 1) / LinesPerTile;
+    const int firstTile = first / LinesPerTile;
+    const int lastTile = qMin((first + height() / LineHeight) / LinesPerTile, lastTileInDocument);
+
+    // Tiles in view come first then one either side ready for scrolling
+    QVector<int> wanted;
+    for (int index = firstTile; index <= lastTile; ++index) {
+        wanted.append(index);
+    }
+    if (firstTile > 0) {
+        wanted.append(firstTile - 1);
+    }
+    if (lastTile < lastTileInDocument) {
+        wanted.append(lastTile + 1);
+    }
+
+    for (int index : qAsConst(wanted)) {
+        Tile &tile = tiles[index];
+
+        if (tile.dirty) {
+            renderTile(index, tile);
+            tile.dirty = false;
+
+            // Forget the tiles furthest from view
+            while (tiles.size() > MaxTiles) {
+                auto furthest = tiles.begin();
+                int furthestDistance = -1;
+
+                for (auto it = tiles.begin(); it != tiles.end(); ++it) {
+                    const int distance = it.key() < firstTile ? firstTile - it.key() : it.key() - lastTile;
+
+                    if (distance > furthestDistance) {
+                        furthest = it;
+                        furthestDistance = distance;
+                    }
+                }
+
+                tiles.erase(furthest);
+            }
+
+            update();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MinimapWidget::renderTile(int index, Tile &tile)
+{
+    if (tile.image.isNull()) {
+        tile.image = QImage(TileWidth, LinesPerTile * LineHeight, QImage::Format_RGB32);
+    }
+    tile.image.fill(background);
+
+    const int firstTileLine = index * LinesPerTile;
+    const int endTileLine = qMin<int>(firstTileLine + LinesPerTile, editor->lineCount());
+    const int tabWidth = qMax<int>(1, editor->tabWidth());
+    const bool utf8 = editor->codePage() == SC_CP_UTF8;
+    QByteArray styledText;
+
+    for (int line = firstTileLine; line < endTileLine; ++line) {
+        // A character takes at most 4 bytes so this is always enough to fill the width
+        const Sci_Position start = editor->positionFromLine(line);
+        const Sci_Position end = qMin<Sci_Position>(editor->lineEndPosition(line), start + TileWidth * 4);
+        const int length = static_cast<int>(end - start);
+
+        if (length <= 0) {
+            continue;
+        }
+
+        styledText.resize(2 * length + 2);
+        Sci_TextRangeFull tr {{start, end}, styledText.data()};
+        editor->send(SCI_GETSTYLEDTEXTFULL, 0, reinterpret_cast<sptr_t>(&tr));
+
+        QRgb *row = reinterpret_cast<QRgb *>(tile.image.scanLine((line - firstTileLine) * LineHeight));
+        int column = 0;
+
+        for (int i = 0; i < length && column < TileWidth; ++i) {
+            const unsigned char ch = styledText.at(2 * i);
+            const unsigned char style = styledText.at(2 * i + 1);
+
+            if (ch == '\t') {
+                column = (column / tabWidth + 1) * tabWidth;
+            }
+            else if (ch == ' ') {
+                column++;
+            }
+            else if (utf8 && (ch & 0xC0) == 0x80) {
+                // Trailing bytes belong to the character already drawn
+            }
+            else {
+                row[column] = styleColours.at(style);
+                column++;
+            }
+        }
+    }
+}
+
+// Picks up changes to the styles, which have no notification, before each tile is drawn
+void MinimapWidget::updatePalette()
+{
+    QVector<QRgb> colours(STYLE_MAX + 1);
+    for (int style = 0; style <= STYLE_MAX; ++style) {
+        colours[style] = rgbFromColour(editor->styleFore(style));
+    }
+    const QRgb back = rgbFromColour(editor->styleBack(STYLE_DEFAULT));
+
+    if (colours != styleColours || back != background) {
+        styleColours = colours;
+        background = back;
+
+        for (auto it = tiles.begin(); it != tiles.end(); ++it) {
+            it->dirty = true;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of Notepad Next.
+ * Copyright 2022 Justin Dailey
+ *
+ * Notepad Next is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Notepad Next is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Notepad Next.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MINIMAPWIDGET_H
+#define MINIMAPWIDGET_H
+
+#include <QWidget>
+#include <QHash>
+#include <QImage>
+#include <QPointer>
+#include <QVector>
+
+#include "ScintillaNext.h"
+
+
+// A scaled down picture of the document drawn from the styles of the text rather than by laying
+// it out, so it stays cheap for very large files. Each line is a thin strip with a block for each
+// run of characters in the colour of its style. The picture is made of tiles of lines which are
+// drawn in idle time as they come into view and redrawn when the lines in them are modified.
+class MinimapWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MinimapWidget(QWidget *parent = Q_NULLPTR);
+
+    void setEditor(ScintillaNext *editor);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+
+private slots:
+    void notification(const Scintilla::NotificationData *pscn);
+
+private:
+    struct Tile {
+        QImage image;
+        bool dirty = true;
+    };
+
+    int firstLine() const;
+    void scrollEditorTo(int y);
+
+    void invalidateLines(int first, int last);
+    void scheduleRendering();
+    bool renderNextTile();
+    void renderTile(int index, Tile &tile);
+    void updatePalette();
+
+    QPointer<ScintillaNext> editor;
+    QHash<int, Tile> tiles;
+    QVector<QRgb> styleColours;
+    QRgb background = qRgb(255, 255, 255);
+};
+
+#endif // MINIMAPWIDGET_H
@@ -649,6 +649,23 @@ bool isPHPStringState(int state) {
 	    (state == SCE_HPHP_COMPLEX_VARIABLE);
 }
 
+// Look back over JavaScript whitespace and comments for a symbol before startPos
+// as that helps decide whether a '/' starts a regular expression
+int PrevNonWhiteJS(Accessor &styler, Sci_Position startPos) {
+	Sci_Position back = startPos;
+	int style = 0;
+	while (--back) {
+		style = styler.StyleAt(back);
+		if (style < SCE_HJ_DEFAULT || style > SCE_HJ_COMMENTDOC)
+			// includes SCE_HJ_COMMENT & SCE_HJ_COMMENTLINE
+			break;
+	}
+	if (style == SCE_HJ_SYMBOLS) {
+		return static_cast<unsigned char>(styler.SafeGetCharAt(back));
+	}
+	return ' ';
+}
+
 Sci_Position FindPhpStringDelimiter(std::string &phpStringDelimiter, Sci_Position i, const Sci_Position lengthDoc, Accessor &styler, bool &isSimpleString) {
 	Sci_Position j;
 	const Sci_Position beginning = i - 1;
@@ -969,7 +986,7 @@ const char *tagsThatDoNotFold[] = {
 
 }
 
-class LexerHTML : public DefaultLexer {
+class LexerHTML : public DefaultLexer, public ILexerCheckpoint {
 	bool isXml;
 	bool isPHPScript;
 	WordList keywords;
@@ -981,6 +998,7 @@ class LexerHTML : public DefaultLexer {
 	OptionsHTML options;
 	OptionSetHTML osHTML;
 	std::set<std::string> nonFoldingTags;
+	std::string checkpointState;
 public:
 	explicit LexerHTML(bool isXml_, bool isPHPScript_) :
 		DefaultLexer(
@@ -1018,6 +1036,14 @@ public:
 	void SCI_METHOD Lex(Sci_PositionU startPos, Sci_Position length, int initStyle, IDocument *pAccess) override;
 	// No Fold as all folding performs in Lex.
 
+	void *SCI_METHOD PrivateCall(int operation, void *) override {
+		if (operation == lpcCheckpoint) {
+			return static_cast<ILexerCheckpoint *>(this);
+		}
+		return nullptr;
+	}
+	const char *SCI_METHOD CheckpointState(Sci_Position line, Sci_Position *length, IDocument *pAccess) override;
+
 	static ILexer5 *LexerFactoryHTML() {
 		return new LexerHTML(false, false);
 	}
@@ -1070,6 +1096,24 @@ Sci_Position SCI_METHOD LexerHTML::WordListSet(int n, const char *wl) {
 	return firstModification;
 }
 
+const char *SCI_METHOD LexerHTML::CheckpointState(Sci_Position line, Sci_Position *length, IDocument *pAccess) {
+	Accessor styler(pAccess, nullptr);
+	const Sci_Position lineEnd = styler.LineStart(line + 1);
+	const int state = stateForPrintState(static_cast<unsigned char>(styler.StyleAt(lineEnd - 1)));
+	// Lexing from inside a tag or a PHP string rereads earlier lines
+	if (InTagState(state) || isPHPStringState(state)) {
+		return nullptr;
+	}
+	// Everything else comes from the line state and style except for the fold level, which
+	// is read from the next line, and what precedes a JavaScript '/'
+	checkpointState = std::to_string(styler.LevelAt(line + 1) & SC_FOLDLEVELNUMBERMASK);
+	if (ScriptOfState(state) == eScriptJS) {
+		checkpointState.push_back(static_cast<char>(PrevNonWhiteJS(styler, lineEnd)));
+	}
+	*length = checkpointState.length();
+	return checkpointState.c_str();
+}
+
 void SCI_METHOD LexerHTML::Lex(Sci_PositionU startPos, Sci_Position length, int initStyle, IDocument *pAccess) {
 	Accessor styler(pAccess, nullptr);
 	if (isPHPScript && (startPos == 0)) {
@@ -1168,17 +1212,7 @@ void SCI_METHOD LexerHTML::Lex(Sci_PositionU startPos, Sci_Position length, int
 	int chPrevNonWhite = ' ';
 	// look back to set chPrevNonWhite properly for better regex colouring
 	if (scriptLanguage == eScriptJS && startPos > 0) {
-		Sci_Position back = startPos;
-		int style = 0;
-		while (--back) {
-			style = styler.StyleAt(back);
-			if (style < SCE_HJ_DEFAULT || style > SCE_HJ_COMMENTDOC)
-				// includes SCE_HJ_COMMENT & SCE_HJ_COMMENTLINE
-				break;
-		}
-		if (style == SCE_HJ_SYMBOLS) {
-			chPrevNonWhite = static_cast<unsigned char>(styler.SafeGetCharAt(back));
-		}
+		chPrevNonWhite = PrevNonWhiteJS(styler, startPos);
 	}
 
 	styler.StartSegment(startPos);
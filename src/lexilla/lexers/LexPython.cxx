@@ -345,7 +345,7 @@ LexicalClass lexicalClasses[] = {
 
 }
 
-class LexerPython : public DefaultLexer {
+class LexerPython : public DefaultLexer, public ILexerCheckpoint {
 	WordList keywords;
 	WordList keywords2;
 	OptionsPython options;
@@ -353,10 +353,14 @@ class LexerPython : public DefaultLexer {
 	enum { ssIdentifier };
 	SubStyles subStyles;
 	std::map<Sci_Position, std::vector<SingleFStringExpState> > ftripleStateAtEol;
+	// Set when f-string state for lines that have not been lexed again was thrown away
+	bool ftripleStateDiscarded;
+	std::string checkpointState;
 public:
 	explicit LexerPython() :
 		DefaultLexer("python", SCLEX_PYTHON, lexicalClasses, ELEMENTS(lexicalClasses)),
-		subStyles(styleSubable, 0x80, 0x40, 0) {
+		subStyles(styleSubable, 0x80, 0x40, 0),
+		ftripleStateDiscarded(false) {
 	}
 	~LexerPython() override {
 	}
@@ -386,9 +390,13 @@ public:
 	void SCI_METHOD Lex(Sci_PositionU startPos, Sci_Position length, int initStyle, IDocument *pAccess) override;
 	void SCI_METHOD Fold(Sci_PositionU startPos, Sci_Position length, int initStyle, IDocument *pAccess) override;
 
-	void *SCI_METHOD PrivateCall(int, void *) override {
+	void *SCI_METHOD PrivateCall(int operation, void *) override {
+		if (operation == lpcCheckpoint) {
+			return static_cast<ILexerCheckpoint *>(this);
+		}
 		return nullptr;
 	}
+	const char *SCI_METHOD CheckpointState(Sci_Position line, Sci_Position *length, IDocument *pAccess) override;
 
 	int SCI_METHOD LineEndTypesSupported() override {
 		return SC_LINE_END_TYPE_UNICODE;
@@ -504,6 +512,29 @@ void LexerPython::ProcessLineEnd(StyleContext &sc, std::vector<SingleFStringExpS
 	}
 }
 
+const char *SCI_METHOD LexerPython::CheckpointState(Sci_Position line, Sci_Position *length, IDocument *pAccess) {
+	// Styles after this line can not be reused when they depend on f-string state that is gone
+	if (ftripleStateDiscarded) {
+		return nullptr;
+	}
+	// Lexing from inside a continued string and folding from inside a triple quoted string
+	// reread earlier lines
+	const int eolStyle = pAccess->StyleAt(pAccess->LineStart(line + 1) - 1) & 31;
+	if (eolStyle == SCE_P_STRING || eolStyle == SCE_P_CHARACTER || eolStyle == SCE_P_STRINGEOL ||
+		IsPyTripleQuoteStringState(eolStyle)) {
+		return nullptr;
+	}
+	checkpointState.clear();
+	const auto it = ftripleStateAtEol.find(line);
+	if (it != ftripleStateAtEol.end()) {
+		for (const SingleFStringExpState &fstringState : it->second) {
+			checkpointState.append(reinterpret_cast<const char *>(&fstringState), sizeof(fstringState));
+		}
+	}
+	*length = checkpointState.length();
+	return checkpointState.c_str();
+}
+
 void SCI_METHOD LexerPython::Lex(Sci_PositionU startPos, Sci_Position length, int initStyle, IDocument *pAccess) {
 	Accessor styler(pAccess, nullptr);
 
@@ -552,8 +583,14 @@ void SCI_METHOD LexerPython::Lex(Sci_PositionU startPos, Sci_Position length, in
 	}
 	it = ftripleStateAtEol.lower_bound(lineCurrent);
 	if (it != ftripleStateAtEol.end()) {
+		if (ftripleStateAtEol.rbegin()->first > styler.GetLine(endPos - 1)) {
+			ftripleStateDiscarded = true;
+		}
 		ftripleStateAtEol.erase(it, ftripleStateAtEol.end());
 	}
+	if (endPos >= styler.Length()) {
+		ftripleStateDiscarded = false;
+	}
 
 	kwType kwLast = kwOther;
 	int spaceFlags = 0;
@@ -33,7 +33,7 @@ void LexAccessor::GetRange(Sci_PositionU startPos_, Sci_PositionU endPos_, char
 	endPos_ = std::min(endPos_, startPos_ + len - 1);
 	len = endPos_ - startPos_;
 	if (startPos_ >= static_cast<Sci_PositionU>(startPos) && endPos_ <= static_cast<Sci_PositionU>(endPos)) {
-		const char * const p = buf + (startPos_ - startPos);
+		const char * const p = text + (startPos_ - startPos);
 		memcpy(s, p, len);
 	} else {
 		pAccess->GetCharRange(s, startPos_, len);
@@ -15,13 +15,20 @@ enum class EncodingType { eightBit, unicode, dbcs };
 class LexAccessor {
 private:
 	Scintilla::IDocument *pAccess;
+	/// Set when the document lets its text be read in place.
+	const Scintilla::IDocumentSegments *pSegments;
 	enum {extremePosition=0x7FFFFFFF};
 	/** @a bufferSize is a trade off between time taken to copy the characters
 	 * and retrieval overhead.
 	 * @a slopSize positions the buffer before the desired position
-	 * in case there is some backtracking. */
-	enum {bufferSize=4000, slopSize=bufferSize/8};
-	char buf[bufferSize+1];
+	 * in case there is some backtracking.
+	 * When the text has to be copied, the size of each copy starts at @a bufferSize
+	 * and doubles up to @a maximumBufferSize while lexing moves forward. */
+	enum {bufferSize=4000, slopSize=bufferSize/8, maximumBufferSize=256*1024};
+	std::string buf;
+	/// Characters from startPos to endPos, either in buf or in a segment of the document.
+	const char *text;
+	Sci_Position fillSize;
 	Sci_Position startPos;
 	Sci_Position endPos;
 	int codePage;
@@ -34,31 +41,56 @@ private:
 	int documentVersion;
 
 	void Fill(Sci_Position position) {
-		startPos = position - slopSize;
-		if (startPos + bufferSize > lenDoc)
-			startPos = lenDoc - bufferSize;
+		if (pSegments) {
+			Sci_Position segmentStart = 0;
+			Sci_Position segmentEnd = 0;
+			const char *segment = pSegments->TextSegment(position, &segmentStart, &segmentEnd);
+			// Near where two segments meet, copy instead so that looking either side
+			// of the join does not switch between segments for each character.
+			if (segment &&
+				((segmentStart == 0) || (position - segmentStart >= slopSize)) &&
+				((segmentEnd == lenDoc) || (segmentEnd - position > slopSize))) {
+				text = segment;
+				startPos = segmentStart;
+				endPos = segmentEnd;
+				return;
+			}
+		}
+
+		if ((position >= endPos) && (startPos != extremePosition) && (fillSize < maximumBufferSize)) {
+			fillSize *= 2;
+		}
+		startPos = position - fillSize / 8;
+		if (startPos + fillSize > lenDoc)
+			startPos = lenDoc - fillSize;
 		if (startPos < 0)
 			startPos = 0;
-		endPos = startPos + bufferSize;
+		endPos = startPos + fillSize;
 		if (endPos > lenDoc)
 			endPos = lenDoc;
 
-		pAccess->GetCharRange(buf, startPos, endPos-startPos);
+		if (buf.size() <= static_cast<size_t>(endPos - startPos))
+			buf.resize(endPos - startPos + 1);
+		pAccess->GetCharRange(buf.data(), startPos, endPos-startPos);
 		buf[endPos-startPos] = '\0';
+		text = buf.data();
 	}
 
 public:
 	explicit LexAccessor(Scintilla::IDocument *pAccess_) :
-		pAccess(pAccess_), startPos(extremePosition), endPos(0),
+		pAccess(pAccess_), pSegments(nullptr), text(nullptr), fillSize(bufferSize),
+		startPos(extremePosition), endPos(0),
 		codePage(pAccess->CodePage()),
 		encodingType(EncodingType::eightBit),
 		lenDoc(pAccess->Length()),
 		validLen(0),
 		startSeg(0), startPosStyling(0),
 		documentVersion(pAccess->Version()) {
-		// Prevent warnings by static analyzers about uninitialized buf and styleBuf.
-		buf[0] = 0;
+		// Prevent warnings by static analyzers about uninitialized styleBuf.
 		styleBuf[0] = 0;
+		if (documentVersion >= Scintilla::dvRelease5) {
+			pSegments = static_cast<const Scintilla::IDocumentSegments *>(pAccess);
+		}
 		switch (codePage) {
 		case 65001:
 			encodingType = EncodingType::unicode;
@@ -75,7 +107,7 @@ public:
 		if (position < startPos || position >= endPos) {
 			Fill(position);
 		}
-		return buf[position - startPos];
+		return text[position - startPos];
 	}
 	Scintilla::IDocument *MultiByteAccess() const noexcept {
 		return pAccess;
@@ -89,7 +121,7 @@ public:
 				return chDefault;
 			}
 		}
-		return buf[position - startPos];
+		return text[position - startPos];
 	}
 	bool IsLeadByte(char ch) const {
 		return
@@ -67,10 +67,21 @@ bool cmpWords(const char *a, const char *b) noexcept {
 	return strcmp(a, b) < 0;
 }
 
+// FNV-1a
+unsigned int HashWord(const char *s) noexcept {
+	unsigned int hash = 2166136261U;
+	for (; *s; s++) {
+		hash ^= static_cast<unsigned char>(*s);
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
 }
 
 WordList::WordList(bool onlyLineEnds_) noexcept :
-	words(nullptr), list(nullptr), len(0), onlyLineEnds(onlyLineEnds_) {
+	words(nullptr), list(nullptr), len(0), onlyLineEnds(onlyLineEnds_),
+	hashTable(nullptr), hashMask(0) {
 	// Prevent warnings by static analyzers about uninitialized starts.
 	starts[0] = -1;
 }
@@ -102,6 +113,9 @@ void WordList::Clear() noexcept {
 	list = nullptr;
 	delete []words;
 	words = nullptr;
+	delete []hashTable;
+	hashTable = nullptr;
+	hashMask = 0;
 	len = 0;
 }
 
@@ -126,10 +140,28 @@ bool WordList::Set(const char *s) {
 		}
 	}
 
+	// Keep the table at most half full so probing stays short
+	size_t hashSize = 16;
+	while (hashSize < lenTemp * 2) {
+		hashSize *= 2;
+	}
+	std::unique_ptr<int[]> hashTemp = std::make_unique<int[]>(hashSize);
+	std::fill(hashTemp.get(), hashTemp.get() + hashSize, -1);
+	const unsigned int mask = static_cast<unsigned int>(hashSize - 1);
+	for (size_t i = 0; i < lenTemp; i++) {
+		unsigned int slot = HashWord(wordsTemp[i]) & mask;
+		while (hashTemp[slot] >= 0) {
+			slot = (slot + 1) & mask;
+		}
+		hashTemp[slot] = static_cast<int>(i);
+	}
+
 	Clear();
 	words = wordsTemp.release();
 	list = listTemp.release();
 	len = lenTemp;
+	hashTable = hashTemp.release();
+	hashMask = mask;
 	std::fill(starts, std::end(starts), -1);
 	for (int l = static_cast<int>(len - 1); l >= 0; l--) {
 		unsigned char indexChar = words[l][0];
@@ -146,24 +178,12 @@ bool WordList::Set(const char *s) {
 bool WordList::InList(const char *s) const noexcept {
 	if (!words)
 		return false;
-	const unsigned char firstChar = s[0];
-	int j = starts[firstChar];
-	if (j >= 0) {
-		while (words[j][0] == firstChar) {
-			if (s[1] == words[j][1]) {
-				const char *a = words[j] + 1;
-				const char *b = s + 1;
-				while (*a && *a == *b) {
-					a++;
-					b++;
-				}
-				if (!*a && !*b)
-					return true;
-			}
-			j++;
-		}
+	for (unsigned int slot = HashWord(s) & hashMask; hashTable[slot] >= 0; slot = (slot + 1) & hashMask) {
+		const char *word = words[hashTable[slot]];
+		if ((word[0] == s[0]) && (strcmp(word, s) == 0))
+			return true;
 	}
-	j = starts[static_cast<unsigned int>('^')];
+	int j = starts[static_cast<unsigned int>('^')];
 	if (j >= 0) {
 		while (words[j][0] == '^') {
 			const char *a = words[j] + 1;
@@ -19,6 +19,10 @@ class WordList {
 	size_t len;
 	bool onlyLineEnds;	///< Delimited by any white space or only line ends
 	int starts[256];
+	/// Open addressed hash table of indices into words with -1 for empty slots so that
+	/// InList does not compare against every word with the same first character.
+	int *hashTable;
+	unsigned int hashMask;
 public:
 	explicit WordList(bool onlyLineEnds_ = false) noexcept;
 	// Deleted so WordList objects can not be copied.
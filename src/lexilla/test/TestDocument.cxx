@@ -80,7 +80,7 @@ void TestDocument::Set(std::string_view sv) {
 #endif
 
 int SCI_METHOD TestDocument::Version() const {
-	return Scintilla::dvRelease4;
+	return Scintilla::dvRelease5;
 }
 
 void SCI_METHOD TestDocument::SetErrorStatus(int) {
@@ -260,3 +260,20 @@ int SCI_METHOD TestDocument::GetCharacterAndWidth(Sci_Position position, Sci_Pos
 	}
 	return UnicodeFromUTF8(charBytes);
 }
+
+const char *SCI_METHOD TestDocument::TextSegment(Sci_Position position, Sci_Position *segmentStart, Sci_Position *segmentEnd) const {
+	if (position < 0 || position >= Length()) {
+		return nullptr;
+	}
+	// Present the text as two segments, like the two sides of the gap in Scintilla's
+	// buffer, so lexers are tested reading across where segments meet.
+	const Sci_Position middle = Length() / 2;
+	if (position < middle) {
+		*segmentStart = 0;
+		*segmentEnd = middle;
+	} else {
+		*segmentStart = middle;
+		*segmentEnd = Length();
+	}
+	return text.data() + *segmentStart;
+}
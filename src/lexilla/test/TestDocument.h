@@ -8,7 +8,7 @@
 #ifndef TESTDOCUMENT_H
 #define TESTDOCUMENT_H
 
-class TestDocument : public Scintilla::IDocument {
+class TestDocument : public Scintilla::IDocumentSegments {
 	std::string text;
 	std::string textStyles;
 	std::vector<Sci_Position> lineStarts;
@@ -49,6 +49,7 @@ public:
 	Sci_Position SCI_METHOD LineEnd(Sci_Position line) const override;
 	Sci_Position SCI_METHOD GetRelativePosition(Sci_Position positionStart, Sci_Position characterOffset) const override;
 	int SCI_METHOD GetCharacterAndWidth(Sci_Position position, Sci_Position *pWidth) const override;
+	const char *SCI_METHOD TextSegment(Sci_Position position, Sci_Position *segmentStart, Sci_Position *segmentEnd) const override;
 };
 
 #endif
@@ -6,6 +6,8 @@
  // The License.txt file describes the conditions under which this software may be distributed.
 
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
 
 #include <string>
 #include <string_view>
@@ -19,6 +21,8 @@
 #include <fstream>
 #include <iomanip>
 #include <filesystem>
+#include <chrono>
+#include <new>
 
 #include "ILexer.h"
 
@@ -29,6 +33,105 @@
 
 namespace {
 
+// Counted to report the allocations made by each lexer when benchmarking.
+// Only allocations that reach the replacement operator new below are counted. A Lexilla DLL on
+// Windows has its own operator new so there the count is only valid for a static build made
+// with LEXILLA_STATIC. On Linux the shared library's allocations also come here.
+size_t allocations = 0;
+
+void *Allocate(size_t size, size_t alignment) {
+	allocations++;
+	if (size == 0) {
+		size = 1;
+	}
+	void *p = nullptr;
+	if (alignment <= alignof(std::max_align_t)) {
+		p = std::malloc(size);
+	} else {
+#ifdef _WIN32
+		p = _aligned_malloc(size, alignment);
+#else
+		// aligned_alloc needs the size to be a multiple of the alignment
+		p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	}
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+// Not inlined as GCC would then see the memory from operator new being given to free and warn
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void Free(void *p, size_t alignment) noexcept {
+#ifdef _WIN32
+	if (alignment > alignof(std::max_align_t)) {
+		_aligned_free(p);
+		return;
+	}
+#else
+	(void)alignment;
+#endif
+	std::free(p);
+}
+
+}
+
+// Every form of operator new and delete that allocates is replaced so that each delete matches
+// the new that made the allocation.
+
+void *operator new(size_t size) {
+	return Allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](size_t size) {
+	return Allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+	return Allocate(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+	return Allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *p) noexcept {
+	Free(p, alignof(std::max_align_t));
+}
+
+void operator delete[](void *p) noexcept {
+	Free(p, alignof(std::max_align_t));
+}
+
+void operator delete(void *p, size_t) noexcept {
+	Free(p, alignof(std::max_align_t));
+}
+
+void operator delete[](void *p, size_t) noexcept {
+	Free(p, alignof(std::max_align_t));
+}
+
+void operator delete(void *p, std::align_val_t alignment) noexcept {
+	Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void *p, std::align_val_t alignment) noexcept {
+	Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *p, size_t, std::align_val_t alignment) noexcept {
+	Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void *p, size_t, std::align_val_t alignment) noexcept {
+	Free(p, static_cast<size_t>(alignment));
+}
+
+namespace {
+
 constexpr std::string_view suffixStyled = ".styled";
 constexpr std::string_view suffixFolded = ".folded";
 
@@ -462,15 +565,19 @@ bool TestFile(const std::filesystem::path &path, const PropertyMap &propertyMap)
 	return success;
 }
 
+bool IsExampleFile(const std::filesystem::path &path) {
+	const std::string extension = path.extension().string();
+	return extension != ".properties" && extension != suffixStyled && extension != ".new" &&
+		extension != suffixFolded;
+}
+
 bool TestDirectory(std::filesystem::path directory, std::filesystem::path basePath) {
 	PropertyMap properties;
 	properties.ReadFromFile(directory / "SciTE.properties");
 	bool success = true;
 	for (auto &p : std::filesystem::directory_iterator(directory)) {
 		if (!p.is_directory()) {
-			const std::string extension = p.path().extension().string();
-			if (extension != ".properties" && extension != suffixStyled && extension != ".new" &&
-				extension != suffixFolded) {
+			if (IsExampleFile(p.path())) {
 				const std::filesystem::path relativePath = p.path().lexically_relative(basePath);
 				std::cout << "Lexing " << relativePath.string() << '\n';
 				if (!TestFile(p, properties)) {
@@ -500,6 +607,239 @@ bool AccessLexilla(std::filesystem::path basePath) {
 	return success;
 }
 
+struct BenchmarkOptions {
+	size_t size = 1024 * 1024;	// Examples are repeated to at least this many bytes
+	int repeat = 5;	// Best time of this many runs is reported
+	std::string filter;	// Only benchmark examples with paths containing this
+	std::filesystem::path output;	// Also write results here
+	std::filesystem::path baseline;	// Earlier results to check for regressions against
+	double threshold = 10.0;	// Percentage slowdown from baseline seen as a regression
+};
+
+struct BenchmarkResult {
+	std::string file;
+	std::string lexer;
+	size_t bytes = 0;
+	Sci_Position lines = 0;
+	double lexSeconds = 0.0;
+	double foldSeconds = 0.0;
+	size_t allocations = 0;
+
+	static double PerSecond(double amount, double seconds) noexcept {
+		return (seconds > 0.0) ? amount / seconds : 0.0;
+	}
+	double LexMBPerSecond() const noexcept {
+		return PerSecond(bytes / 1.0e6, lexSeconds);
+	}
+	double FoldMBPerSecond() const noexcept {
+		return PerSecond(bytes / 1.0e6, foldSeconds);
+	}
+	double LinesPerSecond() const noexcept {
+		return PerSecond(static_cast<double>(lines), lexSeconds + foldSeconds);
+	}
+};
+
+constexpr std::string_view benchmarkHeader = "file\tlexer\tbytes\tlines\tlexMBps\tfoldMBps\tlinesPerSecond\tallocations";
+
+std::string BenchmarkLine(const BenchmarkResult &result) {
+	std::ostringstream os;
+	os << std::fixed << std::setprecision(2);
+	os << result.file << '\t' << result.lexer << '\t' << result.bytes << '\t' << result.lines << '\t' <<
+		result.LexMBPerSecond() << '\t' << result.FoldMBPerSecond() << '\t' <<
+		std::setprecision(0) << result.LinesPerSecond() << '\t' << result.allocations;
+	return os.str();
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+	const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+	return duration.count();
+}
+
+std::optional<BenchmarkResult> BenchmarkFile(const std::filesystem::path &path, const std::string &relativePath,
+	const PropertyMap &propertyMap, const BenchmarkOptions &options) {
+	std::optional<std::string> language = propertyMap.GetPropertyForFile(lexerPrefix, path.filename().string());
+	if (!language) {
+		return {};
+	}
+	Scintilla::ILexer5 *plex = Lexilla::MakeLexer(*language);
+	if (!plex) {
+		return {};
+	}
+	SetProperties(plex, propertyMap, path.filename().string());
+
+	std::string example = ReadFile(path);
+	if (example.starts_with(BOM)) {
+		example.erase(0, BOM.length());
+	}
+	if (example.empty()) {
+		plex->Release();
+		return {};
+	}
+	if (!example.ends_with("\n")) {
+		example.push_back('\n');
+	}
+	std::string text;
+	while (text.length() < options.size) {
+		text += example;
+	}
+
+	BenchmarkResult result;
+	result.file = relativePath;
+	result.lexer = *language;
+	result.bytes = text.length();
+
+	TestDocument doc;
+	Scintilla::IDocument *pdoc = &doc;
+	for (int i = 0; i < options.repeat; i++) {
+		doc.Set(text);
+		const size_t allocationsBefore = allocations;
+		const std::chrono::steady_clock::time_point startLex = std::chrono::steady_clock::now();
+		plex->Lex(0, pdoc->Length(), 0, pdoc);
+		const double lexSeconds = SecondsSince(startLex);
+		const std::chrono::steady_clock::time_point startFold = std::chrono::steady_clock::now();
+		plex->Fold(0, pdoc->Length(), 0, pdoc);
+		const double foldSeconds = SecondsSince(startFold);
+		if (i == 0) {
+			result.allocations = allocations - allocationsBefore;
+			result.lexSeconds = lexSeconds;
+			result.foldSeconds = foldSeconds;
+		} else {
+			result.lexSeconds = std::min(result.lexSeconds, lexSeconds);
+			result.foldSeconds = std::min(result.foldSeconds, foldSeconds);
+		}
+	}
+	result.lines = pdoc->LineFromPosition(pdoc->Length()) + 1;
+
+	plex->Release();
+	return result;
+}
+
+// Lexing and folding rates in MB/s for each file in earlier results.
+std::map<std::string, std::pair<double, double>> ReadBenchmark(const std::filesystem::path &path) {
+	std::map<std::string, std::pair<double, double>> rates;
+	std::ifstream ifs(path);
+	std::string line;
+	while (std::getline(ifs, line)) {
+		std::vector<std::string> fields;
+		std::istringstream iss(line);
+		std::string field;
+		while (std::getline(iss, field, '\t')) {
+			fields.push_back(field);
+		}
+		if (fields.size() < 6 || fields[0] == "file") {
+			continue;
+		}
+		try {
+			rates[fields[0]] = { std::stod(fields[4]), std::stod(fields[5]) };
+		} catch (std::exception &) {
+			// Skip lines that are not results
+		}
+	}
+	return rates;
+}
+
+bool CheckRegression(std::string_view file, std::string_view what, size_t bytes, double rate, double rateBaseline, double threshold) {
+	// Work that took less than a millisecond can not be timed reliably enough to compare
+	if ((rateBaseline <= 0.0) || (bytes / 1.0e6 / rateBaseline < 0.001)) {
+		return true;
+	}
+	if (rate < rateBaseline * (1.0 - threshold / 100.0)) {
+		std::cout << file << ": " << what << " fell from " << std::fixed << std::setprecision(2) <<
+			rateBaseline << " to " << rate << " MB/s\n";
+		return false;
+	}
+	return true;
+}
+
+bool BenchmarkLexilla(std::filesystem::path basePath, const BenchmarkOptions &options) {
+	if (!std::filesystem::exists(basePath)) {
+		std::cout << "No examples at " << basePath.string() << "\n";
+		return false;
+	}
+
+	std::vector<BenchmarkResult> results;
+	std::cout << benchmarkHeader << '\n';
+	for (auto &d : std::filesystem::recursive_directory_iterator(basePath)) {
+		if (!d.is_directory()) {
+			continue;
+		}
+		PropertyMap properties;
+		properties.ReadFromFile(d.path() / "SciTE.properties");
+		for (auto &p : std::filesystem::directory_iterator(d.path())) {
+			const std::string relativePath = p.path().lexically_relative(basePath).generic_string();
+			if (!p.is_directory() && IsExampleFile(p.path()) &&
+				(relativePath.find(options.filter) != std::string::npos)) {
+				std::optional<BenchmarkResult> result = BenchmarkFile(p.path(), relativePath, properties, options);
+				if (result) {
+					std::cout << BenchmarkLine(*result) << std::endl;
+					results.push_back(*result);
+				}
+			}
+		}
+	}
+
+	if (!options.output.empty()) {
+		std::ofstream ofs(options.output);
+		ofs << benchmarkHeader << '\n';
+		for (const BenchmarkResult &result : results) {
+			ofs << BenchmarkLine(result) << '\n';
+		}
+	}
+
+	bool success = true;
+	if (!options.baseline.empty()) {
+		const std::map<std::string, std::pair<double, double>> baseline = ReadBenchmark(options.baseline);
+		for (const BenchmarkResult &result : results) {
+			const auto it = baseline.find(result.file);
+			if (it != baseline.end()) {
+				success = CheckRegression(result.file, "lexing", result.bytes, result.LexMBPerSecond(),
+					it->second.first, options.threshold) && success;
+				success = CheckRegression(result.file, "folding", result.bytes, result.FoldMBPerSecond(),
+					it->second.second, options.threshold) && success;
+			}
+		}
+	}
+	return success;
+}
+
+std::optional<BenchmarkOptions> BenchmarkArguments(int argc, char *argv[]) {
+	std::optional<BenchmarkOptions> options;
+	std::vector<std::string_view> arguments;
+	for (int i = 1; i < argc; i++) {
+		if (std::string_view(argv[i]) == "--benchmark") {
+			options.emplace();
+		} else {
+			arguments.push_back(argv[i]);
+		}
+	}
+	if (!options) {
+		return options;
+	}
+	for (const std::string_view argument : arguments) {
+		const size_t positionEquals = argument.find('=');
+		const std::string_view name = argument.substr(0, positionEquals);
+		const std::string value(positionEquals == std::string_view::npos ? "" : argument.substr(positionEquals + 1));
+		try {
+			if (name == "--size") {
+				options->size = std::stoul(value) * 1024;
+			} else if (name == "--repeat") {
+				options->repeat = std::max(std::stoi(value), 1);
+			} else if (name == "--output") {
+				options->output = value;
+			} else if (name == "--baseline") {
+				options->baseline = value;
+			} else if (name == "--threshold") {
+				options->threshold = std::stod(value);
+			} else {
+				options->filter = argument;
+			}
+		} catch (std::exception &) {
+			std::cout << "Bad value for " << name << "\n";
+		}
+	}
+	return options;
+}
+
 std::filesystem::path FindLexillaDirectory(std::filesystem::path startDirectory) {
 	// Search up from startDirectory for a directory named "lexilla" or containing a "bin" subdirectory
 	std::filesystem::path directory = startDirectory;
@@ -531,18 +871,25 @@ std::filesystem::path FindLexillaDirectory(std::filesystem::path startDirectory)
 
 
 
-int main() {
+int main(int argc, char *argv[]) {
 	bool success = false;
+	// With --benchmark, time lexing and folding of enlarged examples instead of checking results.
+	// Options are --size=KB, --repeat=N, --output=file, --baseline=file, --threshold=percent
+	// and any other argument limits the examples to those with paths containing it.
+	const std::optional<BenchmarkOptions> benchmark = BenchmarkArguments(argc, argv);
 	// TODO: Allow specifying the base directory through a command line argument
 	const std::filesystem::path baseDirectory = FindLexillaDirectory(std::filesystem::current_path());
 	if (!baseDirectory.empty()) {
 		const std::filesystem::path examplesDirectory = baseDirectory / "test" / "examples";
+		auto run = [&]() {
+			return benchmark ? BenchmarkLexilla(examplesDirectory, *benchmark) : AccessLexilla(examplesDirectory);
+		};
 #ifdef LEXILLA_STATIC
-		success = AccessLexilla(examplesDirectory);
+		success = run();
 #else
 		const std::filesystem::path sharedLibrary = baseDirectory / "bin" / LEXILLA_LIB;
 		if (Lexilla::Load(sharedLibrary.string())) {
-			success = AccessLexilla(examplesDirectory);
+			success = run();
 		} else {
 			std::cout << "Failed to load " << sharedLibrary << "\n";
 		}
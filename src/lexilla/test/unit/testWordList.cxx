@@ -4,6 +4,8 @@
 
 #include <string.h>
 
+#include <string>
+
 #include "WordList.h"
 
 #include "catch.hpp"
@@ -28,6 +30,27 @@ TEST_CASE("WordList") {
 		REQUIRE(!wl.InList("class"));
 	}
 
+	SECTION("InListMany") {
+		// Enough words for collisions in the hash table along with duplicates and prefixes
+		std::string words = "^GTK_ struct struct ";
+		for (int i = 0; i < 1000; i++) {
+			words += "w" + std::to_string(i * 7) + " ";
+		}
+		wl.Set(words.c_str());
+		REQUIRE(1003 == wl.Length());
+		for (int i = 0; i < 7000; i++) {
+			const std::string word = "w" + std::to_string(i);
+			REQUIRE(wl.InList(word.c_str()) == (i % 7 == 0));
+		}
+		REQUIRE(wl.InList("struct"));
+		REQUIRE(!wl.InList("struc"));
+		REQUIRE(!wl.InList("structs"));
+		REQUIRE(!wl.InList(""));
+		REQUIRE(wl.InList("GTK_MAJOR_VERSION"));
+		REQUIRE(wl.InList("^GTK_"));
+		REQUIRE(!wl.InList("GTK"));
+	}
+
 	SECTION("Set") {
 		// Check whether Set returns whether it has changed correctly
 		const bool changed = wl.Set("else struct");
@@ -22,6 +22,7 @@ SOURCES += \
     $$PWD/scintilla/qt/ScintillaEditBase/PlatQt.cpp \
     $$PWD/scintilla/qt/ScintillaEditBase/ScintillaQt.cpp \
     $$PWD/scintilla/qt/ScintillaEditBase/ScintillaEditBase.cpp \
+    $$PWD/scintilla/qt/ScintillaEditBase/IdleScheduler.cpp \
     $$PWD/scintilla/src/XPM.cxx \
     $$PWD/scintilla/src/ViewStyle.cxx \
     $$PWD/scintilla/src/UniqueString.cxx \
@@ -58,7 +59,8 @@ HEADERS  += \
     $$PWD/scintilla/qt/ScintillaEdit/ScintillaEdit.h \
     $$PWD/scintilla/qt/ScintillaEdit/ScintillaDocument.h \
     $$PWD/scintilla/qt/ScintillaEditBase/ScintillaEditBase.h \
-    $$PWD/scintilla/qt/ScintillaEditBase/ScintillaQt.h
+    $$PWD/scintilla/qt/ScintillaEditBase/ScintillaQt.h \
+    $$PWD/scintilla/qt/ScintillaEditBase/IdleScheduler.h
 
 INCLUDEPATH += \
     $$PWD/scintilla/qt/ScintillaEditBase/ \
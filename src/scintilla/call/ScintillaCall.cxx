@@ -212,6 +212,10 @@ Position ScintillaCall::GetStyledText(void *tr) {
 	return CallPointer(Message::GetStyledText, 0, tr);
 }
 
+Position ScintillaCall::GetStyledTextFull(void *tr) {
+	return CallPointer(Message::GetStyledTextFull, 0, tr);
+}
+
 bool ScintillaCall::CanRedo() {
 	return Call(Message::CanRedo);
 }
@@ -724,6 +728,10 @@ void ScintillaCall::SetStylingEx(Position length, const char *styles) {
 	CallString(Message::SetStylingEx, length, styles);
 }
 
+bool ScintillaCall::SetStylingCheckpoint(Position length, const char *state) {
+	return CallString(Message::SetStylingCheckpoint, length, state);
+}
+
 void ScintillaCall::StyleSetVisible(int style, bool visible) {
 	Call(Message::StyleSetVisible, style, visible);
 }
@@ -1124,6 +1132,10 @@ Position ScintillaCall::FindText(Scintilla::FindOption searchFlags, void *ft) {
 	return CallPointer(Message::FindText, static_cast<uintptr_t>(searchFlags), ft);
 }
 
+Position ScintillaCall::FindTextFull(Scintilla::FindOption searchFlags, void *ft) {
+	return CallPointer(Message::FindTextFull, static_cast<uintptr_t>(searchFlags), ft);
+}
+
 Position ScintillaCall::FormatRange(bool draw, void *fr) {
 	return CallPointer(Message::FormatRange, draw, fr);
 }
@@ -1184,6 +1196,10 @@ Position ScintillaCall::GetTextRange(void *tr) {
 	return CallPointer(Message::GetTextRange, 0, tr);
 }
 
+Position ScintillaCall::GetTextRangeFull(void *tr) {
+	return CallPointer(Message::GetTextRangeFull, 0, tr);
+}
+
 void ScintillaCall::HideSelection(bool hide) {
 	Call(Message::HideSelection, hide);
 }
@@ -1240,6 +1256,62 @@ void ScintillaCall::EmptyUndoBuffer() {
 	Call(Message::EmptyUndoBuffer);
 }
 
+void ScintillaCall::SetUndoMemoryLimit(Position bytes) {
+	Call(Message::SetUndoMemoryLimit, bytes);
+}
+
+Position ScintillaCall::UndoMemoryLimit() {
+	return Call(Message::GetUndoMemoryLimit);
+}
+
+Position ScintillaCall::UndoMemory() {
+	return Call(Message::GetUndoMemory);
+}
+
+int ScintillaCall::UndoActions() {
+	return static_cast<int>(Call(Message::GetUndoActions));
+}
+
+void ScintillaCall::SetUndoSavePoint(int action) {
+	Call(Message::SetUndoSavePoint, action);
+}
+
+int ScintillaCall::UndoSavePoint() {
+	return static_cast<int>(Call(Message::GetUndoSavePoint));
+}
+
+void ScintillaCall::SetUndoCurrent(int action) {
+	Call(Message::SetUndoCurrent, action);
+}
+
+int ScintillaCall::UndoCurrent() {
+	return static_cast<int>(Call(Message::GetUndoCurrent));
+}
+
+void ScintillaCall::PushUndoActionType(int type, Position pos) {
+	Call(Message::PushUndoActionType, type, pos);
+}
+
+void ScintillaCall::ChangeLastUndoActionText(Position length, const char *text) {
+	CallString(Message::ChangeLastUndoActionText, length, text);
+}
+
+int ScintillaCall::UndoActionType(int action) {
+	return static_cast<int>(Call(Message::GetUndoActionType, action));
+}
+
+Position ScintillaCall::UndoActionPosition(int action) {
+	return Call(Message::GetUndoActionPosition, action);
+}
+
+int ScintillaCall::UndoActionText(int action, char *text) {
+	return static_cast<int>(CallPointer(Message::GetUndoActionText, action, text));
+}
+
+std::string ScintillaCall::UndoActionText(int action) {
+	return CallReturnString(Message::GetUndoActionText, action);
+}
+
 void ScintillaCall::Undo() {
 	Call(Message::Undo);
 }
@@ -1580,6 +1652,10 @@ IdleStyling ScintillaCall::IdleStyling() {
 	return static_cast<Scintilla::IdleStyling>(Call(Message::GetIdleStyling));
 }
 
+IdleTask ScintillaCall::IdleTasks() {
+	return static_cast<Scintilla::IdleTask>(Call(Message::GetIdleTasks));
+}
+
 void ScintillaCall::SetWrapMode(Scintilla::Wrap wrapMode) {
 	Call(Message::SetWrapMode, static_cast<uintptr_t>(wrapMode));
 }
@@ -1628,6 +1704,30 @@ LineCache ScintillaCall::LayoutCache() {
 	return static_cast<Scintilla::LineCache>(Call(Message::GetLayoutCache));
 }
 
+void ScintillaCall::SetLayoutCacheBudget(Position bytes) {
+	Call(Message::SetLayoutCacheBudget, bytes);
+}
+
+Position ScintillaCall::LayoutCacheBudget() {
+	return Call(Message::GetLayoutCacheBudget);
+}
+
+void ScintillaCall::SetLinePixmapCacheBudget(Position bytes) {
+	Call(Message::SetLinePixmapCacheBudget, bytes);
+}
+
+Position ScintillaCall::LinePixmapCacheBudget() {
+	return Call(Message::GetLinePixmapCacheBudget);
+}
+
+Position ScintillaCall::LayoutCacheStatistic(Scintilla::LayoutCacheStatistic statistic) {
+	return Call(Message::GetLayoutCacheStatistic, static_cast<uintptr_t>(statistic));
+}
+
+void ScintillaCall::ResetLayoutCacheStatistics() {
+	Call(Message::ResetLayoutCacheStatistics);
+}
+
 void ScintillaCall::SetScrollWidth(int pixelWidth) {
 	Call(Message::SetScrollWidth, pixelWidth);
 }
@@ -2544,6 +2644,14 @@ void ScintillaCall::IndicatorClearRange(Position start, Position lengthClear) {
 	Call(Message::IndicatorClearRange, start, lengthClear);
 }
 
+void ScintillaCall::IndicatorFillRanges(Position rangeCount, void *ranges) {
+	CallPointer(Message::IndicatorFillRanges, rangeCount, ranges);
+}
+
+void ScintillaCall::IndicatorReplaceRanges(Position rangeCount, void *ranges) {
+	CallPointer(Message::IndicatorReplaceRanges, rangeCount, ranges);
+}
+
 int ScintillaCall::IndicatorAllOnFor(Position pos) {
 	return static_cast<int>(Call(Message::IndicatorAllOnFor, pos));
 }
@@ -2552,6 +2660,10 @@ int ScintillaCall::IndicatorValueAt(int indicator, Position pos) {
 	return static_cast<int>(Call(Message::IndicatorValueAt, indicator, pos));
 }
 
+Position ScintillaCall::IndicatorRuns(int indicator) {
+	return Call(Message::GetIndicatorRuns, indicator);
+}
+
 Position ScintillaCall::IndicatorStart(int indicator, Position pos) {
 	return Call(Message::IndicatorStart, indicator, pos);
 }
@@ -2568,6 +2680,14 @@ int ScintillaCall::PositionCache() {
 	return static_cast<int>(Call(Message::GetPositionCache));
 }
 
+Position ScintillaCall::PositionCacheStatistic(Scintilla::LayoutCacheStatistic statistic) {
+	return Call(Message::GetPositionCacheStatistic, static_cast<uintptr_t>(statistic));
+}
+
+void ScintillaCall::ResetPositionCacheStatistics() {
+	Call(Message::ResetPositionCacheStatistics);
+}
+
 void ScintillaCall::SetLayoutThreads(int threads) {
 	Call(Message::SetLayoutThreads, threads);
 }
@@ -2592,6 +2712,14 @@ Position ScintillaCall::GapPosition() {
 	return Call(Message::GetGapPosition);
 }
 
+void *ScintillaCall::TextSegment(Position pos, void *length) {
+	return reinterpret_cast<void *>(CallPointer(Message::GetTextSegment, pos, length));
+}
+
+Position ScintillaCall::ModificationCount() {
+	return Call(Message::GetModificationCount);
+}
+
 void ScintillaCall::IndicSetAlpha(int indicator, Scintilla::Alpha alpha) {
 	Call(Message::IndicSetAlpha, indicator, static_cast<intptr_t>(alpha));
 }
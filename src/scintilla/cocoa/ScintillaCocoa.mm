@@ -791,6 +791,9 @@ void ScintillaCocoa::DiscardOverdraw() {
  * Ensure all of prepared content is also redrawn.
  */
 void ScintillaCocoa::Redraw() {
+	if (!willRedrawAll) {
+		view.InvalidateLinePixmaps();
+	}
 	wMargin.InvalidateAll();
 	DiscardOverdraw();
 	wMain.InvalidateAll();
@@ -137,6 +137,7 @@ CellBuffer.o: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PieceTable.h \
 	../src/CellBuffer.h \
 	../src/UniConversion.h
 CharacterCategoryMap.o: \
@@ -12,7 +12,7 @@
 
 namespace Scintilla {
 
-enum { dvRelease4=2 };
+enum { dvRelease4=2, dvRelease5=3 };
 
 class IDocument {
 public:
@@ -42,6 +42,16 @@ public:
 	virtual int SCI_METHOD GetCharacterAndWidth(Sci_Position position, Sci_Position *pWidth) const = 0;
 };
 
+// Documents with a Version of dvRelease5 or later also implement IDocumentSegments.
+class IDocumentSegments : public IDocument {
+public:
+	// Returns a pointer to the run of text that contains position and is stored contiguously by
+	// the document, setting *segmentStart and *segmentEnd to its range, or nullptr when position
+	// is outside the document. The pointer is to the character at *segmentStart and is only
+	// valid until the text is changed.
+	virtual const char * SCI_METHOD TextSegment(Sci_Position position, Sci_Position *segmentStart, Sci_Position *segmentEnd) const = 0;
+};
+
 enum { lvRelease4=2, lvRelease5=3 };
 
 class ILexer4 {
@@ -80,6 +90,20 @@ public:
 	virtual const char * SCI_METHOD PropertyGet(const char *key) = 0;
 };
 
+// PrivateCall operation used by Scintilla to ask a lexer for its ILexerCheckpoint.
+// Lexers that do not support checkpoints return nullptr as for any unknown operation.
+enum { lpcCheckpoint = 0x4C435031 };
+
+class ILexerCheckpoint {
+public:
+	// Called after lexing and folding to the end of line. Returns any state the lexer holds
+	// outside the document that affects later lines, setting *length, or nullptr when lexing
+	// could not restart after line from that state along with the line's line state, end
+	// style and fold level. The returned memory is owned by the lexer and only valid until
+	// the next call.
+	virtual const char * SCI_METHOD CheckpointState(Sci_Position line, Sci_Position *length, IDocument *pAccess) = 0;
+};
+
 }
 
 #endif
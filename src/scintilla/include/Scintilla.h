@@ -62,6 +62,7 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_SELECTALL 2013
 #define SCI_SETSAVEPOINT 2014
 #define SCI_GETSTYLEDTEXT 2015
+#define SCI_GETSTYLEDTEXTFULL 2778
 #define SCI_CANREDO 2016
 #define SCI_MARKERLINEFROMHANDLE 2017
 #define SCI_MARKERDELETEHANDLE 2018
@@ -321,6 +322,7 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_CLEARCMDKEY 2071
 #define SCI_CLEARALLCMDKEYS 2072
 #define SCI_SETSTYLINGEX 2073
+#define SCI_SETSTYLINGCHECKPOINT 7016
 #define SCI_STYLESETVISIBLE 2074
 #define SCI_GETCARETPERIOD 2075
 #define SCI_SETCARETPERIOD 2076
@@ -473,6 +475,7 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCFIND_POSIX 0x00400000
 #define SCFIND_CXX11REGEX 0x00800000
 #define SCI_FINDTEXT 2150
+#define SCI_FINDTEXTFULL 2196
 #define SCI_FORMATRANGE 2151
 #define SCI_GETFIRSTVISIBLELINE 2152
 #define SCI_GETLINE 2153
@@ -486,6 +489,7 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_SETSEL 2160
 #define SCI_GETSELTEXT 2161
 #define SCI_GETTEXTRANGE 2162
+#define SCI_GETTEXTRANGEFULL 2039
 #define SCI_HIDESELECTION 2163
 #define SCI_POINTXFROMPOSITION 2164
 #define SCI_POINTYFROMPOSITION 2165
@@ -500,6 +504,24 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_CANPASTE 2173
 #define SCI_CANUNDO 2174
 #define SCI_EMPTYUNDOBUFFER 2175
+#define SCI_SETUNDOMEMORYLIMIT 7000
+#define SCI_GETUNDOMEMORYLIMIT 7001
+#define SCI_GETUNDOMEMORY 7002
+#define SC_UNDO_ACTION_INSERT 0
+#define SC_UNDO_ACTION_REMOVE 1
+#define SC_UNDO_ACTION_START 2
+#define SC_UNDO_ACTION_CONTAINER 3
+#define SC_UNDO_ACTION_MAY_COALESCE 0x100
+#define SCI_GETUNDOACTIONS 2790
+#define SCI_SETUNDOSAVEPOINT 2791
+#define SCI_GETUNDOSAVEPOINT 2792
+#define SCI_SETUNDOCURRENT 2797
+#define SCI_GETUNDOCURRENT 2798
+#define SCI_PUSHUNDOACTIONTYPE 2800
+#define SCI_CHANGELASTUNDOACTIONTEXT 2801
+#define SCI_GETUNDOACTIONTYPE 2802
+#define SCI_GETUNDOACTIONPOSITION 2803
+#define SCI_GETUNDOACTIONTEXT 2804
 #define SCI_UNDO 2176
 #define SCI_CUT 2177
 #define SCI_COPY 2178
@@ -609,6 +631,13 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SC_IDLESTYLING_ALL 3
 #define SCI_SETIDLESTYLING 2692
 #define SCI_GETIDLESTYLING 2693
+#define SC_IDLETASK_NONE 0
+#define SC_IDLETASK_WRAP 1
+#define SC_IDLETASK_STYLE 2
+#define SC_IDLETASK_LAYOUT 4
+#define SC_IDLETASK_QUEUED 8
+#define SC_IDLETASK_ACTIVE 16
+#define SCI_GETIDLETASKS 7011
 #define SC_WRAP_NONE 0
 #define SC_WRAP_WORD 1
 #define SC_WRAP_CHAR 2
@@ -640,6 +669,17 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SC_CACHE_DOCUMENT 3
 #define SCI_SETLAYOUTCACHE 2272
 #define SCI_GETLAYOUTCACHE 2273
+#define SCI_SETLAYOUTCACHEBUDGET 7003
+#define SCI_GETLAYOUTCACHEBUDGET 7004
+#define SCI_SETLINEPIXMAPCACHEBUDGET 7013
+#define SCI_GETLINEPIXMAPCACHEBUDGET 7014
+#define SC_LAYOUTCACHE_HITS 0
+#define SC_LAYOUTCACHE_MISSES 1
+#define SC_LAYOUTCACHE_EVICTIONS 2
+#define SC_LAYOUTCACHE_ENTRIES 3
+#define SC_LAYOUTCACHE_MEMORY 4
+#define SCI_GETLAYOUTCACHESTATISTIC 7005
+#define SCI_RESETLAYOUTCACHESTATISTICS 7006
 #define SCI_SETSCROLLWIDTH 2274
 #define SCI_GETSCROLLWIDTH 2275
 #define SCI_SETSCROLLWIDTHTRACKING 2516
@@ -776,6 +816,7 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SC_DOCUMENTOPTION_DEFAULT 0
 #define SC_DOCUMENTOPTION_STYLES_NONE 0x1
 #define SC_DOCUMENTOPTION_TEXT_LARGE 0x100
+#define SC_DOCUMENTOPTION_PIECE_TABLE 0x200
 #define SCI_CREATEDOCUMENT 2375
 #define SCI_ADDREFDOCUMENT 2376
 #define SCI_RELEASEDOCUMENT 2377
@@ -918,18 +959,25 @@ typedef sptr_t (*SciFnDirectStatus)(sptr_t ptr, unsigned int iMessage, uptr_t wP
 #define SCI_GETINDICATORVALUE 2503
 #define SCI_INDICATORFILLRANGE 2504
 #define SCI_INDICATORCLEARRANGE 2505
+#define SCI_INDICATORFILLRANGES 7009
+#define SCI_INDICATORREPLACERANGES 7010
 #define SCI_INDICATORALLONFOR 2506
 #define SCI_INDICATORVALUEAT 2507
+#define SCI_GETINDICATORRUNS 7012
 #define SCI_INDICATORSTART 2508
 #define SCI_INDICATOREND 2509
 #define SCI_SETPOSITIONCACHE 2514
 #define SCI_GETPOSITIONCACHE 2515
+#define SCI_GETPOSITIONCACHESTATISTIC 7007
+#define SCI_RESETPOSITIONCACHESTATISTICS 7008
 #define SCI_SETLAYOUTTHREADS 2775
 #define SCI_GETLAYOUTTHREADS 2776
 #define SCI_COPYALLOWLINE 2519
 #define SCI_GETCHARACTERPOINTER 2520
 #define SCI_GETRANGEPOINTER 2643
 #define SCI_GETGAPPOSITION 2644
+#define SCI_GETTEXTSEGMENT 7015
+#define SCI_GETMODIFICATIONCOUNT 7017
 #define SCI_INDICSETALPHA 2523
 #define SCI_INDICGETALPHA 2524
 #define SCI_INDICSETOUTLINEALPHA 2558
@@ -1277,6 +1325,24 @@ struct Sci_TextToFind {
 	struct Sci_CharacterRange chrgText;
 };
 
+/* These versions use Sci_Position so can reach past 2GB on 64-bit systems. */
+
+struct Sci_CharacterRangeFull {
+	Sci_Position cpMin;
+	Sci_Position cpMax;
+};
+
+struct Sci_TextRangeFull {
+	struct Sci_CharacterRangeFull chrg;
+	char *lpstrText;
+};
+
+struct Sci_TextToFindFull {
+	struct Sci_CharacterRangeFull chrg;
+	const char *lpstrText;
+	struct Sci_CharacterRangeFull chrgText;
+};
+
 typedef void *Sci_SurfaceID;
 
 struct Sci_Rectangle {
@@ -93,6 +93,7 @@ public:
 	void SelectAll();
 	void SetSavePoint();
 	Position GetStyledText(void *tr);
+	Position GetStyledTextFull(void *tr);
 	bool CanRedo();
 	Line MarkerLineFromHandle(int markerHandle);
 	void MarkerDeleteHandle(int markerHandle);
@@ -221,6 +222,7 @@ public:
 	void ClearCmdKey(int keyDefinition);
 	void ClearAllCmdKeys();
 	void SetStylingEx(Position length, const char *styles);
+	bool SetStylingCheckpoint(Position length, const char *state);
 	void StyleSetVisible(int style, bool visible);
 	int CaretPeriod();
 	void SetCaretPeriod(int periodMilliseconds);
@@ -321,6 +323,7 @@ public:
 	void SetPrintColourMode(Scintilla::PrintOption mode);
 	Scintilla::PrintOption PrintColourMode();
 	Position FindText(Scintilla::FindOption searchFlags, void *ft);
+	Position FindTextFull(Scintilla::FindOption searchFlags, void *ft);
 	Position FormatRange(bool draw, void *fr);
 	Line FirstVisibleLine();
 	Position GetLine(Line line, char *text);
@@ -336,6 +339,7 @@ public:
 	Position GetSelText(char *text);
 	std::string GetSelText();
 	Position GetTextRange(void *tr);
+	Position GetTextRangeFull(void *tr);
 	void HideSelection(bool hide);
 	int PointXFromPosition(Position pos);
 	int PointYFromPosition(Position pos);
@@ -350,6 +354,20 @@ public:
 	bool CanPaste();
 	bool CanUndo();
 	void EmptyUndoBuffer();
+	void SetUndoMemoryLimit(Position bytes);
+	Position UndoMemoryLimit();
+	Position UndoMemory();
+	int UndoActions();
+	void SetUndoSavePoint(int action);
+	int UndoSavePoint();
+	void SetUndoCurrent(int action);
+	int UndoCurrent();
+	void PushUndoActionType(int type, Position pos);
+	void ChangeLastUndoActionText(Position length, const char *text);
+	int UndoActionType(int action);
+	Position UndoActionPosition(int action);
+	int UndoActionText(int action, char *text);
+	std::string UndoActionText(int action);
 	void Undo();
 	void Cut();
 	void Copy();
@@ -435,6 +453,7 @@ public:
 	bool IsRangeWord(Position start, Position end);
 	void SetIdleStyling(Scintilla::IdleStyling idleStyling);
 	Scintilla::IdleStyling IdleStyling();
+	Scintilla::IdleTask IdleTasks();
 	void SetWrapMode(Scintilla::Wrap wrapMode);
 	Scintilla::Wrap WrapMode();
 	void SetWrapVisualFlags(Scintilla::WrapVisualFlag wrapVisualFlags);
@@ -447,6 +466,12 @@ public:
 	Scintilla::WrapIndentMode WrapIndentMode();
 	void SetLayoutCache(Scintilla::LineCache cacheMode);
 	Scintilla::LineCache LayoutCache();
+	void SetLayoutCacheBudget(Position bytes);
+	Position LayoutCacheBudget();
+	void SetLinePixmapCacheBudget(Position bytes);
+	Position LinePixmapCacheBudget();
+	Position LayoutCacheStatistic(Scintilla::LayoutCacheStatistic statistic);
+	void ResetLayoutCacheStatistics();
 	void SetScrollWidth(int pixelWidth);
 	int ScrollWidth();
 	void SetScrollWidthTracking(bool tracking);
@@ -676,18 +701,25 @@ public:
 	int IndicatorValue();
 	void IndicatorFillRange(Position start, Position lengthFill);
 	void IndicatorClearRange(Position start, Position lengthClear);
+	void IndicatorFillRanges(Position rangeCount, void *ranges);
+	void IndicatorReplaceRanges(Position rangeCount, void *ranges);
 	int IndicatorAllOnFor(Position pos);
 	int IndicatorValueAt(int indicator, Position pos);
+	Position IndicatorRuns(int indicator);
 	Position IndicatorStart(int indicator, Position pos);
 	Position IndicatorEnd(int indicator, Position pos);
 	void SetPositionCache(int size);
 	int PositionCache();
+	Position PositionCacheStatistic(Scintilla::LayoutCacheStatistic statistic);
+	void ResetPositionCacheStatistics();
 	void SetLayoutThreads(int threads);
 	int LayoutThreads();
 	void CopyAllowLine();
 	void *CharacterPointer();
 	void *RangePointer(Position start, Position lengthRange);
 	Position GapPosition();
+	void *TextSegment(Position pos, void *length);
+	Position ModificationCount();
 	void IndicSetAlpha(int indicator, Scintilla::Alpha alpha);
 	Scintilla::Alpha IndicGetAlpha(int indicator);
 	void IndicSetOutlineAlpha(int indicator, Scintilla::Alpha alpha);
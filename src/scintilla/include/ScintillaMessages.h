@@ -33,6 +33,7 @@ enum class Message {
 	SelectAll = 2013,
 	SetSavePoint = 2014,
 	GetStyledText = 2015,
+	GetStyledTextFull = 2778,
 	CanRedo = 2016,
 	MarkerLineFromHandle = 2017,
 	MarkerDeleteHandle = 2018,
@@ -158,6 +159,7 @@ enum class Message {
 	ClearCmdKey = 2071,
 	ClearAllCmdKeys = 2072,
 	SetStylingEx = 2073,
+	SetStylingCheckpoint = 7016,
 	StyleSetVisible = 2074,
 	GetCaretPeriod = 2075,
 	SetCaretPeriod = 2076,
@@ -257,6 +259,7 @@ enum class Message {
 	SetPrintColourMode = 2148,
 	GetPrintColourMode = 2149,
 	FindText = 2150,
+	FindTextFull = 2196,
 	FormatRange = 2151,
 	GetFirstVisibleLine = 2152,
 	GetLine = 2153,
@@ -270,6 +273,7 @@ enum class Message {
 	SetSel = 2160,
 	GetSelText = 2161,
 	GetTextRange = 2162,
+	GetTextRangeFull = 2039,
 	HideSelection = 2163,
 	PointXFromPosition = 2164,
 	PointYFromPosition = 2165,
@@ -284,6 +288,19 @@ enum class Message {
 	CanPaste = 2173,
 	CanUndo = 2174,
 	EmptyUndoBuffer = 2175,
+	SetUndoMemoryLimit = 7000,
+	GetUndoMemoryLimit = 7001,
+	GetUndoMemory = 7002,
+	GetUndoActions = 2790,
+	SetUndoSavePoint = 2791,
+	GetUndoSavePoint = 2792,
+	SetUndoCurrent = 2797,
+	GetUndoCurrent = 2798,
+	PushUndoActionType = 2800,
+	ChangeLastUndoActionText = 2801,
+	GetUndoActionType = 2802,
+	GetUndoActionPosition = 2803,
+	GetUndoActionText = 2804,
 	Undo = 2176,
 	Cut = 2177,
 	Copy = 2178,
@@ -366,6 +383,7 @@ enum class Message {
 	IsRangeWord = 2691,
 	SetIdleStyling = 2692,
 	GetIdleStyling = 2693,
+	GetIdleTasks = 7011,
 	SetWrapMode = 2268,
 	GetWrapMode = 2269,
 	SetWrapVisualFlags = 2460,
@@ -378,6 +396,12 @@ enum class Message {
 	GetWrapIndentMode = 2473,
 	SetLayoutCache = 2272,
 	GetLayoutCache = 2273,
+	SetLayoutCacheBudget = 7003,
+	GetLayoutCacheBudget = 7004,
+	SetLinePixmapCacheBudget = 7013,
+	GetLinePixmapCacheBudget = 7014,
+	GetLayoutCacheStatistic = 7005,
+	ResetLayoutCacheStatistics = 7006,
 	SetScrollWidth = 2274,
 	GetScrollWidth = 2275,
 	SetScrollWidthTracking = 2516,
@@ -601,18 +625,25 @@ enum class Message {
 	GetIndicatorValue = 2503,
 	IndicatorFillRange = 2504,
 	IndicatorClearRange = 2505,
+	IndicatorFillRanges = 7009,
+	IndicatorReplaceRanges = 7010,
 	IndicatorAllOnFor = 2506,
 	IndicatorValueAt = 2507,
+	GetIndicatorRuns = 7012,
 	IndicatorStart = 2508,
 	IndicatorEnd = 2509,
 	SetPositionCache = 2514,
 	GetPositionCache = 2515,
+	GetPositionCacheStatistic = 7007,
+	ResetPositionCacheStatistics = 7008,
 	SetLayoutThreads = 2775,
 	GetLayoutThreads = 2776,
 	CopyAllowLine = 2519,
 	GetCharacterPointer = 2520,
 	GetRangePointer = 2643,
 	GetGapPosition = 2644,
+	GetTextSegment = 7015,
+	GetModificationCount = 7017,
 	IndicSetAlpha = 2523,
 	IndicGetAlpha = 2524,
 	IndicSetOutlineAlpha = 2558,
@@ -30,6 +30,22 @@ struct TextToFind {
 	CharacterRange chrgText;
 };
 
+struct CharacterRangeFull {
+	Position cpMin;
+	Position cpMax;
+};
+
+struct TextRangeFull {
+	CharacterRangeFull chrg;
+	char *lpstrText;
+};
+
+struct TextToFindFull {
+	CharacterRangeFull chrg;
+	const char *lpstrText;
+	CharacterRangeFull chrgText;
+};
+
 using SurfaceID = void *;
 
 struct Rectangle {
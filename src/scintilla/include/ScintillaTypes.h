@@ -263,6 +263,14 @@ enum class FindOption {
 	Cxx11RegEx = 0x00800000,
 };
 
+enum class UndoActionType {
+	Insert = 0,
+	Remove = 1,
+	Start = 2,
+	Container = 3,
+	MayCoalesce = 0x100,
+};
+
 enum class FoldLevel {
 	None = 0x0,
 	Base = 0x400,
@@ -307,6 +315,15 @@ enum class IdleStyling {
 	All = 3,
 };
 
+enum class IdleTask {
+	None = 0,
+	Wrap = 1,
+	Style = 2,
+	Layout = 4,
+	Queued = 8,
+	Active = 16,
+};
+
 enum class Wrap {
 	None = 0,
 	Word = 1,
@@ -341,6 +358,14 @@ enum class LineCache {
 	Document = 3,
 };
 
+enum class LayoutCacheStatistic {
+	Hits = 0,
+	Misses = 1,
+	Evictions = 2,
+	Entries = 3,
+	Memory = 4,
+};
+
 enum class PhasesDraw {
 	One = 0,
 	Two = 1,
@@ -382,6 +407,7 @@ enum class DocumentOption {
 	Default = 0,
 	StylesNone = 0x1,
 	TextLarge = 0x100,
+	PieceTable = 0x200,
 };
 
 enum class Status {
@@ -731,6 +757,17 @@ constexpr DocumentOption operator|(DocumentOption a, DocumentOption b) noexcept
 	return static_cast<DocumentOption>(static_cast<int>(a) | static_cast<int>(b));
 }
 
+// Functions to manipulate fields from an IdleTask
+
+constexpr IdleTask operator|(IdleTask a, IdleTask b) noexcept {
+	return static_cast<IdleTask>(static_cast<int>(a) | static_cast<int>(b));
+}
+
+inline IdleTask &operator|=(IdleTask &self, IdleTask a) noexcept {
+	self = self | a;
+	return self;
+}
+
 // Functions to manipulate fields from a CaretPolicy
 
 constexpr CaretPolicy operator|(CaretPolicy a, CaretPolicy b) noexcept {
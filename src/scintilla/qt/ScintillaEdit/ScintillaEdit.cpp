@@ -648,6 +648,10 @@ void ScintillaEdit::setStylingEx(sptr_t length, const char * styles) {
     send(SCI_SETSTYLINGEX, length, (sptr_t)styles);
 }
 
+bool ScintillaEdit::setStylingCheckpoint(sptr_t length, const char * state) {
+    return send(SCI_SETSTYLINGCHECKPOINT, length, (sptr_t)state);
+}
+
 void ScintillaEdit::styleSetVisible(sptr_t style, bool visible) {
     send(SCI_STYLESETVISIBLE, style, visible);
 }
@@ -1140,6 +1144,58 @@ void ScintillaEdit::emptyUndoBuffer() {
     send(SCI_EMPTYUNDOBUFFER, 0, 0);
 }
 
+void ScintillaEdit::setUndoMemoryLimit(sptr_t bytes) {
+    send(SCI_SETUNDOMEMORYLIMIT, bytes, 0);
+}
+
+sptr_t ScintillaEdit::undoMemoryLimit() const {
+    return send(SCI_GETUNDOMEMORYLIMIT, 0, 0);
+}
+
+sptr_t ScintillaEdit::undoMemory() const {
+    return send(SCI_GETUNDOMEMORY, 0, 0);
+}
+
+sptr_t ScintillaEdit::undoActions() const {
+    return send(SCI_GETUNDOACTIONS, 0, 0);
+}
+
+void ScintillaEdit::setUndoSavePoint(sptr_t action) {
+    send(SCI_SETUNDOSAVEPOINT, action, 0);
+}
+
+sptr_t ScintillaEdit::undoSavePoint() const {
+    return send(SCI_GETUNDOSAVEPOINT, 0, 0);
+}
+
+void ScintillaEdit::setUndoCurrent(sptr_t action) {
+    send(SCI_SETUNDOCURRENT, action, 0);
+}
+
+sptr_t ScintillaEdit::undoCurrent() const {
+    return send(SCI_GETUNDOCURRENT, 0, 0);
+}
+
+void ScintillaEdit::pushUndoActionType(sptr_t type, sptr_t pos) {
+    send(SCI_PUSHUNDOACTIONTYPE, type, pos);
+}
+
+void ScintillaEdit::changeLastUndoActionText(sptr_t length, const char * text) {
+    send(SCI_CHANGELASTUNDOACTIONTEXT, length, (sptr_t)text);
+}
+
+sptr_t ScintillaEdit::undoActionType(sptr_t action) const {
+    return send(SCI_GETUNDOACTIONTYPE, action, 0);
+}
+
+sptr_t ScintillaEdit::undoActionPosition(sptr_t action) const {
+    return send(SCI_GETUNDOACTIONPOSITION, action, 0);
+}
+
+QByteArray ScintillaEdit::undoActionText(sptr_t action) const {
+    return TextReturner(SCI_GETUNDOACTIONTEXT, action);
+}
+
 void ScintillaEdit::undo() {
     send(SCI_UNDO, 0, 0);
 }
@@ -1468,6 +1524,10 @@ sptr_t ScintillaEdit::idleStyling() const {
     return send(SCI_GETIDLESTYLING, 0, 0);
 }
 
+sptr_t ScintillaEdit::idleTasks() const {
+    return send(SCI_GETIDLETASKS, 0, 0);
+}
+
 void ScintillaEdit::setWrapMode(sptr_t wrapMode) {
     send(SCI_SETWRAPMODE, wrapMode, 0);
 }
@@ -1516,6 +1576,30 @@ sptr_t ScintillaEdit::layoutCache() const {
     return send(SCI_GETLAYOUTCACHE, 0, 0);
 }
 
+void ScintillaEdit::setLayoutCacheBudget(sptr_t bytes) {
+    send(SCI_SETLAYOUTCACHEBUDGET, bytes, 0);
+}
+
+sptr_t ScintillaEdit::layoutCacheBudget() const {
+    return send(SCI_GETLAYOUTCACHEBUDGET, 0, 0);
+}
+
+void ScintillaEdit::setLinePixmapCacheBudget(sptr_t bytes) {
+    send(SCI_SETLINEPIXMAPCACHEBUDGET, bytes, 0);
+}
+
+sptr_t ScintillaEdit::linePixmapCacheBudget() const {
+    return send(SCI_GETLINEPIXMAPCACHEBUDGET, 0, 0);
+}
+
+sptr_t ScintillaEdit::layoutCacheStatistic(sptr_t statistic) const {
+    return send(SCI_GETLAYOUTCACHESTATISTIC, statistic, 0);
+}
+
+void ScintillaEdit::resetLayoutCacheStatistics() {
+    send(SCI_RESETLAYOUTCACHESTATISTICS, 0, 0);
+}
+
 void ScintillaEdit::setScrollWidth(sptr_t pixelWidth) {
     send(SCI_SETSCROLLWIDTH, pixelWidth, 0);
 }
@@ -2408,6 +2492,14 @@ void ScintillaEdit::indicatorClearRange(sptr_t start, sptr_t lengthClear) {
     send(SCI_INDICATORCLEARRANGE, start, lengthClear);
 }
 
+void ScintillaEdit::indicatorFillRanges(sptr_t rangeCount, sptr_t ranges) {
+    send(SCI_INDICATORFILLRANGES, rangeCount, ranges);
+}
+
+void ScintillaEdit::indicatorReplaceRanges(sptr_t rangeCount, sptr_t ranges) {
+    send(SCI_INDICATORREPLACERANGES, rangeCount, ranges);
+}
+
 sptr_t ScintillaEdit::indicatorAllOnFor(sptr_t pos) {
     return send(SCI_INDICATORALLONFOR, pos, 0);
 }
@@ -2416,6 +2508,10 @@ sptr_t ScintillaEdit::indicatorValueAt(sptr_t indicator, sptr_t pos) {
     return send(SCI_INDICATORVALUEAT, indicator, pos);
 }
 
+sptr_t ScintillaEdit::indicatorRuns(sptr_t indicator) const {
+    return send(SCI_GETINDICATORRUNS, indicator, 0);
+}
+
 sptr_t ScintillaEdit::indicatorStart(sptr_t indicator, sptr_t pos) {
     return send(SCI_INDICATORSTART, indicator, pos);
 }
@@ -2432,6 +2528,14 @@ sptr_t ScintillaEdit::positionCache() const {
     return send(SCI_GETPOSITIONCACHE, 0, 0);
 }
 
+sptr_t ScintillaEdit::positionCacheStatistic(sptr_t statistic) const {
+    return send(SCI_GETPOSITIONCACHESTATISTIC, statistic, 0);
+}
+
+void ScintillaEdit::resetPositionCacheStatistics() {
+    send(SCI_RESETPOSITIONCACHESTATISTICS, 0, 0);
+}
+
 void ScintillaEdit::setLayoutThreads(sptr_t threads) {
     send(SCI_SETLAYOUTTHREADS, threads, 0);
 }
@@ -2456,6 +2560,14 @@ sptr_t ScintillaEdit::gapPosition() const {
     return send(SCI_GETGAPPOSITION, 0, 0);
 }
 
+sptr_t ScintillaEdit::textSegment(sptr_t pos, sptr_t length) const {
+    return send(SCI_GETTEXTSEGMENT, pos, length);
+}
+
+sptr_t ScintillaEdit::modificationCount() const {
+    return send(SCI_GETMODIFICATIONCOUNT, 0, 0);
+}
+
 void ScintillaEdit::indicSetAlpha(sptr_t indicator, sptr_t alpha) {
     send(SCI_INDICSETALPHA, indicator, alpha);
 }
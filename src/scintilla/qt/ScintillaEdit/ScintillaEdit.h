@@ -200,6 +200,7 @@ public:
 	void clearCmdKey(sptr_t keyDefinition);
 	void clearAllCmdKeys();
 	void setStylingEx(sptr_t length, const char * styles);
+	bool setStylingCheckpoint(sptr_t length, const char * state);
 	void styleSetVisible(sptr_t style, bool visible);
 	sptr_t caretPeriod() const;
 	void setCaretPeriod(sptr_t periodMilliseconds);
@@ -323,6 +324,19 @@ public:
 	bool canPaste();
 	bool canUndo();
 	void emptyUndoBuffer();
+	void setUndoMemoryLimit(sptr_t bytes);
+	sptr_t undoMemoryLimit() const;
+	sptr_t undoMemory() const;
+	sptr_t undoActions() const;
+	void setUndoSavePoint(sptr_t action);
+	sptr_t undoSavePoint() const;
+	void setUndoCurrent(sptr_t action);
+	sptr_t undoCurrent() const;
+	void pushUndoActionType(sptr_t type, sptr_t pos);
+	void changeLastUndoActionText(sptr_t length, const char * text);
+	sptr_t undoActionType(sptr_t action) const;
+	sptr_t undoActionPosition(sptr_t action) const;
+	QByteArray undoActionText(sptr_t action) const;
 	void undo();
 	void cut();
 	void copy();
@@ -405,6 +419,7 @@ public:
 	bool isRangeWord(sptr_t start, sptr_t end);
 	void setIdleStyling(sptr_t idleStyling);
 	sptr_t idleStyling() const;
+	sptr_t idleTasks() const;
 	void setWrapMode(sptr_t wrapMode);
 	sptr_t wrapMode() const;
 	void setWrapVisualFlags(sptr_t wrapVisualFlags);
@@ -417,6 +432,12 @@ public:
 	sptr_t wrapIndentMode() const;
 	void setLayoutCache(sptr_t cacheMode);
 	sptr_t layoutCache() const;
+	void setLayoutCacheBudget(sptr_t bytes);
+	sptr_t layoutCacheBudget() const;
+	void setLinePixmapCacheBudget(sptr_t bytes);
+	sptr_t linePixmapCacheBudget() const;
+	sptr_t layoutCacheStatistic(sptr_t statistic) const;
+	void resetLayoutCacheStatistics();
 	void setScrollWidth(sptr_t pixelWidth);
 	sptr_t scrollWidth() const;
 	void setScrollWidthTracking(bool tracking);
@@ -640,18 +661,25 @@ public:
 	sptr_t indicatorValue() const;
 	void indicatorFillRange(sptr_t start, sptr_t lengthFill);
 	void indicatorClearRange(sptr_t start, sptr_t lengthClear);
+	void indicatorFillRanges(sptr_t rangeCount, sptr_t ranges);
+	void indicatorReplaceRanges(sptr_t rangeCount, sptr_t ranges);
 	sptr_t indicatorAllOnFor(sptr_t pos);
 	sptr_t indicatorValueAt(sptr_t indicator, sptr_t pos);
+	sptr_t indicatorRuns(sptr_t indicator) const;
 	sptr_t indicatorStart(sptr_t indicator, sptr_t pos);
 	sptr_t indicatorEnd(sptr_t indicator, sptr_t pos);
 	void setPositionCache(sptr_t size);
 	sptr_t positionCache() const;
+	sptr_t positionCacheStatistic(sptr_t statistic) const;
+	void resetPositionCacheStatistics();
 	void setLayoutThreads(sptr_t threads);
 	sptr_t layoutThreads() const;
 	void copyAllowLine();
 	sptr_t characterPointer() const;
 	sptr_t rangePointer(sptr_t start, sptr_t lengthRange) const;
 	sptr_t gapPosition() const;
+	sptr_t textSegment(sptr_t pos, sptr_t length) const;
+	sptr_t modificationCount() const;
 	void indicSetAlpha(sptr_t indicator, sptr_t alpha);
 	sptr_t indicAlpha(sptr_t indicator) const;
 	void indicSetOutlineAlpha(sptr_t indicator, sptr_t alpha);
@@ -21,6 +21,7 @@ SOURCES += \
     ../ScintillaEditBase/PlatQt.cpp \
     ../ScintillaEditBase/ScintillaQt.cpp \
     ../ScintillaEditBase/ScintillaEditBase.cpp \
+    ../ScintillaEditBase/IdleScheduler.cpp \
     ../../src/XPM.cxx \
     ../../src/ViewStyle.cxx \
     ../../src/UniqueString.cxx \
@@ -57,7 +58,8 @@ HEADERS  += \
     ScintillaEdit.h \
     ScintillaDocument.h \
     ../ScintillaEditBase/ScintillaEditBase.h \
-    ../ScintillaEditBase/ScintillaQt.h
+    ../ScintillaEditBase/ScintillaQt.h \
+    ../ScintillaEditBase/IdleScheduler.h
 
 OTHER_FILES +=
 
@@ -0,0 +1,189 @@
+// @file IdleScheduler.cpp
+// Shares idle time between all the editors of an application.
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#include "IdleScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QApplication>
+#include <QPointer>
+#include <QWidget>
+
+namespace {
+
+// Long enough to get useful work done, short enough that input waiting behind a slice is not noticed
+constexpr qint64 sliceMilliseconds = 4;
+
+// Hidden widgets wait this long after the last input so typing and scrolling stay smooth
+constexpr int inputQuietMilliseconds = 250;
+
+}
+
+IdleScheduler::IdleScheduler(QObject *parent) : QObject(parent)
+{
+	connect(&timer, &QTimer::timeout, this, &IdleScheduler::runSlice);
+
+	if (QCoreApplication::instance()) {
+		QCoreApplication::instance()->installEventFilter(this);
+	}
+}
+
+IdleScheduler *IdleScheduler::instance()
+{
+	static QPointer<IdleScheduler> scheduler;
+
+	if (!scheduler) {
+		scheduler = new IdleScheduler(QCoreApplication::instance());
+	}
+
+	return scheduler;
+}
+
+void IdleScheduler::schedule(QObject *owner, Task task)
+{
+	cancel(owner);
+
+	entries.push_back(std::make_shared<Entry>(Entry{owner, std::move(task)}));
+	connect(owner, &QObject::destroyed, this, &IdleScheduler::ownerDestroyed, Qt::UniqueConnection);
+
+	// A pending wait for input to go quiet must not delay a newly scheduled task
+	if (!timer.isActive() || timer.interval() != 0) {
+		timer.start(0);
+	}
+}
+
+void IdleScheduler::cancel(QObject *owner)
+{
+	auto it = std::find_if(entries.begin(), entries.end(), [owner](const std::shared_ptr<Entry> &entry) {
+		return entry->owner == owner;
+	});
+
+	if (it != entries.end()) {
+		(*it)->cancelled = true;
+		entries.erase(it);
+	}
+}
+
+bool IdleScheduler::isScheduled(QObject *owner) const
+{
+	return std::any_of(entries.begin(), entries.end(), [owner](const std::shared_ptr<Entry> &entry) {
+		return entry->owner == owner;
+	});
+}
+
+IdleScheduler::Priority IdleScheduler::priorityOf(const QObject *owner)
+{
+	const QObject *object = owner;
+	while (object && !object->isWidgetType()) {
+		object = object->parent();
+	}
+
+	const QWidget *widget = static_cast<const QWidget *>(object);
+	if (!widget) {
+		// Nothing to say whether it is on screen
+		return Priority::Visible;
+	}
+
+	if (!widget->isVisible()) {
+		return Priority::Hidden;
+	}
+
+	const QWidget *focus = QApplication::focusWidget();
+	if (focus && widget->isActiveWindow() && (focus == widget || widget->isAncestorOf(focus))) {
+		return Priority::Focused;
+	}
+
+	return Priority::Visible;
+}
+
+bool IdleScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+	switch (event->type()) {
+	case QEvent::KeyPress:
+	case QEvent::InputMethod:
+	case QEvent::MouseButtonPress:
+	case QEvent::MouseMove:
+	case QEvent::Wheel:
+	case QEvent::TouchUpdate:
+		sinceInput.start();
+		break;
+	default:
+		break;
+	}
+
+	return QObject::eventFilter(watched, event);
+}
+
+void IdleScheduler::runSlice()
+{
+	QElapsedTimer slice;
+	slice.start();
+
+	const bool recentInput = sinceInput.isValid() && sinceInput.elapsed() < inputQuietMilliseconds;
+
+	// Work from a copy as tasks may schedule or cancel tasks while running
+	std::vector<std::pair<Priority, std::shared_ptr<Entry>>> ordered;
+	ordered.reserve(entries.size());
+	for (const std::shared_ptr<Entry> &entry : entries) {
+		ordered.emplace_back(priorityOf(entry->owner), entry);
+	}
+	std::stable_sort(ordered.begin(), ordered.end(), [](const auto &a, const auto &b) {
+		return a.first < b.first;
+	});
+
+	bool waitingForQuiet = false;
+	bool ran = false;
+	for (const auto &[priority, entry] : ordered) {
+		if (entry->cancelled) {
+			continue;
+		}
+
+		if (priority == Priority::Hidden && recentInput) {
+			waitingForQuiet = true;
+			continue;
+		}
+
+		if (ran && slice.elapsed() >= sliceMilliseconds) {
+			break;
+		}
+
+		ran = true;
+		const bool more = entry->task();
+
+		if (!more) {
+			remove(entry);
+		}
+		else if (!entry->cancelled) {
+			// Move to the back so tasks of the same priority take turns
+			remove(entry);
+			entries.push_back(entry);
+		}
+	}
+
+	if (entries.empty()) {
+		timer.stop();
+	}
+	else if (!ran && waitingForQuiet) {
+		// Only hidden work is left so check again once input has stopped
+		timer.start(static_cast<int>(std::max<qint64>(inputQuietMilliseconds - sinceInput.elapsed(), 1)));
+	}
+	else if (timer.interval() != 0) {
+		timer.start(0);
+	}
+}
+
+void IdleScheduler::ownerDestroyed(QObject *owner)
+{
+	cancel(owner);
+}
+
+void IdleScheduler::remove(const std::shared_ptr<Entry> &entry)
+{
+	auto it = std::find(entries.begin(), entries.end(), entry);
+
+	if (it != entries.end()) {
+		entries.erase(it);
+	}
+}
@@ -0,0 +1,81 @@
+// @file IdleScheduler.h
+// Shares idle time between all the editors of an application.
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef IDLESCHEDULER_H
+#define IDLESCHEDULER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+
+#ifndef EXPORT_IMPORT_API
+#ifdef WIN32
+#ifdef MAKING_LIBRARY
+#define EXPORT_IMPORT_API __declspec(dllexport)
+#else
+// Defining dllimport upsets moc
+#define EXPORT_IMPORT_API __declspec(dllimport)
+//#define EXPORT_IMPORT_API
+#endif
+#else
+#define EXPORT_IMPORT_API
+#endif
+#endif
+
+// Runs background work for every editor from a single zero-interval timer instead of each editor
+// having its own, so editors do not compete with each other or with input for the event loop.
+// Each slice runs tasks for a few milliseconds, those of the widget with focus first, then those of
+// other visible widgets. Tasks of hidden widgets wait until there has been no input for a while.
+class EXPORT_IMPORT_API IdleScheduler : public QObject
+{
+	Q_OBJECT
+
+public:
+	// Does a small piece of work, returning true while there is more to do.
+	typedef std::function<bool()> Task;
+
+	enum class Priority {
+		Focused,
+		Visible,
+		Hidden,
+	};
+
+	static IdleScheduler *instance();
+
+	// Runs task in idle time until it returns false, replacing any task already scheduled for
+	// owner. The priority comes from the nearest widget out of owner and its parents.
+	void schedule(QObject *owner, Task task);
+	void cancel(QObject *owner);
+	bool isScheduled(QObject *owner) const;
+
+	static Priority priorityOf(const QObject *owner);
+
+protected:
+	bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+	void runSlice();
+	void ownerDestroyed(QObject *owner);
+
+private:
+	explicit IdleScheduler(QObject *parent);
+
+	struct Entry {
+		QObject *owner;
+		Task task;
+		bool cancelled = false;
+	};
+
+	void remove(const std::shared_ptr<Entry> &entry);
+
+	std::vector<std::shared_ptr<Entry>> entries;
+	QTimer timer;
+	QElapsedTimer sinceInput;
+};
+
+#endif
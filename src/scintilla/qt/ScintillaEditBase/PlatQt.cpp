@@ -38,6 +38,7 @@
 #include <QScrollBar>
 #include <QTextLayout>
 #include <QTextLine>
+#include <QGlyphRun>
 #include <QLibrary>
 
 using namespace Scintilla;
@@ -112,10 +113,21 @@ static QFont::StyleStrategy ChooseStrategy(FontQuality eff)
 	}
 }
 
+// Text converted to UTF-16 and shaped into glyphs, ready to be drawn again
+struct ShapedText {
+	QTextCodec *codec = nullptr;
+	int dpi = 0;
+	qreal ascent = 0;
+	QList<QGlyphRun> glyphRuns;
+};
+
 class FontAndCharacterSet : public Font {
 public:
 	CharacterSet characterSet = CharacterSet::Ansi;
 	std::unique_ptr<QFont> pfont;
+	// Runs recently drawn in this font. Identifiers and keywords repeat so most runs are
+	// found here. Only used when drawing which is always on the GUI thread.
+	mutable QHash<QByteArray, ShapedText> shapedTexts;
 	explicit FontAndCharacterSet(const FontParameters &fp) : characterSet(fp.characterSet) {
 		pfont = std::make_unique<QFont>();
 		pfont->setStyleStrategy(ChooseStrategy(fp.extraFontFlag));
@@ -133,6 +145,7 @@ const Supports SupportsQt[] = {
 	Supports::FractionalStrokeWidth,
 	Supports::TranslucentStroke,
 	Supports::PixelModification,
+	Supports::ThreadSafeMeasureWidths,
 };
 
 const FontAndCharacterSet *AsFontAndCharacterSet(const Font *f) {
@@ -144,6 +157,41 @@ QFont *FontPointer(const Font *f)
 	return AsFontAndCharacterSet(f)->pfont.get();
 }
 
+// Longer runs rarely repeat so are not worth keeping
+constexpr size_t maxShapedTextLength = 100;
+constexpr int maxShapedTexts = 2000;
+
+// Finds the glyphs for text or shapes and remembers them. A null codec is UTF-8.
+const ShapedText *ShapeText(const Font *font, QTextCodec *codec, std::string_view text, QPaintDevice *device)
+{
+	const FontAndCharacterSet *pfacs = AsFontAndCharacterSet(font);
+	if (!pfacs || !pfacs->pfont || text.empty() || text.length() > maxShapedTextLength)
+		return nullptr;
+
+	const int dpi = device->logicalDpiY();
+	const int length = static_cast<int>(text.length());
+	QHash<QByteArray, ShapedText>::iterator it = pfacs->shapedTexts.find(QByteArray::fromRawData(text.data(), length));
+	if (it != pfacs->shapedTexts.end() && it->codec == codec && it->dpi == dpi)
+		return &it.value();
+
+	if (pfacs->shapedTexts.size() >= maxShapedTexts)
+		pfacs->shapedTexts.clear();
+
+	const QString su = codec ? UnicodeFromText(codec, text) : QString::fromUtf8(text.data(), length);
+	QTextLayout tlay(su, *pfacs->pfont, device);
+	tlay.beginLayout();
+	QTextLine tl = tlay.createLine();
+	tlay.endLayout();
+
+	ShapedText shaped;
+	shaped.codec = codec;
+	shaped.dpi = dpi;
+	shaped.ascent = tl.ascent();
+	shaped.glyphRuns = tl.glyphRuns();
+	it = pfacs->shapedTexts.insert(QByteArray(text.data(), length), shaped);
+	return &it.value();
+}
+
 }
 
 std::shared_ptr<Font> Font::Allocate(const FontParameters &fp)
@@ -257,6 +305,22 @@ void SurfaceImpl::SetCodec(const Font *font)
 	}
 }
 
+// Like SetCodec but leaves the surface unchanged so that text can be measured
+// on several threads at once.
+QTextCodec *SurfaceImpl::CodecForFont(const Font *font) const
+{
+	const FontAndCharacterSet *pfacs = AsFontAndCharacterSet(font);
+	if (pfacs && pfacs->pfont) {
+		const char *csid = "UTF-8";
+		if (!(mode.codePage == SC_CP_UTF8))
+			csid = CharacterSetID(pfacs->characterSet);
+		if (csid != codecName) {
+			return QTextCodec::codecForName(csid);
+		}
+	}
+	return codec;
+}
+
 void SurfaceImpl::SetFont(const Font *font)
 {
 	const FontAndCharacterSet *pfacs = AsFontAndCharacterSet(font);
@@ -520,6 +584,12 @@ void SurfaceImpl::DrawTextNoClip(PRectangle rc,
 	SetFont(font);
 	PenColour(fore);
 
+	if (const ShapedText *shaped = ShapeText(font, codec, text, device)) {
+		GetPainter()->fillRect(QRectFFromPRect(rc), QColorFromColourRGBA(back));
+		DrawShapedText(*shaped, rc.left, ybase);
+		return;
+	}
+
 	GetPainter()->setBackground(QColorFromColourRGBA(back));
 	GetPainter()->setBackgroundMode(Qt::OpaqueMode);
 	QString su = UnicodeFromText(codec, text);
@@ -547,11 +617,25 @@ void SurfaceImpl::DrawTextTransparent(PRectangle rc,
 	SetFont(font);
 	PenColour(fore);
 
+	if (const ShapedText *shaped = ShapeText(font, codec, text, device)) {
+		DrawShapedText(*shaped, rc.left, ybase);
+		return;
+	}
+
 	GetPainter()->setBackgroundMode(Qt::TransparentMode);
 	QString su = UnicodeFromText(codec, text);
 	GetPainter()->drawText(QPointF(rc.left, ybase), su);
 }
 
+void SurfaceImpl::DrawShapedText(const ShapedText &shaped, XYPOSITION x, XYPOSITION ybase)
+{
+	// Glyph positions are relative to the top of the line
+	const QPointF origin(x, ybase - shaped.ascent);
+	for (const QGlyphRun &glyphRun : shaped.glyphRuns) {
+		GetPainter()->drawGlyphRun(origin, glyphRun);
+	}
+}
+
 void SurfaceImpl::SetClip(PRectangle rc)
 {
 	GetPainter()->save();
@@ -569,8 +653,7 @@ void SurfaceImpl::MeasureWidths(const Font *font,
 {
 	if (!font)
 		return;
-	SetCodec(font);
-	QString su = UnicodeFromText(codec, text);
+	QString su = UnicodeFromText(CodecForFont(font), text);
 	QTextLayout tlay(su, *FontPointer(font), GetPaintDevice());
 	tlay.beginLayout();
 	QTextLine tl = tlay.createLine();
@@ -636,6 +719,12 @@ void SurfaceImpl::DrawTextNoClipUTF8(PRectangle rc,
 	SetFont(font);
 	PenColour(fore);
 
+	if (const ShapedText *shaped = ShapeText(font, nullptr, text, device)) {
+		GetPainter()->fillRect(QRectFFromPRect(rc), QColorFromColourRGBA(back));
+		DrawShapedText(*shaped, rc.left, ybase);
+		return;
+	}
+
 	GetPainter()->setBackground(QColorFromColourRGBA(back));
 	GetPainter()->setBackgroundMode(Qt::OpaqueMode);
 	QString su = QString::fromUtf8(text.data(), static_cast<int>(text.length()));
@@ -663,6 +752,11 @@ void SurfaceImpl::DrawTextTransparentUTF8(PRectangle rc,
 	SetFont(font);
 	PenColour(fore);
 
+	if (const ShapedText *shaped = ShapeText(font, nullptr, text, device)) {
+		DrawShapedText(*shaped, rc.left, ybase);
+		return;
+	}
+
 	GetPainter()->setBackgroundMode(Qt::TransparentMode);
 	QString su = QString::fromUtf8(text.data(), static_cast<int>(text.length()));
 	GetPainter()->drawText(QPointF(rc.left, ybase), su);
@@ -68,6 +68,8 @@ constexpr PRectangle RectangleInset(PRectangle rc, XYPOSITION delta) noexcept {
 	return PRectangle(rc.left + delta, rc.top + delta, rc.right - delta, rc.bottom - delta);
 }
 
+struct ShapedText;
+
 class SurfaceImpl : public Surface {
 private:
 	QPaintDevice *device = nullptr;
@@ -79,6 +81,7 @@ private:
 	QTextCodec *codec = nullptr;
 
 	void Clear();
+	void DrawShapedText(const ShapedText &shaped, XYPOSITION x, XYPOSITION ybase);
 
 public:
 	SurfaceImpl();
@@ -151,6 +154,7 @@ public:
 
 	void BrushColour(ColourRGBA back);
 	void SetCodec(const Font *font);
+	QTextCodec *CodecForFont(const Font *font) const;
 	void SetFont(const Font *font);
 
 	QPaintDevice *GetPaintDevice();
@@ -133,6 +133,8 @@ bool ScintillaEditBase::event(QEvent *event)
 		result = QAbstractScrollArea::event(event);
 	} else if (event->type() == QEvent::Hide) {
 		setMouseTracking(false);
+		// Hidden editors do not need to hold on to images of their lines
+		sqt->view.InvalidateLinePixmaps();
 		result = QAbstractScrollArea::event(event);
 	} else {
 		result = QAbstractScrollArea::event(event);
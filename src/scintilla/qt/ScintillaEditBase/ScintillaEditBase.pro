@@ -18,6 +18,7 @@ SOURCES += \
     PlatQt.cpp \
     ScintillaQt.cpp \
     ScintillaEditBase.cpp \
+    IdleScheduler.cpp \
     ../../src/XPM.cxx \
     ../../src/ViewStyle.cxx \
     ../../src/UniqueString.cxx \
@@ -54,6 +55,7 @@ HEADERS  += \
     PlatQt.h \
     ScintillaQt.h \
     ScintillaEditBase.h \
+    IdleScheduler.h \
     ../../src/XPM.h \
     ../../src/ViewStyle.h \
     ../../src/UniConversion.h \
@@ -67,6 +69,7 @@ HEADERS  += \
     ../../src/Platform.h \
     ../../src/PerLine.h \
     ../../src/Partitioning.h \
+    ../../src/PieceTable.h \
     ../../src/LineMarker.h \
     ../../src/KeyMap.h \
     ../../src/Indicator.h \
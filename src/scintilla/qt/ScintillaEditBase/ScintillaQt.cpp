@@ -10,6 +10,7 @@
 
 #include "ScintillaQt.h"
 #include "PlatQt.h"
+#include "IdleScheduler.h"
 
 #include <QApplication>
 #include <QDrag>
@@ -493,22 +494,20 @@ bool ScintillaQt::ChangeIdle(bool on)
 {
 	if (on) {
 		// Start idler, if it's not running.
+		// Idle work of all editors is shared out by one scheduler so that
+		// hidden editors do not slow down the one being used.
 		if (!idler.state) {
 			idler.state = true;
-			QTimer *qIdle = new QTimer;
-			connect(qIdle, SIGNAL(timeout()), this, SLOT(onIdle()));
-			qIdle->start(0);
-			idler.idlerID = qIdle;
+			IdleScheduler::instance()->schedule(this, [this]() {
+				onIdle();
+				return idler.state;
+			});
 		}
 	} else {
 		// Stop idler, if it's running
 		if (idler.state) {
 			idler.state = false;
-			QTimer *qIdle = static_cast<QTimer *>(idler.idlerID);
-			qIdle->stop();
-			disconnect(qIdle, SIGNAL(timeout()), nullptr, nullptr);
-			delete qIdle;
-			idler.idlerID = {};
+			IdleScheduler::instance()->cancel(this);
 		}
 	}
 	return true;
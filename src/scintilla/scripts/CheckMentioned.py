@@ -57,8 +57,12 @@ def convertIFaceTypeToC(t):
 		return "cell *"
 	elif t == "textrange":
 		return "Sci_TextRange *"
+	elif t == "textrangefull":
+		return "Sci_TextRangeFull *"
 	elif t == "findtext":
 		return "Sci_TextToFind *"
+	elif t == "findtextfull":
+		return "Sci_TextToFindFull *"
 	elif t == "formatrange":
 		return "Sci_RangeToFormat *"
 	elif Face.IsEnumeration(t):
@@ -19,6 +19,7 @@ typeAliases = {
 	"colour": "Colour",
 	"colouralpha": "ColourAlpha",
 	"findtext": "void *",
+	"findtextfull": "void *",
 	"formatrange": "void *",
 	"int": "int",
 	"keymod": "int",
@@ -28,6 +29,7 @@ typeAliases = {
 	"string": "const char *",
 	"stringresult": "char *",
 	"textrange": "void *",
+	"textrangefull": "void *",
 }
 
 basicTypes = [
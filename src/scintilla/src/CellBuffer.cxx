@@ -27,6 +27,7 @@
 #include "Position.h"
 #include "SplitVector.h"
 #include "Partitioning.h"
+#include "PieceTable.h"
 #include "CellBuffer.h"
 #include "UniConversion.h"
 
@@ -322,31 +323,82 @@ public:
 	}
 };
 
-Action::Action() noexcept {
-	at = ActionType::start;
-	position = 0;
-	lenData = 0;
-	mayCoalesce = false;
+namespace {
+
+// Approximate cost of an action in the arrays, not counting its text
+constexpr size_t bytesPerAction = sizeof(ActionType) + sizeof(bool) + (3 * sizeof(Sci::Position));
+
+}
+
+size_t UndoArena::ChunkFromOffset(Sci::Position offset) const noexcept {
+	// Few chunks are live at once and recent ones are the most used so search backwards
+	size_t chunk = chunks.size() - 1;
+	while (chunk > 0 && chunks[chunk].start > offset) {
+		chunk--;
+	}
+	return chunk;
+}
+
+Sci::Position UndoArena::End() const noexcept {
+	if (chunks.empty()) {
+		return 0;
+	}
+	return chunks.back().start + chunks.back().used;
+}
+
+Sci::Position UndoArena::Append(const char *data, Sci::Position lengthData) {
+	const Sci::Position offset = End();
+	if (lengthData <= 0) {
+		return offset;
+	}
+	const size_t length = lengthData;
+	if (chunks.empty() || (chunks.back().capacity - chunks.back().used) < length) {
+		// Large insertions get a chunk of their own
+		const size_t capacity = std::max(chunkSize, length);
+		chunks.push_back(Chunk{std::make_unique<char[]>(capacity), offset, capacity, 0});
+		allocated += capacity;
+	}
+	Chunk &chunk = chunks.back();
+	memcpy(chunk.bytes.get() + chunk.used, data, length);
+	chunk.used += length;
+	return offset;
+}
+
+const char *UndoArena::Pointer(Sci::Position offset) const noexcept {
+	if (chunks.empty()) {
+		return nullptr;
+	}
+	const Chunk &chunk = chunks[ChunkFromOffset(offset)];
+	return chunk.bytes.get() + (offset - chunk.start);
 }
 
-Action::~Action() {
+void UndoArena::TruncateTo(Sci::Position offset) noexcept {
+	while (!chunks.empty() && chunks.back().start > offset) {
+		allocated -= chunks.back().capacity;
+		chunks.pop_back();
+	}
+	if (!chunks.empty()) {
+		chunks.back().used = std::min<size_t>(chunks.back().used, offset - chunks.back().start);
+	}
 }
 
-void Action::Create(ActionType at_, Sci::Position position_, const char *data_, Sci::Position lenData_, bool mayCoalesce_) {
-	data = nullptr;
-	position = position_;
-	at = at_;
-	if (lenData_) {
-		data = std::make_unique<char[]>(lenData_);
-		memcpy(&data[0], data_, lenData_);
+void UndoArena::DropBefore(Sci::Position offset) {
+	// Always keep the last chunk as it is where the next text will go
+	size_t drop = 0;
+	while ((drop + 1) < chunks.size() && (chunks[drop].start + static_cast<Sci::Position>(chunks[drop].used)) <= offset) {
+		allocated -= chunks[drop].capacity;
+		drop++;
 	}
-	lenData = lenData_;
-	mayCoalesce = mayCoalesce_;
+	chunks.erase(chunks.begin(), chunks.begin() + drop);
+}
+
+void UndoArena::Clear() noexcept {
+	chunks.clear();
+	allocated = 0;
 }
 
-void Action::Clear() noexcept {
-	data = nullptr;
-	lenData = 0;
+size_t UndoArena::Memory() const noexcept {
+	return allocated;
 }
 
 // The undo history stores a sequence of user operations that represent the user's view of the
@@ -366,29 +418,100 @@ void Action::Clear() noexcept {
 // operation. If there is no outstanding BeginUndoAction call then a new operation is started
 // unless it looks as if the new action is caused by the user typing or deleting a stream of text.
 // Sequences that look like typing or deletion are coalesced into a single user operation.
+// Text is always written after the text of the preceding action so writing an action discards
+// the text of any actions after it, which can no longer be redone.
 
 UndoHistory::UndoHistory() {
 
-	actions.resize(3);
 	maxAction = 0;
 	currentAction = 0;
 	undoSequenceDepth = 0;
 	savePoint = 0;
 	tentativePoint = -1;
+	memoryLimit = 0;
 
-	actions[currentAction].Create(ActionType::start);
+	EnsureUndoRoom();
+	Create(currentAction, ActionType::start);
 }
 
 UndoHistory::~UndoHistory() {
 }
 
 void UndoHistory::EnsureUndoRoom() {
-	// Have to test that there is room for 2 more actions in the array
+	// Have to test that there is room for 2 more actions in the arrays
 	// as two actions may be created by the calling function
-	if (static_cast<size_t>(currentAction) >= (actions.size() - 2)) {
-		// Run out of undo nodes so extend the array
-		actions.resize(actions.size() * 2);
+	const size_t needed = currentAction + 3;
+	if (types.size() < needed) {
+		// Run out of undo nodes so extend the arrays
+		const size_t size = std::max<size_t>(needed, types.size() * 2);
+		types.resize(size);
+		mayCoalesces.resize(size);
+		positions.resize(size);
+		lengths.resize(size);
+		dataOffsets.resize(size);
+	}
+}
+
+void UndoHistory::Create(int index, ActionType at, Sci::Position position, const char *data, Sci::Position lengthData, bool mayCoalesce) {
+	// Text for this action follows on from the previous action's text
+	const Sci::Position offset = (index > 0) ? dataOffsets[index - 1] + lengths[index - 1] : arena.End();
+	arena.TruncateTo(offset);
+	types[index] = at;
+	mayCoalesces[index] = mayCoalesce;
+	positions[index] = position;
+	lengths[index] = lengthData;
+	dataOffsets[index] = (data && lengthData > 0) ? arena.Append(data, lengthData) : offset;
+}
+
+Action UndoHistory::ActionAt(int index) const noexcept {
+	Action action;
+	action.at = types[index];
+	action.mayCoalesce = mayCoalesces[index];
+	action.position = positions[index];
+	action.lenData = lengths[index];
+	if ((action.at == ActionType::insert || action.at == ActionType::remove) && action.lenData > 0) {
+		action.data = arena.Pointer(dataOffsets[index]);
+	}
+	return action;
+}
+
+void UndoHistory::DropOldest() {
+	// Only drop whole user operations that are before the current one and never while a
+	// compound or tentative operation may still refer back to them
+	if (memoryLimit == 0 || undoSequenceDepth > 0 || tentativePoint >= 0) {
+		return;
+	}
+	if (Memory() <= memoryLimit) {
+		return;
+	}
+
+	// Drop down to 3/4 of the limit so this does not happen on every action
+	const size_t target = memoryLimit / 4 * 3;
+	int drop = 0;
+	for (int act = 1; act < currentAction; act++) {
+		if (types[act] == ActionType::start) {
+			drop = act;
+			const size_t freed = static_cast<size_t>(dataOffsets[act] - dataOffsets[0]) + (act * bytesPerAction);
+			if (Memory() - std::min(freed, Memory()) <= target) {
+				break;
+			}
+		}
+	}
+	if (drop == 0) {
+		return;
 	}
+
+	types.erase(types.begin(), types.begin() + drop);
+	mayCoalesces.erase(mayCoalesces.begin(), mayCoalesces.begin() + drop);
+	positions.erase(positions.begin(), positions.begin() + drop);
+	lengths.erase(lengths.begin(), lengths.begin() + drop);
+	dataOffsets.erase(dataOffsets.begin(), dataOffsets.begin() + drop);
+	arena.DropBefore(dataOffsets[0]);
+
+	maxAction -= drop;
+	currentAction -= drop;
+	// The saved state can no longer be reached by undoing
+	savePoint = (savePoint >= drop) ? savePoint - drop : -1;
 }
 
 const char *UndoHistory::AppendAction(ActionType at, Sci::Position position, const char *data, Sci::Position lengthData,
@@ -404,35 +527,34 @@ const char *UndoHistory::AppendAction(ActionType at, Sci::Position position, con
 	if (currentAction >= 1) {
 		if (0 == undoSequenceDepth) {
 			// Top level actions may not always be coalesced
-			int targetAct = -1;
-			const Action *actPrevious = &(actions[currentAction + targetAct]);
+			int targetAct = currentAction - 1;
 			// Container actions may forward the coalesce state of Scintilla Actions.
-			while ((actPrevious->at == ActionType::container) && actPrevious->mayCoalesce) {
+			while ((types[targetAct] == ActionType::container) && mayCoalesces[targetAct]) {
 				targetAct--;
-				actPrevious = &(actions[currentAction + targetAct]);
 			}
+			const ActionType atPrevious = types[targetAct];
 			// See if current action can be coalesced into previous action
 			// Will work if both are inserts or deletes and position is same
 			if ((currentAction == savePoint) || (currentAction == tentativePoint)) {
 				currentAction++;
-			} else if (!actions[currentAction].mayCoalesce) {
+			} else if (!mayCoalesces[currentAction]) {
 				// Not allowed to coalesce if this set
 				currentAction++;
-			} else if (!mayCoalesce || !actPrevious->mayCoalesce) {
+			} else if (!mayCoalesce || !mayCoalesces[targetAct]) {
 				currentAction++;
-			} else if (at == ActionType::container || actions[currentAction].at == ActionType::container) {
+			} else if (at == ActionType::container || types[currentAction] == ActionType::container) {
 				;	// A coalescible containerAction
-			} else if ((at != actPrevious->at) && (actPrevious->at != ActionType::start)) {
+			} else if ((at != atPrevious) && (atPrevious != ActionType::start)) {
 				currentAction++;
 			} else if ((at == ActionType::insert) &&
-			           (position != (actPrevious->position + actPrevious->lenData))) {
+			           (position != (positions[targetAct] + lengths[targetAct]))) {
 				// Insertions must be immediately after to coalesce
 				currentAction++;
 			} else if (at == ActionType::remove) {
 				if ((lengthData == 1) || (lengthData == 2)) {
-					if ((position + lengthData) == actPrevious->position) {
+					if ((position + lengthData) == positions[targetAct]) {
 						; // Backspace -> OK
-					} else if (position == actPrevious->position) {
+					} else if (position == positions[targetAct]) {
 						; // Delete -> OK
 					} else {
 						// Removals must be at same position to coalesce
@@ -448,30 +570,33 @@ const char *UndoHistory::AppendAction(ActionType at, Sci::Position position, con
 
 		} else {
 			// Actions not at top level are always coalesced unless this is after return to top level
-			if (!actions[currentAction].mayCoalesce)
+			if (!mayCoalesces[currentAction])
 				currentAction++;
 		}
 	} else {
 		currentAction++;
 	}
 	startSequence = oldCurrentAction != currentAction;
+	if (startSequence) {
+		DropOldest();
+	}
 	const int actionWithData = currentAction;
-	actions[currentAction].Create(at, position, data, lengthData, mayCoalesce);
+	Create(currentAction, at, position, data, lengthData, mayCoalesce);
 	currentAction++;
-	actions[currentAction].Create(ActionType::start);
+	Create(currentAction, ActionType::start);
 	maxAction = currentAction;
-	return actions[actionWithData].data.get();
+	return ActionAt(actionWithData).data;
 }
 
 void UndoHistory::BeginUndoAction() {
 	EnsureUndoRoom();
 	if (undoSequenceDepth == 0) {
-		if (actions[currentAction].at != ActionType::start) {
+		if (types[currentAction] != ActionType::start) {
 			currentAction++;
-			actions[currentAction].Create(ActionType::start);
+			Create(currentAction, ActionType::start);
 			maxAction = currentAction;
 		}
-		actions[currentAction].mayCoalesce = false;
+		mayCoalesces[currentAction] = false;
 	}
 	undoSequenceDepth++;
 }
@@ -481,12 +606,13 @@ void UndoHistory::EndUndoAction() {
 	EnsureUndoRoom();
 	undoSequenceDepth--;
 	if (0 == undoSequenceDepth) {
-		if (actions[currentAction].at != ActionType::start) {
+		if (types[currentAction] != ActionType::start) {
 			currentAction++;
-			actions[currentAction].Create(ActionType::start);
+			Create(currentAction, ActionType::start);
 			maxAction = currentAction;
 		}
-		actions[currentAction].mayCoalesce = false;
+		mayCoalesces[currentAction] = false;
+		DropOldest();
 	}
 }
 
@@ -495,11 +621,10 @@ void UndoHistory::DropUndoSequence() {
 }
 
 void UndoHistory::DeleteUndoHistory() {
-	for (int i = 1; i < maxAction; i++)
-		actions[i].Clear();
+	arena.Clear();
 	maxAction = 0;
 	currentAction = 0;
-	actions[currentAction].Create(ActionType::start);
+	Create(currentAction, ActionType::start);
 	savePoint = 0;
 	tentativePoint = -1;
 }
@@ -528,7 +653,7 @@ bool UndoHistory::TentativeActive() const noexcept {
 
 int UndoHistory::TentativeSteps() noexcept {
 	// Drop any trailing startAction
-	if (actions[currentAction].at == ActionType::start && currentAction > 0)
+	if (types[currentAction] == ActionType::start && currentAction > 0)
 		currentAction--;
 	if (tentativePoint >= 0)
 		return currentAction - tentativePoint;
@@ -536,25 +661,81 @@ int UndoHistory::TentativeSteps() noexcept {
 		return -1;
 }
 
+void UndoHistory::SetMemoryLimit(size_t limit) {
+	memoryLimit = limit;
+	DropOldest();
+}
+
+size_t UndoHistory::MemoryLimit() const noexcept {
+	return memoryLimit;
+}
+
+size_t UndoHistory::Memory() const noexcept {
+	return arena.Memory() + ((maxAction + 1) * bytesPerAction);
+}
+
+int UndoHistory::Actions() const noexcept {
+	return maxAction + 1;
+}
+
+Action UndoHistory::GetAction(int index) const noexcept {
+	if (index < 0 || index > maxAction) {
+		return Action();
+	}
+	return ActionAt(index);
+}
+
+void UndoHistory::SetSavePointAction(int action) noexcept {
+	savePoint = (action >= 0 && action <= maxAction) ? action : -1;
+}
+
+int UndoHistory::SavePointAction() const noexcept {
+	return savePoint;
+}
+
+void UndoHistory::SetCurrentAction(int action) noexcept {
+	if (action >= 0 && action <= maxAction) {
+		currentAction = action;
+	}
+}
+
+int UndoHistory::CurrentAction() const noexcept {
+	return currentAction;
+}
+
+void UndoHistory::PushAction(ActionType at, Sci::Position position, bool mayCoalesce) {
+	// Anything that could be redone is discarded as the new action follows the last one
+	maxAction++;
+	currentAction = maxAction;
+	EnsureUndoRoom();
+	Create(maxAction, at, position, nullptr, 0, mayCoalesce);
+}
+
+void UndoHistory::ChangeLastActionText(const char *text, Sci::Position lengthText) {
+	if (maxAction > 0) {
+		Create(maxAction, types[maxAction], positions[maxAction], text, lengthText, mayCoalesces[maxAction]);
+	}
+}
+
 bool UndoHistory::CanUndo() const noexcept {
 	return (currentAction > 0) && (maxAction > 0);
 }
 
 int UndoHistory::StartUndo() {
 	// Drop any trailing startAction
-	if (actions[currentAction].at == ActionType::start && currentAction > 0)
+	if (types[currentAction] == ActionType::start && currentAction > 0)
 		currentAction--;
 
 	// Count the steps in this action
 	int act = currentAction;
-	while (actions[act].at != ActionType::start && act > 0) {
+	while (types[act] != ActionType::start && act > 0) {
 		act--;
 	}
 	return currentAction - act;
 }
 
-const Action &UndoHistory::GetUndoStep() const {
-	return actions[currentAction];
+Action UndoHistory::GetUndoStep() const {
+	return ActionAt(currentAction);
 }
 
 void UndoHistory::CompletedUndoStep() {
@@ -567,27 +748,33 @@ bool UndoHistory::CanRedo() const noexcept {
 
 int UndoHistory::StartRedo() {
 	// Drop any leading startAction
-	if (currentAction < maxAction && actions[currentAction].at == ActionType::start)
+	if (currentAction < maxAction && types[currentAction] == ActionType::start)
 		currentAction++;
 
 	// Count the steps in this action
 	int act = currentAction;
-	while (act < maxAction && actions[act].at != ActionType::start) {
+	while (act < maxAction && types[act] != ActionType::start) {
 		act++;
 	}
 	return act - currentAction;
 }
 
-const Action &UndoHistory::GetRedoStep() const {
-	return actions[currentAction];
+Action UndoHistory::GetRedoStep() const {
+	return ActionAt(currentAction);
 }
 
 void UndoHistory::CompletedRedoStep() {
 	currentAction++;
 }
 
-CellBuffer::CellBuffer(bool hasStyles_, bool largeDocument_) :
+CellBuffer::CellBuffer(bool hasStyles_, bool largeDocument_, bool pieceTable_) :
 	hasStyles(hasStyles_), largeDocument(largeDocument_) {
+	if (pieceTable_) {
+		substancePieces = std::make_unique<PieceTable<char>>();
+		if (hasStyles) {
+			stylePieces = std::make_unique<PieceTable<char>>();
+		}
+	}
 	readOnly = false;
 	utf8Substance = false;
 	utf8LineEnds = LineEndType::Default;
@@ -602,11 +789,14 @@ CellBuffer::~CellBuffer() {
 }
 
 char CellBuffer::CharAt(Sci::Position position) const noexcept {
+	if (substancePieces) {
+		return substancePieces->ValueAt(position);
+	}
 	return substance.ValueAt(position);
 }
 
 unsigned char CellBuffer::UCharAt(Sci::Position position) const noexcept {
-	return substance.ValueAt(position);
+	return CharAt(position);
 }
 
 void CellBuffer::GetCharRange(char *buffer, Sci::Position position, Sci::Position lengthRetrieve) const {
@@ -614,18 +804,28 @@ void CellBuffer::GetCharRange(char *buffer, Sci::Position position, Sci::Positio
 		return;
 	if (position < 0)
 		return;
-	if ((position + lengthRetrieve) > substance.Length()) {
+	if ((position + lengthRetrieve) > Length()) {
 		Platform::DebugPrintf("Bad GetCharRange %.0f for %.0f of %.0f\n",
 				      static_cast<double>(position),
 				      static_cast<double>(lengthRetrieve),
-				      static_cast<double>(substance.Length()));
+				      static_cast<double>(Length()));
+		return;
+	}
+	if (substancePieces) {
+		substancePieces->GetRange(buffer, position, lengthRetrieve);
 		return;
 	}
 	substance.GetRange(buffer, position, lengthRetrieve);
 }
 
 char CellBuffer::StyleAt(Sci::Position position) const noexcept {
-	return hasStyles ? style.ValueAt(position) : 0;
+	if (!hasStyles) {
+		return 0;
+	}
+	if (stylePieces) {
+		return stylePieces->ValueAt(position);
+	}
+	return style.ValueAt(position);
 }
 
 void CellBuffer::GetStyleRange(unsigned char *buffer, Sci::Position position, Sci::Position lengthRetrieve) const {
@@ -637,29 +837,59 @@ void CellBuffer::GetStyleRange(unsigned char *buffer, Sci::Position position, Sc
 		std::fill(buffer, buffer + lengthRetrieve, static_cast<unsigned char>(0));
 		return;
 	}
-	if ((position + lengthRetrieve) > style.Length()) {
+	if ((position + lengthRetrieve) > Length()) {
 		Platform::DebugPrintf("Bad GetStyleRange %.0f for %.0f of %.0f\n",
 				      static_cast<double>(position),
 				      static_cast<double>(lengthRetrieve),
-				      static_cast<double>(style.Length()));
+				      static_cast<double>(Length()));
+		return;
+	}
+	if (stylePieces) {
+		stylePieces->GetRange(reinterpret_cast<char *>(buffer), position, lengthRetrieve);
 		return;
 	}
 	style.GetRange(reinterpret_cast<char *>(buffer), position, lengthRetrieve);
 }
 
 const char *CellBuffer::BufferPointer() {
+	if (substancePieces) {
+		return substancePieces->BufferPointer();
+	}
 	return substance.BufferPointer();
 }
 
-const char *CellBuffer::RangePointer(Sci::Position position, Sci::Position rangeLength) noexcept {
+const char *CellBuffer::RangePointer(Sci::Position position, Sci::Position rangeLength) {
+	if (substancePieces) {
+		return substancePieces->RangePointer(position, rangeLength);
+	}
 	return substance.RangePointer(position, rangeLength);
 }
 
 Sci::Position CellBuffer::GapPosition() const noexcept {
+	if (substancePieces) {
+		// There is no gap so all the text is before it
+		return substancePieces->Length();
+	}
 	return substance.GapPosition();
 }
 
-SplitView CellBuffer::AllView() const noexcept {
+const char *CellBuffer::SegmentPointer(Sci::Position position, Sci::Position &segmentStart, Sci::Position &segmentEnd) const noexcept {
+	if (position < 0 || position >= Length()) {
+		return nullptr;
+	}
+	if (substancePieces) {
+		return substancePieces->SegmentPointer(position, segmentStart, segmentEnd);
+	}
+	return substance.SegmentPointer(position, segmentStart, segmentEnd);
+}
+
+SplitView CellBuffer::AllView() {
+	if (substancePieces) {
+		// Contiguous access needs the pieces flattened into a single allocation
+		const char *text = substancePieces->BufferPointer();
+		const size_t length = substancePieces->Length();
+		return SplitView { text, length, text, length };
+	}
 	const size_t length = substance.Length();
 	size_t length1 = substance.GapPosition();
 	if (length1 == 0) {
@@ -694,9 +924,13 @@ bool CellBuffer::SetStyleAt(Sci::Position position, char styleValue) noexcept {
 	if (!hasStyles) {
 		return false;
 	}
-	const char curVal = style.ValueAt(position);
+	const char curVal = StyleAt(position);
 	if (curVal != styleValue) {
-		style.SetValueAt(position, styleValue);
+		if (stylePieces) {
+			stylePieces->SetValueAt(position, styleValue);
+		} else {
+			style.SetValueAt(position, styleValue);
+		}
 		return true;
 	} else {
 		return false;
@@ -709,7 +943,17 @@ bool CellBuffer::SetStyleFor(Sci::Position position, Sci::Position lengthStyle,
 	}
 	bool changed = false;
 	PLATFORM_ASSERT(lengthStyle == 0 ||
-		(lengthStyle > 0 && lengthStyle + position <= style.Length()));
+		(lengthStyle > 0 && lengthStyle + position <= Length()));
+	if (stylePieces) {
+		while (lengthStyle--) {
+			if (stylePieces->ValueAt(position) != styleValue) {
+				stylePieces->SetValueAt(position, styleValue);
+				changed = true;
+			}
+			position++;
+		}
+		return changed;
+	}
 	while (lengthStyle--) {
 		const char curVal = style.ValueAt(position);
 		if (curVal != styleValue) {
@@ -730,8 +974,15 @@ const char *CellBuffer::DeleteChars(Sci::Position position, Sci::Position delete
 		if (collectingUndo) {
 			// Save into the undo/redo stack, but only the characters - not the formatting
 			// The gap would be moved to position anyway for the deletion so this doesn't cost extra
-			data = substance.RangePointer(position, deleteLength);
-			data = uh.AppendAction(ActionType::remove, position, data, deleteLength, startSequence);
+			if (substancePieces) {
+				// Copy out rather than flatten when the deletion spans pieces
+				std::string deleted(deleteLength, '\0');
+				substancePieces->GetRange(deleted.data(), position, deleteLength);
+				data = uh.AppendAction(ActionType::remove, position, deleted.data(), deleteLength, startSequence);
+			} else {
+				data = substance.RangePointer(position, deleteLength);
+				data = uh.AppendAction(ActionType::remove, position, data, deleteLength, startSequence);
+			}
 		}
 
 		BasicDeleteChars(position, deleteLength);
@@ -740,10 +991,20 @@ const char *CellBuffer::DeleteChars(Sci::Position position, Sci::Position delete
 }
 
 Sci::Position CellBuffer::Length() const noexcept {
+	if (substancePieces) {
+		return substancePieces->Length();
+	}
 	return substance.Length();
 }
 
 void CellBuffer::Allocate(Sci::Position newSize) {
+	if (substancePieces) {
+		substancePieces->ReAllocate(newSize);
+		if (hasStyles) {
+			stylePieces->ReAllocate(newSize);
+		}
+		return;
+	}
 	substance.ReAllocate(newSize);
 	if (hasStyles) {
 		style.ReAllocate(newSize);
@@ -847,6 +1108,18 @@ bool CellBuffer::HasStyles() const noexcept {
 	return hasStyles;
 }
 
+bool CellBuffer::IsPieceTable() const noexcept {
+	return substancePieces != nullptr;
+}
+
+// The gap buffer has no state that changes when read, only the piece tables need to be told.
+void CellBuffer::SetConcurrentReading(bool concurrentReading) noexcept {
+	if (substancePieces)
+		substancePieces->SetConcurrentReading(concurrentReading);
+	if (stylePieces)
+		stylePieces->SetConcurrentReading(concurrentReading);
+}
+
 void CellBuffer::SetSavePoint() {
 	uh.SetSavePoint();
 }
@@ -883,10 +1156,10 @@ void CellBuffer::RemoveLine(Sci::Line line) {
 
 bool CellBuffer::UTF8LineEndOverlaps(Sci::Position position) const noexcept {
 	const unsigned char bytes[] = {
-		static_cast<unsigned char>(substance.ValueAt(position-2)),
-		static_cast<unsigned char>(substance.ValueAt(position-1)),
-		static_cast<unsigned char>(substance.ValueAt(position)),
-		static_cast<unsigned char>(substance.ValueAt(position+1)),
+		static_cast<unsigned char>(CharAt(position-2)),
+		static_cast<unsigned char>(CharAt(position-1)),
+		static_cast<unsigned char>(CharAt(position)),
+		static_cast<unsigned char>(CharAt(position+1)),
 	};
 	return UTF8IsSeparator(bytes) || UTF8IsSeparator(bytes+1) || UTF8IsNEL(bytes+1);
 }
@@ -900,7 +1173,7 @@ bool CellBuffer::UTF8IsCharacterBoundary(Sci::Position position) const {
 			if (posBack < 0) {
 				return false;
 			}
-			back.insert(0, 1, substance.ValueAt(posBack));
+			back.insert(0, 1, CharAt(posBack));
 			if (!UTF8IsTrailByte(back.front())) {
 				if (i > 0) {
 					// Have reached a non-trail
@@ -914,7 +1187,7 @@ bool CellBuffer::UTF8IsCharacterBoundary(Sci::Position position) const {
 		}
 	}
 	if (position < Length()) {
-		const unsigned char fore = substance.ValueAt(position);
+		const unsigned char fore = CharAt(position);
 		if (UTF8IsTrailByte(fore)) {
 			return false;
 		}
@@ -936,7 +1209,7 @@ void CellBuffer::ResetLineEnds() {
 	unsigned char chBeforePrev = 0;
 	unsigned char chPrev = 0;
 	for (Sci::Position i = 0; i < length; i++) {
-		const unsigned char ch = substance.ValueAt(position + i);
+		const unsigned char ch = CharAt(position + i);
 		if (ch == '\r') {
 			InsertLine(lineInsert, (position + i) + 1, atLineStart);
 			lineInsert++;
@@ -1000,7 +1273,7 @@ void CellBuffer::BasicInsertString(Sci::Position position, const char *s, Sci::P
 		return;
 	PLATFORM_ASSERT(insertLength > 0);
 
-	const unsigned char chAfter = substance.ValueAt(position);
+	const unsigned char chAfter = CharAt(position);
 	bool breakingUTF8LineEnd = false;
 	if (utf8LineEnds == LineEndType::Unicode && UTF8IsTrailByte(chAfter)) {
 		breakingUTF8LineEnd = UTF8LineEndOverlaps(position);
@@ -1022,16 +1295,23 @@ void CellBuffer::BasicInsertString(Sci::Position position, const char *s, Sci::P
 			UTF8IsValid(std::string_view(s, insertLength));
 	}
 
-	substance.InsertFromArray(position, s, 0, insertLength);
-	if (hasStyles) {
-		style.InsertValue(position, insertLength, 0);
+	if (substancePieces) {
+		substancePieces->InsertFromArray(position, s, 0, insertLength);
+		if (hasStyles) {
+			stylePieces->InsertValue(position, insertLength, 0);
+		}
+	} else {
+		substance.InsertFromArray(position, s, 0, insertLength);
+		if (hasStyles) {
+			style.InsertValue(position, insertLength, 0);
+		}
 	}
 
 	const bool atLineStart = plv->LineStart(lineInsert-1) == position;
 	// Point all the lines after the insertion point further along in the buffer
 	plv->InsertText(lineInsert-1, insertLength);
-	unsigned char chBeforePrev = substance.ValueAt(position - 2);
-	unsigned char chPrev = substance.ValueAt(position - 1);
+	unsigned char chBeforePrev = CharAt(position - 2);
+	unsigned char chPrev = CharAt(position - 1);
 	if (chPrev == '\r' && chAfter == '\n') {
 		// Splitting up a crlf pair at position
 		InsertLine(lineInsert, position, false);
@@ -1142,7 +1422,7 @@ void CellBuffer::BasicInsertString(Sci::Position position, const char *s, Sci::P
 		chPrev = ch;
 		// May have end of UTF-8 line end in buffer and start in insertion
 		for (int j = 0; j < UTF8SeparatorLength-1; j++) {
-			const unsigned char chAt = substance.ValueAt(position + insertLength + j);
+			const unsigned char chAt = CharAt(position + insertLength + j);
 			const unsigned char back3[3] = {chBeforePrev, chPrev, chAt};
 			if (UTF8IsSeparator(back3)) {
 				InsertLine(lineInsert, (position + insertLength + j) + 1, atLineStart);
@@ -1172,7 +1452,7 @@ void CellBuffer::BasicDeleteChars(Sci::Position position, Sci::Position deleteLe
 
 	Sci::Line lineRecalculateStart = Sci::invalidPosition;
 
-	if ((position == 0) && (deleteLength == substance.Length())) {
+	if ((position == 0) && (deleteLength == Length())) {
 		// If whole buffer is being deleted, faster to reinitialise lines data
 		// than to delete each line.
 		plv->Init();
@@ -1184,9 +1464,9 @@ void CellBuffer::BasicDeleteChars(Sci::Position position, Sci::Position deleteLe
 		Sci::Line lineRemove = linePosition + 1;
 
 		plv->InsertText(lineRemove-1, - (deleteLength));
-		const unsigned char chPrev = substance.ValueAt(position - 1);
+		const unsigned char chPrev = CharAt(position - 1);
 		const unsigned char chBefore = chPrev;
-		unsigned char chNext = substance.ValueAt(position);
+		unsigned char chNext = CharAt(position);
 
 		// Check for breaking apart a UTF-8 sequence
 		// Needs further checks that text is UTF-8 or that some other break apart is occurring
@@ -1226,7 +1506,7 @@ void CellBuffer::BasicDeleteChars(Sci::Position position, Sci::Position deleteLe
 
 		unsigned char ch = chNext;
 		for (Sci::Position i = 0; i < deleteLength; i++) {
-			chNext = substance.ValueAt(position + i + 1);
+			chNext = CharAt(position + i + 1);
 			if (ch == '\r') {
 				if (chNext != '\n') {
 					RemoveLine(lineRemove);
@@ -1240,7 +1520,7 @@ void CellBuffer::BasicDeleteChars(Sci::Position position, Sci::Position deleteLe
 			} else if (utf8LineEnds == LineEndType::Unicode) {
 				if (!UTF8IsAscii(ch)) {
 					const unsigned char next3[3] = {ch, chNext,
-						static_cast<unsigned char>(substance.ValueAt(position + i + 2))};
+						static_cast<unsigned char>(CharAt(position + i + 2))};
 					if (UTF8IsSeparator(next3) || UTF8IsNEL(next3)) {
 						RemoveLine(lineRemove);
 					}
@@ -1251,19 +1531,27 @@ void CellBuffer::BasicDeleteChars(Sci::Position position, Sci::Position deleteLe
 		}
 		// May have to fix up end if last deletion causes cr to be next to lf
 		// or removes one of a crlf pair
-		const char chAfter = substance.ValueAt(position + deleteLength);
+		const char chAfter = CharAt(position + deleteLength);
 		if (chBefore == '\r' && chAfter == '\n') {
 			// Using lineRemove-1 as cr ended line before start of deletion
 			RemoveLine(lineRemove - 1);
 			plv->SetLineStart(lineRemove - 1, position + 1);
 		}
 	}
-	substance.DeleteRange(position, deleteLength);
+	if (substancePieces) {
+		substancePieces->DeleteRange(position, deleteLength);
+	} else {
+		substance.DeleteRange(position, deleteLength);
+	}
 	if (lineRecalculateStart >= 0) {
 		RecalculateIndexLineStarts(lineRecalculateStart, lineRecalculateStart);
 	}
 	if (hasStyles) {
-		style.DeleteRange(position, deleteLength);
+		if (stylePieces) {
+			stylePieces->DeleteRange(position, deleteLength);
+		} else {
+			style.DeleteRange(position, deleteLength);
+		}
 	}
 }
 
@@ -1294,6 +1582,50 @@ void CellBuffer::DeleteUndoHistory() {
 	uh.DeleteUndoHistory();
 }
 
+void CellBuffer::SetUndoMemoryLimit(size_t limit) {
+	uh.SetMemoryLimit(limit);
+}
+
+size_t CellBuffer::UndoMemoryLimit() const noexcept {
+	return uh.MemoryLimit();
+}
+
+size_t CellBuffer::UndoMemory() const noexcept {
+	return uh.Memory();
+}
+
+int CellBuffer::UndoActions() const noexcept {
+	return uh.Actions();
+}
+
+Action CellBuffer::GetUndoAction(int index) const noexcept {
+	return uh.GetAction(index);
+}
+
+void CellBuffer::SetUndoSavePoint(int action) noexcept {
+	uh.SetSavePointAction(action);
+}
+
+int CellBuffer::UndoSavePoint() const noexcept {
+	return uh.SavePointAction();
+}
+
+void CellBuffer::SetUndoCurrent(int action) noexcept {
+	uh.SetCurrentAction(action);
+}
+
+int CellBuffer::UndoCurrent() const noexcept {
+	return uh.CurrentAction();
+}
+
+void CellBuffer::PushUndoAction(ActionType at, Sci::Position position, bool mayCoalesce) {
+	uh.PushAction(at, position, mayCoalesce);
+}
+
+void CellBuffer::ChangeLastUndoActionText(const char *text, Sci::Position lengthText) {
+	uh.ChangeLastActionText(text, lengthText);
+}
+
 bool CellBuffer::CanUndo() const noexcept {
 	return uh.CanUndo();
 }
@@ -1302,20 +1634,20 @@ int CellBuffer::StartUndo() {
 	return uh.StartUndo();
 }
 
-const Action &CellBuffer::GetUndoStep() const {
+Action CellBuffer::GetUndoStep() const {
 	return uh.GetUndoStep();
 }
 
 void CellBuffer::PerformUndoStep() {
-	const Action &actionStep = uh.GetUndoStep();
+	const Action actionStep = uh.GetUndoStep();
 	if (actionStep.at == ActionType::insert) {
-		if (substance.Length() < actionStep.lenData) {
+		if (Length() < actionStep.lenData) {
 			throw std::runtime_error(
 				"CellBuffer::PerformUndoStep: deletion must be less than document length.");
 		}
 		BasicDeleteChars(actionStep.position, actionStep.lenData);
 	} else if (actionStep.at == ActionType::remove) {
-		BasicInsertString(actionStep.position, actionStep.data.get(), actionStep.lenData);
+		BasicInsertString(actionStep.position, actionStep.data, actionStep.lenData);
 	}
 	uh.CompletedUndoStep();
 }
@@ -1328,14 +1660,14 @@ int CellBuffer::StartRedo() {
 	return uh.StartRedo();
 }
 
-const Action &CellBuffer::GetRedoStep() const {
+Action CellBuffer::GetRedoStep() const {
 	return uh.GetRedoStep();
 }
 
 void CellBuffer::PerformRedoStep() {
-	const Action &actionStep = uh.GetRedoStep();
+	const Action actionStep = uh.GetRedoStep();
 	if (actionStep.at == ActionType::insert) {
-		BasicInsertString(actionStep.position, actionStep.data.get(), actionStep.lenData);
+		BasicInsertString(actionStep.position, actionStep.data, actionStep.lenData);
 	} else if (actionStep.at == ActionType::remove) {
 		BasicDeleteChars(actionStep.position, actionStep.lenData);
 	}
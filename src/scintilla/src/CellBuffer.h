@@ -25,43 +25,77 @@ public:
  */
 class ILineVector;
 
-enum class ActionType { insert, remove, start, container };
+template <typename T>
+class PieceTable;
+
+enum class ActionType : unsigned char { insert, remove, start, container };
 
 /**
  * Actions are used to store all the information required to perform one undo/redo step.
+ * An Action is a view of an entry in UndoHistory: data points into the history's storage and
+ * is only valid until the history is next modified.
  */
 class Action {
 public:
-	ActionType at;
-	Sci::Position position;
-	std::unique_ptr<char[]> data;
-	Sci::Position lenData;
-	bool mayCoalesce;
-
-	Action() noexcept;
-	// Deleted so Action objects can not be copied.
-	Action(const Action &other) = delete;
-	Action &operator=(const Action &other) = delete;
-	Action &operator=(const Action &&other) = delete;
-	// Move constructor allows vector to be resized without reallocating.
-	Action(Action &&other) noexcept = default;
-	~Action();
-	void Create(ActionType at_, Sci::Position position_=0, const char *data_=nullptr, Sci::Position lenData_=0, bool mayCoalesce_=true);
+	ActionType at = ActionType::start;
+	bool mayCoalesce = false;
+	Sci::Position position = 0;
+	const char *data = nullptr;
+	Sci::Position lenData = 0;
+};
+
+/**
+ * Append-only storage for undo text. Text is copied into large chunks which are never moved so
+ * pointers stay valid until the text is truncated or dropped. Offsets are logical positions in
+ * the whole log, not in a chunk.
+ */
+class UndoArena {
+	struct Chunk {
+		std::unique_ptr<char[]> bytes;
+		Sci::Position start;
+		size_t capacity;
+		size_t used;
+	};
+	std::vector<Chunk> chunks;
+	size_t allocated = 0;
+
+	size_t ChunkFromOffset(Sci::Position offset) const noexcept;
+
+public:
+	static constexpr size_t chunkSize = 0x10000;
+
+	Sci::Position End() const noexcept;
+	Sci::Position Append(const char *data, Sci::Position lengthData);
+	const char *Pointer(Sci::Position offset) const noexcept;
+	void TruncateTo(Sci::Position offset) noexcept;
+	void DropBefore(Sci::Position offset);
 	void Clear() noexcept;
+	size_t Memory() const noexcept;
 };
 
 /**
- *
+ * The actions are held as a structure of arrays with their text in an UndoArena so that
+ * recording an action does not allocate except when one of the arrays or the arena grows.
  */
 class UndoHistory {
-	std::vector<Action> actions;
+	std::vector<ActionType> types;
+	std::vector<bool> mayCoalesces;
+	std::vector<Sci::Position> positions;
+	std::vector<Sci::Position> lengths;
+	std::vector<Sci::Position> dataOffsets;
+	UndoArena arena;
+
 	int maxAction;
 	int currentAction;
 	int undoSequenceDepth;
 	int savePoint;
 	int tentativePoint;
+	size_t memoryLimit;
 
 	void EnsureUndoRoom();
+	void Create(int index, ActionType at, Sci::Position position=0, const char *data=nullptr, Sci::Position lengthData=0, bool mayCoalesce=true);
+	Action ActionAt(int index) const noexcept;
+	void DropOldest();
 
 public:
 	UndoHistory();
@@ -90,15 +124,32 @@ public:
 	bool TentativeActive() const noexcept;
 	int TentativeSteps() noexcept;
 
+	/// Limit the memory used by the history. When exceeded, the oldest user operations are
+	/// dropped. 0 means no limit.
+	void SetMemoryLimit(size_t limit);
+	size_t MemoryLimit() const noexcept;
+	size_t Memory() const noexcept;
+
+	/// Direct access to the actions so the history can be saved and later rebuilt by pushing
+	/// the same actions. Action 0 is always a start action and is present in an empty history.
+	int Actions() const noexcept;
+	Action GetAction(int index) const noexcept;
+	void SetSavePointAction(int action) noexcept;
+	int SavePointAction() const noexcept;
+	void SetCurrentAction(int action) noexcept;
+	int CurrentAction() const noexcept;
+	void PushAction(ActionType at, Sci::Position position, bool mayCoalesce);
+	void ChangeLastActionText(const char *text, Sci::Position lengthText);
+
 	/// To perform an undo, StartUndo is called to retrieve the number of steps, then UndoStep is
 	/// called that many times. Similarly for redo.
 	bool CanUndo() const noexcept;
 	int StartUndo();
-	const Action &GetUndoStep() const;
+	Action GetUndoStep() const;
 	void CompletedUndoStep();
 	bool CanRedo() const noexcept;
 	int StartRedo();
-	const Action &GetRedoStep() const;
+	Action GetRedoStep() const;
 	void CompletedRedoStep();
 };
 
@@ -139,6 +190,9 @@ private:
 	bool largeDocument;
 	SplitVector<char> substance;
 	SplitVector<char> style;
+	// When set, text and styles are held in piece tables instead of substance and style
+	std::unique_ptr<PieceTable<char>> substancePieces;
+	std::unique_ptr<PieceTable<char>> stylePieces;
 	bool readOnly;
 	bool utf8Substance;
 	Scintilla::LineEndType utf8LineEnds;
@@ -159,7 +213,7 @@ private:
 
 public:
 
-	CellBuffer(bool hasStyles_, bool largeDocument_);
+	CellBuffer(bool hasStyles_, bool largeDocument_, bool pieceTable_=false);
 	// Deleted so CellBuffer objects can not be copied.
 	CellBuffer(const CellBuffer &) = delete;
 	CellBuffer(CellBuffer &&) = delete;
@@ -174,9 +228,10 @@ public:
 	char StyleAt(Sci::Position position) const noexcept;
 	void GetStyleRange(unsigned char *buffer, Sci::Position position, Sci::Position lengthRetrieve) const;
 	const char *BufferPointer();
-	const char *RangePointer(Sci::Position position, Sci::Position rangeLength) noexcept;
+	const char *RangePointer(Sci::Position position, Sci::Position rangeLength);
 	Sci::Position GapPosition() const noexcept;
-	SplitView AllView() const noexcept;
+	const char *SegmentPointer(Sci::Position position, Sci::Position &segmentStart, Sci::Position &segmentEnd) const noexcept;
+	SplitView AllView();
 
 	Sci::Position Length() const noexcept;
 	void Allocate(Sci::Position newSize);
@@ -209,6 +264,8 @@ public:
 	void SetReadOnly(bool set) noexcept;
 	bool IsLarge() const noexcept;
 	bool HasStyles() const noexcept;
+	bool IsPieceTable() const noexcept;
+	void SetConcurrentReading(bool concurrentReading) noexcept;
 
 	/// The save point is a marker in the undo stack where the container has stated that
 	/// the buffer was saved. Undo and redo can move over the save point.
@@ -226,16 +283,27 @@ public:
 	void EndUndoAction();
 	void AddUndoAction(Sci::Position token, bool mayCoalesce);
 	void DeleteUndoHistory();
+	void SetUndoMemoryLimit(size_t limit);
+	size_t UndoMemoryLimit() const noexcept;
+	size_t UndoMemory() const noexcept;
+	int UndoActions() const noexcept;
+	Action GetUndoAction(int index) const noexcept;
+	void SetUndoSavePoint(int action) noexcept;
+	int UndoSavePoint() const noexcept;
+	void SetUndoCurrent(int action) noexcept;
+	int UndoCurrent() const noexcept;
+	void PushUndoAction(ActionType at, Sci::Position position, bool mayCoalesce);
+	void ChangeLastUndoActionText(const char *text, Sci::Position lengthText);
 
 	/// To perform an undo, StartUndo is called to retrieve the number of steps, then UndoStep is
 	/// called that many times. Similarly for redo.
 	bool CanUndo() const noexcept;
 	int StartUndo();
-	const Action &GetUndoStep() const;
+	Action GetUndoStep() const;
 	void PerformUndoStep();
 	bool CanRedo() const noexcept;
 	int StartRedo();
-	const Action &GetRedoStep() const;
+	Action GetRedoStep() const;
 	void PerformRedoStep();
 };
 
@@ -50,6 +50,7 @@ class ContractionState final : public IContractionState {
 
 	void InsertLine(Sci::Line lineDoc);
 	void DeleteLine(Sci::Line lineDoc);
+	void RebuildDisplayLines();
 
 public:
 	ContractionState() noexcept;
@@ -80,6 +81,8 @@ public:
 
 	bool GetExpanded(Sci::Line lineDoc) const noexcept override;
 	bool SetExpanded(Sci::Line lineDoc, bool isExpanded) override;
+	bool SetVisibleRanges(const Sci::Line *ranges, size_t rangeCount, bool isVisible) override;
+	bool SetExpandedRanges(const Sci::Line *ranges, size_t rangeCount, bool isExpanded) override;
 	Sci::Line ContractedNext(Sci::Line lineDocStart) const noexcept override;
 
 	int GetHeight(Sci::Line lineDoc) const noexcept override;
@@ -146,6 +149,28 @@ void ContractionState<LINE>::DeleteLine(Sci::Line lineDoc) {
 	}
 }
 
+// Set the display line of every document line in one pass over the runs of visibility and height
+template <typename LINE>
+void ContractionState<LINE>::RebuildDisplayLines() {
+	const LINE lines = static_cast<LINE>(LinesInDoc());
+	std::vector<LINE> displayStarts;
+	displayStarts.reserve(lines);
+	LINE lineDisplay = 0;
+	LINE line = 0;
+	while (line < lines) {
+		const LINE runEnd = std::min({visible->EndRun(line), heights->EndRun(line), lines});
+		const LINE height = visible->ValueAt(line) ? heights->ValueAt(line) : 0;
+		for (; line < runEnd; line++) {
+			lineDisplay += height;
+			displayStarts.push_back(lineDisplay);
+		}
+	}
+	displayLines = std::make_unique<Partitioning<LINE>>(4);
+	displayLines->ReAllocate(lines + 1);
+	displayLines->InsertText(0, lineDisplay);
+	displayLines->InsertPartitions(1, displayStarts.data(), displayStarts.size());
+}
+
 template <typename LINE>
 void ContractionState<LINE>::Clear() noexcept {
 	visible.reset();
@@ -325,6 +350,35 @@ bool ContractionState<LINE>::SetExpanded(Sci::Line lineDoc, bool isExpanded) {
 	}
 }
 
+template <typename LINE>
+bool ContractionState<LINE>::SetVisibleRanges(const Sci::Line *ranges, size_t rangeCount, bool isVisible) {
+	if (OneToOne() && isVisible) {
+		return false;
+	} else {
+		EnsureData();
+		const std::vector<LINE> rangesLine(ranges, ranges + rangeCount * 2);
+		if (!visible->FillRanges(rangesLine.data(), rangeCount, isVisible ? 1 : 0).changed) {
+			return false;
+		}
+		RebuildDisplayLines();
+		Check();
+		return true;
+	}
+}
+
+template <typename LINE>
+bool ContractionState<LINE>::SetExpandedRanges(const Sci::Line *ranges, size_t rangeCount, bool isExpanded) {
+	if (OneToOne() && isExpanded) {
+		return false;
+	} else {
+		EnsureData();
+		const std::vector<LINE> rangesLine(ranges, ranges + rangeCount * 2);
+		const bool changed = expanded->FillRanges(rangesLine.data(), rangeCount, isExpanded ? 1 : 0).changed;
+		Check();
+		return changed;
+	}
+}
+
 template <typename LINE>
 Sci::Line ContractionState<LINE>::ContractedNext(Sci::Line lineDocStart) const noexcept {
 	if (OneToOne()) {
@@ -12,6 +12,7 @@
 
 #include <stdexcept>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 #include <optional>
 #include <algorithm>
@@ -101,6 +102,7 @@ public:
 
 	// Returns changed=true if some values may have changed
 	FillResult<Sci::Position> FillRange(Sci::Position position, int value, Sci::Position fillLength) override;
+	FillResult<Sci::Position> FillRanges(const Sci::Position *ranges, size_t rangeCount, int value, bool replace) override;
 
 	void InsertSpace(Sci::Position position, Sci::Position insertLength) override;
 	void DeleteRange(Sci::Position position, Sci::Position deleteLength) override;
@@ -193,6 +195,34 @@ FillResult<Sci::Position> DecorationList<POS>::FillRange(Sci::Position position,
 	return fr;
 }
 
+template <typename POS>
+FillResult<Sci::Position> DecorationList<POS>::FillRanges(const Sci::Position *ranges, size_t rangeCount, int value, bool replace) {
+	if (!current) {
+		current = DecorationFromIndicator(currentIndicator);
+		if (!current) {
+			if (rangeCount == 0) {
+				// Nothing to fill or to clear
+				return FillResult<Sci::Position>{false, 0, 0};
+			}
+			current = Create(currentIndicator, lengthDocument);
+		}
+	}
+	FillResult<POS> frInPOS {};
+	if constexpr (std::is_same_v<POS, Sci::Position>) {
+		frInPOS = replace ? current->rs.ReplaceRanges(ranges, rangeCount, value) :
+			current->rs.FillRanges(ranges, rangeCount, value);
+	} else {
+		const std::vector<POS> rangesInPOS(ranges, ranges + rangeCount * 2);
+		frInPOS = replace ? current->rs.ReplaceRanges(rangesInPOS.data(), rangeCount, value) :
+			current->rs.FillRanges(rangesInPOS.data(), rangeCount, value);
+	}
+	const FillResult<Sci::Position> fr { frInPOS.changed, frInPOS.position, frInPOS.fillLength };
+	if (current->Empty()) {
+		Delete(currentIndicator);
+	}
+	return fr;
+}
+
 template <typename POS>
 void DecorationList<POS>::InsertSpace(Sci::Position position, Sci::Position insertLength) {
 	const bool atEnd = position == lengthDocument;
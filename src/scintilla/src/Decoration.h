@@ -37,6 +37,9 @@ public:
 
 	// Returns with changed=true if some values may have changed
 	virtual FillResult<Sci::Position> FillRange(Sci::Position position, int value, Sci::Position fillLength) = 0;
+	// Ranges are pairs of position and length, sorted and not overlapping. Replacing clears
+	// the current indicator outside the ranges.
+	virtual FillResult<Sci::Position> FillRanges(const Sci::Position *ranges, size_t rangeCount, int value, bool replace) = 0;
 	virtual void InsertSpace(Sci::Position position, Sci::Position insertLength) = 0;
 	virtual void DeleteRange(Sci::Position position, Sci::Position deleteLength) = 0;
 	virtual void DeleteLexerDecorations() = 0;
@@ -51,13 +51,14 @@
 using namespace Scintilla;
 using namespace Scintilla::Internal;
 
-LexInterface::LexInterface(Document *pdoc_) noexcept : pdoc(pdoc_), performingStyle(false) {
+LexInterface::LexInterface(Document *pdoc_) noexcept : pdoc(pdoc_), checkpointer(nullptr), performingStyle(false) {
 }
 
 LexInterface::~LexInterface() noexcept = default;
 
 void LexInterface::SetInstance(ILexer5 *instance_) {
 	instance.reset(instance_);
+	checkpointer = instance ? static_cast<ILexerCheckpoint *>(instance->PrivateCall(lpcCheckpoint, nullptr)) : nullptr;
 	pdoc->LexerChanged();
 }
 
@@ -81,14 +82,49 @@ void LexInterface::Colourise(Sci::Position start, Sci::Position end) {
 			styleStart = pdoc->StyleAt(start - 1);
 
 		if (len > 0) {
-			instance->Lex(start, len, styleStart, pdoc);
-			instance->Fold(start, len, styleStart, pdoc);
+			if (checkpointer) {
+				ColouriseCheckpointed(start, end);
+			} else {
+				instance->Lex(start, len, styleStart, pdoc);
+				instance->Fold(start, len, styleStart, pdoc);
+			}
 		}
 
 		performingStyle = false;
 	}
 }
 
+// Lex in pieces that end at checkpoints so that lexing after an edit can stop once the
+// lexer reaches a checkpoint in the same state as before the edit.
+void LexInterface::ColouriseCheckpointed(Sci::Position start, Sci::Position end) {
+	// Where the lexer can not take a checkpoint, such as inside a long string, pieces grow
+	// so lexers that look back to the start of the string are not called too often
+	Sci::Line linesPiece = linesPerCheckpoint;
+	while (start < end) {
+		const Sci::Line line = pdoc->SciLineFromPosition(start);
+		Sci::Line lineCheckpoint = pdoc->CheckpointNext(line + linesPiece - linesPerCheckpoint, line + linesPiece);
+		if (lineCheckpoint < 0)
+			lineCheckpoint = line + linesPiece - 1;
+		const Sci::Position endCheckpoint = pdoc->LineStart(lineCheckpoint + 1);
+		const Sci::Position endPiece = std::min(end, endCheckpoint);
+		const int styleStart = (start > 0) ? pdoc->StyleAt(start - 1) : 0;
+		instance->Lex(start, endPiece - start, styleStart, pdoc);
+		instance->Fold(start, endPiece - start, styleStart, pdoc);
+		// Checkpoints inside a grown piece were not reached so no longer match the styles
+		pdoc->ClearCheckpoints(line, lineCheckpoint);
+		start = endPiece;
+		if ((endPiece == endCheckpoint) && (endPiece < pdoc->Length())) {
+			Sci_Position lengthState = 0;
+			const char *state = checkpointer->CheckpointState(lineCheckpoint, &lengthState, pdoc);
+			linesPiece = state ? linesPerCheckpoint : linesPiece * 2;
+			if (pdoc->CheckpointReached(lineCheckpoint, state, lengthState)) {
+				// Continue from the start of the line where the reused styles end
+				start = pdoc->LineStart(pdoc->SciLineFromPosition(pdoc->GetEndStyled()));
+			}
+		}
+	}
+}
+
 LineEndType LexInterface::LineEndTypesSupported() {
 	if (instance) {
 		return static_cast<LineEndType>(instance->LineEndTypesSupported());
@@ -127,7 +163,8 @@ size_t ActionDuration::ActionsInAllowedTime(double secondsAllowed) const noexcep
 }
 
 Document::Document(DocumentOption options) :
-	cb(!FlagSet(options, DocumentOption::StylesNone), FlagSet(options, DocumentOption::TextLarge)),
+	cb(!FlagSet(options, DocumentOption::StylesNone), FlagSet(options, DocumentOption::TextLarge),
+		FlagSet(options, DocumentOption::PieceTable)),
 	durationStyleOneByte(0.000001, 0.0000001, 0.00001) {
 	refCount = 0;
 #ifdef _WIN32
@@ -138,7 +175,9 @@ Document::Document(DocumentOption options) :
 	dbcsCodePage = CpUtf8;
 	lineEndBitSet = LineEndType::Default;
 	endStyled = 0;
+	endStyledReusable = 0;
 	styleClock = 0;
+	modificationCount = 0;
 	enteredModification = 0;
 	enteredStyling = 0;
 	enteredReadOnlyCount = 0;
@@ -158,6 +197,7 @@ Document::Document(DocumentOption options) :
 	perLineData[ldMargin] = std::make_unique<LineAnnotation>();
 	perLineData[ldAnnotation] = std::make_unique<LineAnnotation>();
 	perLineData[ldEOLAnnotation] = std::make_unique<LineAnnotation>();
+	perLineData[ldCheckpoints] = std::make_unique<LineCheckpoints>();
 
 	decorations = DecorationListCreate(IsLarge());
 
@@ -237,6 +277,10 @@ LineAnnotation *Document::EOLAnnotations() const noexcept {
 	return dynamic_cast<LineAnnotation *>(perLineData[ldEOLAnnotation].get());
 }
 
+LineCheckpoints *Document::Checkpoints() const noexcept {
+	return dynamic_cast<LineCheckpoints *>(perLineData[ldCheckpoints].get());
+}
+
 LineEndType Document::LineEndTypesSupported() const {
 	if ((CpUtf8 == dbcsCodePage) && pli)
 		return pli->LineEndTypesSupported();
@@ -278,6 +322,16 @@ void Document::SetSavePoint() {
 	NotifySavePoint(true);
 }
 
+void Document::SetUndoSavePoint(int action) {
+	cb.SetUndoSavePoint(action);
+	NotifySavePoint(cb.IsSavePoint());
+}
+
+void Document::SetUndoCurrent(int action) {
+	cb.SetUndoCurrent(action);
+	NotifySavePoint(cb.IsSavePoint());
+}
+
 void Document::TentativeUndo() {
 	if (!TentativeActive())
 		return;
@@ -291,7 +345,7 @@ void Document::TentativeUndo() {
 			//Platform::DebugPrintf("Steps=%d\n", steps);
 			for (int step = 0; step < steps; step++) {
 				const Sci::Line prevLinesTotal = LinesTotal();
-				const Action &action = cb.GetUndoStep();
+				const Action action = cb.GetUndoStep();
 				if (action.at == ActionType::remove) {
 					NotifyModified(DocModification(
 									ModificationFlags::BeforeInsert | ModificationFlags::Undo, action));
@@ -305,7 +359,7 @@ void Document::TentativeUndo() {
 				}
 				cb.PerformUndoStep();
 				if (action.at != ActionType::container) {
-					ModifiedAt(action.position);
+					TextModifiedAt(action.position, (action.at == ActionType::insert) ? -action.lenData : action.lenData);
 				}
 
 				ModificationFlags modFlags = ModificationFlags::Undo;
@@ -326,7 +380,7 @@ void Document::TentativeUndo() {
 						modFlags |= ModificationFlags::MultilineUndoRedo;
 				}
 				NotifyModified(DocModification(modFlags, action.position, action.lenData,
-											   linesAdded, action.data.get()));
+											   linesAdded, action.data));
 			}
 
 			const bool endSavePoint = cb.IsSavePoint();
@@ -543,13 +597,20 @@ Sci::Line Document::GetLastChild(Sci::Line lineParent, std::optional<FoldLevel>
 	const Sci::Line maxLine = LinesTotal();
 	const Sci::Line lookLastLine = (lastLine != -1) ? std::min(LinesTotal() - 1, lastLine) : -1;
 	Sci::Line lineMaxSubord = lineParent;
-	while (lineMaxSubord < maxLine - 1) {
-		EnsureStyledTo(LineStart(lineMaxSubord + 2));
-		if (!IsSubordinate(levelStart, GetFoldLevel(lineMaxSubord + 1)))
-			break;
-		if ((lookLastLine != -1) && (lineMaxSubord >= lookLastLine) && !LevelIsWhitespace(GetFoldLevel(lineMaxSubord)))
-			break;
-		lineMaxSubord++;
+	// The end of a header's own fold is known without scanning when it has been styled
+	const Sci::Line lineEnd = ((lookLastLine == -1) && (levelStart == LevelNumberPart(GetFoldLevel(lineParent)))) ?
+		Levels()->FoldEnd(lineParent, maxLine) : -1;
+	if ((lineEnd > lineParent) && (GetEndStyled() >= LineStart(lineEnd + 1))) {
+		lineMaxSubord = lineEnd - 1;
+	} else {
+		while (lineMaxSubord < maxLine - 1) {
+			EnsureStyledTo(LineStart(lineMaxSubord + 2));
+			if (!IsSubordinate(levelStart, GetFoldLevel(lineMaxSubord + 1)))
+				break;
+			if ((lookLastLine != -1) && (lineMaxSubord >= lookLastLine) && !LevelIsWhitespace(GetFoldLevel(lineMaxSubord)))
+				break;
+			lineMaxSubord++;
+		}
 	}
 	if (lineMaxSubord > lineParent) {
 		if (levelStart > LevelNumberPart(GetFoldLevel(lineMaxSubord + 1))) {
@@ -563,20 +624,7 @@ Sci::Line Document::GetLastChild(Sci::Line lineParent, std::optional<FoldLevel>
 }
 
 Sci::Line Document::GetFoldParent(Sci::Line line) const {
-	const FoldLevel level = LevelNumberPart(GetFoldLevel(line));
-	Sci::Line lineLook = line - 1;
-	while ((lineLook > 0) && (
-	            (!LevelIsHeader(GetFoldLevel(lineLook))) ||
-	            (LevelNumberPart(GetFoldLevel(lineLook)) >= level))
-	      ) {
-		lineLook--;
-	}
-	if (LevelIsHeader(GetFoldLevel(lineLook)) &&
-	        (LevelNumberPart(GetFoldLevel(lineLook)) < level)) {
-		return lineLook;
-	} else {
-		return -1;
-	}
+	return Levels()->FoldParent(line, LinesTotal());
 }
 
 void Document::GetHighlightDelimiters(HighlightDelimiter &highlightDelimiter, Sci::Line line, Sci::Line lastLine) {
@@ -1209,6 +1257,23 @@ EncodingFamily Document::CodePageFamily() const noexcept {
 void Document::ModifiedAt(Sci::Position pos) noexcept {
 	if (endStyled > pos)
 		endStyled = pos;
+	if (endStyledReusable > pos)
+		endStyledReusable = pos;
+}
+
+// Text was inserted (lengthChange > 0) or deleted (lengthChange < 0) at pos. Unlike
+// ModifiedAt, styles after the change remain reusable as they move with their text.
+void Document::TextModifiedAt(Sci::Position pos, Sci::Position lengthChange) noexcept {
+	if (pos < endStyled) {
+		endStyledReusable = std::max(endStyledReusable, endStyled);
+		if ((lengthChange < 0) && (pos - lengthChange > endStyledReusable))
+			endStyledReusable = pos;
+		else
+			endStyledReusable += lengthChange;
+		endStyled = pos;
+	} else if (endStyledReusable > pos) {
+		endStyledReusable = pos;
+	}
 }
 
 void Document::CheckReadOnly() {
@@ -1247,9 +1312,9 @@ bool Document::DeleteChars(Sci::Position pos, Sci::Position len) {
 			if (startSavePoint && cb.IsCollectingUndo())
 				NotifySavePoint(false);
 			if ((pos < LengthNoExcept()) || (pos == 0))
-				ModifiedAt(pos);
+				TextModifiedAt(pos, -len);
 			else
-				ModifiedAt(pos-1);
+				TextModifiedAt(pos-1, -len);
 			NotifyModified(
 			    DocModification(
 			        ModificationFlags::DeleteText | ModificationFlags::User |
@@ -1299,7 +1364,7 @@ Sci::Position Document::InsertString(Sci::Position position, const char *s, Sci:
 	const char *text = cb.InsertString(position, s, insertLength, startSequence);
 	if (startSavePoint && cb.IsCollectingUndo())
 		NotifySavePoint(false);
-	ModifiedAt(position);
+	TextModifiedAt(position, insertLength);
 	NotifyModified(
 		DocModification(
 			ModificationFlags::InsertText | ModificationFlags::User |
@@ -1350,7 +1415,7 @@ Sci::Position Document::Undo() {
 			Sci::Position prevRemoveActionLen = 0;
 			for (int step = 0; step < steps; step++) {
 				const Sci::Line prevLinesTotal = LinesTotal();
-				const Action &action = cb.GetUndoStep();
+				const Action action = cb.GetUndoStep();
 				if (action.at == ActionType::remove) {
 					NotifyModified(DocModification(
 									ModificationFlags::BeforeInsert | ModificationFlags::Undo, action));
@@ -1370,7 +1435,7 @@ Sci::Position Document::Undo() {
 				}
 				cb.PerformUndoStep();
 				if (action.at != ActionType::container) {
-					ModifiedAt(action.position);
+					TextModifiedAt(action.position, (action.at == ActionType::insert) ? -action.lenData : action.lenData);
 					newPos = action.position;
 				}
 
@@ -1407,7 +1472,7 @@ Sci::Position Document::Undo() {
 						modFlags |= ModificationFlags::MultilineUndoRedo;
 				}
 				NotifyModified(DocModification(modFlags, action.position, action.lenData,
-											   linesAdded, action.data.get()));
+											   linesAdded, action.data));
 			}
 
 			const bool endSavePoint = cb.IsSavePoint();
@@ -1430,7 +1495,7 @@ Sci::Position Document::Redo() {
 			const int steps = cb.StartRedo();
 			for (int step = 0; step < steps; step++) {
 				const Sci::Line prevLinesTotal = LinesTotal();
-				const Action &action = cb.GetRedoStep();
+				const Action action = cb.GetRedoStep();
 				if (action.at == ActionType::insert) {
 					NotifyModified(DocModification(
 									ModificationFlags::BeforeInsert | ModificationFlags::Redo, action));
@@ -1444,7 +1509,7 @@ Sci::Position Document::Redo() {
 				}
 				cb.PerformRedoStep();
 				if (action.at != ActionType::container) {
-					ModifiedAt(action.position);
+					TextModifiedAt(action.position, (action.at == ActionType::insert) ? action.lenData : -action.lenData);
 					newPos = action.position;
 				}
 
@@ -1467,7 +1532,7 @@ Sci::Position Document::Redo() {
 				}
 				NotifyModified(
 					DocModification(modFlags, action.position, action.lenData,
-									linesAdded, action.data.get()));
+									linesAdded, action.data));
 			}
 
 			const bool endSavePoint = cb.IsSavePoint();
@@ -1717,7 +1782,8 @@ void Document::ConvertLineEnds(EndOfLine eolModeSet) {
 
 DocumentOption Document::Options() const noexcept {
 	return (IsLarge() ? DocumentOption::TextLarge : DocumentOption::Default) |
-		(cb.HasStyles() ? DocumentOption::Default : DocumentOption::StylesNone);
+		(cb.HasStyles() ? DocumentOption::Default : DocumentOption::StylesNone) |
+		(cb.IsPieceTable() ? DocumentOption::PieceTable : DocumentOption::Default);
 }
 
 bool Document::IsWhiteLine(Sci::Line line) const {
@@ -2049,10 +2115,64 @@ ptrdiff_t SplitFindChar(const SplitView &view, size_t start, size_t length, int
 	return -1;
 }
 
-// Equivalent of memcmp over the split view
+// Reads the text being searched. Split vector text is read through a split view and piece table
+// text a piece at a time so that searching does not flatten the pieces into one allocation.
+class SearchView {
+	const CellBuffer &cb;
+	const bool pieces;
+	SplitView split;
+	mutable const char *segment = nullptr;
+	mutable Sci::Position segmentStart = 0;
+	mutable Sci::Position segmentEnd = 0;
+
+	bool Locate(Sci::Position position) const noexcept {
+		if (segment && position >= segmentStart && position < segmentEnd) {
+			return true;
+		}
+		segment = cb.SegmentPointer(position, segmentStart, segmentEnd);
+		return segment != nullptr;
+	}
+
+public:
+	explicit SearchView(CellBuffer &cb_) : cb(cb_), pieces(cb_.IsPieceTable()) {
+		if (!pieces) {
+			split = cb_.AllView();
+		}
+	}
+
+	char CharAt(Sci::Position position) const noexcept {
+		if (!pieces) {
+			return split.CharAt(position);
+		}
+		if (!Locate(position)) {
+			return 0;
+		}
+		return segment[position - segmentStart];
+	}
+
+	// Equivalent of memchr over the text
+	ptrdiff_t FindChar(Sci::Position start, Sci::Position length, int ch) const noexcept {
+		if (!pieces) {
+			return SplitFindChar(split, start, length, ch);
+		}
+		const Sci::Position end = start + length;
+		while (start < end && Locate(start)) {
+			const Sci::Position rangeEnd = std::min(end, segmentEnd);
+			const char *match = static_cast<const char *>(
+				memchr(segment + (start - segmentStart), ch, rangeEnd - start));
+			if (match) {
+				return segmentStart + (match - segment);
+			}
+			start = rangeEnd;
+		}
+		return -1;
+	}
+};
+
+// Equivalent of memcmp over the search view
 // This does not call memcmp as search texts are commonly too short to overcome the
 // call overhead.
-bool SplitMatch(const SplitView &view, size_t start, std::string_view text) noexcept {
+bool SplitMatch(const SearchView &view, Sci::Position start, std::string_view text) noexcept {
 	for (size_t i = 0; i < text.length(); i++) {
 		if (view.CharAt(i + start) != text[i]) {
 			return false;
@@ -2099,7 +2219,7 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 			// Back all of a character
 			pos = NextPosition(pos, increment);
 		}
-		const SplitView cbView = cb.AllView();
+		const SearchView cbView(cb);
 		if (caseSensitive) {
 			const Sci::Position endSearch = (startPos <= endPos) ? endPos - lengthFind + 1 : endPos;
 			const unsigned char charStartSearch =  search[0];
@@ -2109,7 +2229,7 @@ Sci::Position Document::FindText(Sci::Position minPos, Sci::Position maxPos, con
 				// UTF-8 search will not be self-synchronizing when starts with trail byte
 				const std::string_view suffix(search + 1, lengthFind - 1);
 				while (pos < endSearch) {
-					pos = SplitFindChar(cbView, pos, limitPos - pos, charStartSearch);
+					pos = cbView.FindChar(pos, limitPos - pos, charStartSearch);
 					if (pos < 0) {
 						break;
 					}
@@ -2408,7 +2528,88 @@ void Document::StyleToAdjustingLineDuration(Sci::Position pos) {
 	durationStyleOneByte.AddSample(pos - stylingStart, epStyling.Duration());
 }
 
+Sci::Line Document::CheckpointNext(Sci::Line lineStart, Sci::Line lineEnd) const noexcept {
+	return Checkpoints()->CheckpointNext(lineStart, lineEnd);
+}
+
+// Lexing has reached the end of line and the lexer has given the state it holds itself or
+// nullptr if line is not a good place to restart. Records the checkpoint and, when it matches
+// the checkpoint recorded before an edit, treats the reusable styles after it as styled.
+bool Document::CheckpointReached(Sci::Line line, const char *state, Sci::Position lengthState) {
+	LineCheckpoints *checkpoints = Checkpoints();
+	if (!state) {
+		if (checkpoints->Checkpoint(line))
+			checkpoints->SetCheckpoint(line, std::unique_ptr<LexerCheckpoint>());
+		return false;
+	}
+	const Sci::Position lineEnd = LineStart(line + 1);
+	std::unique_ptr<LexerCheckpoint> checkpoint = std::make_unique<LexerCheckpoint>();
+	checkpoint->lineState = GetLineState(line);
+	checkpoint->level = GetLevel(line);
+	checkpoint->style = StyleAt(lineEnd - 1);
+	checkpoint->state.assign(state, lengthState);
+	const LexerCheckpoint *previous = checkpoints->Checkpoint(line);
+	const bool converged = previous && (*previous == *checkpoint) &&
+		(lineEnd <= endStyled) && (endStyled < endStyledReusable);
+	checkpoints->SetCheckpoint(line, std::move(checkpoint));
+	if (converged) {
+		endStyled = endStyledReusable;
+	}
+	return converged;
+}
+
+// Styles from pos for length are being set by the application rather than the lexer so
+// checkpoints there no longer describe how the styles that follow them were produced.
+void Document::DiscardCheckpoints(Sci::Position pos, Sci::Position length) {
+	if (endStyledReusable > pos)
+		endStyledReusable = pos;
+	ClearCheckpoints(SciLineFromPosition(pos), SciLineFromPosition(pos + length) + 1);
+}
+
+// Styles up to endStyled, which is at the start of a line, were set by the application from
+// a lexer run elsewhere that reached the end of the previous line in state. Checkpoints the
+// run passed over are cleared as they would be by ColouriseCheckpointed since the
+// application records one at least every linesPerCheckpoint lines.
+bool Document::StylingCheckpoint(const char *state, Sci::Position lengthState) {
+	const Sci::Line line = SciLineFromPosition(endStyled) - 1;
+	if ((line < 0) || (LineStart(line + 1) != endStyled))
+		return false;
+	ClearCheckpoints(std::max<Sci::Line>(line - LexInterface::linesPerCheckpoint + 1, 0), line);
+	return CheckpointReached(line, state, lengthState);
+}
+
+// Whether the styles from pos for length are already styles so setting them would not
+// change anything that checkpoints describe.
+bool Document::StylesMatch(Sci::Position pos, Sci::Position length, const char *styles) const noexcept {
+	const Sci::Position end = std::min(pos + length, LengthNoExcept());
+	for (Sci::Position position = pos; position < end; position++) {
+		if (cb.StyleAt(position) != styles[position - pos])
+			return false;
+	}
+	return true;
+}
+
+bool Document::StyleMatches(Sci::Position pos, Sci::Position length, char style) const noexcept {
+	const Sci::Position end = std::min(pos + length, LengthNoExcept());
+	for (Sci::Position position = pos; position < end; position++) {
+		if (cb.StyleAt(position) != style)
+			return false;
+	}
+	return true;
+}
+
+void Document::ClearCheckpoints(Sci::Line lineStart, Sci::Line lineEnd) {
+	LineCheckpoints *checkpoints = Checkpoints();
+	for (Sci::Line line = checkpoints->CheckpointNext(lineStart, lineEnd); line >= 0;
+		line = checkpoints->CheckpointNext(line + 1, lineEnd)) {
+		checkpoints->SetCheckpoint(line, std::unique_ptr<LexerCheckpoint>());
+	}
+}
+
 void Document::LexerChanged() {
+	// Checkpoints hold the previous lexer's state
+	Checkpoints()->ClearAll();
+	endStyledReusable = 0;
 	// Tell the watchers the lexer has changed.
 	for (const WatcherWithUserData &watcher : watchers) {
 		watcher.watcher->NotifyLexerChanged(this, watcher.userData);
@@ -2575,6 +2776,16 @@ void SCI_METHOD Document::DecorationFillRange(Sci_Position position, int value,
 	}
 }
 
+void Document::DecorationFillRanges(const Sci::Position *ranges, size_t rangeCount, int value, bool replace) {
+	const FillResult<Sci::Position> fr = decorations->FillRanges(
+		ranges, rangeCount, value, replace);
+	if (fr.changed) {
+		const DocModification mh(ModificationFlags::ChangeIndicator | ModificationFlags::User,
+							fr.position, fr.fillLength);
+		NotifyModified(mh);
+	}
+}
+
 bool Document::AddWatcher(DocWatcher *watcher, void *userData) {
 	const WatcherWithUserData wwud(watcher, userData);
 	std::vector<WatcherWithUserData>::iterator it =
@@ -2616,8 +2827,10 @@ void Document::NotifySavePoint(bool atSavePoint) {
 void Document::NotifyModified(DocModification mh) {
 	if (FlagSet(mh.modificationType, ModificationFlags::InsertText)) {
 		decorations->InsertSpace(mh.position, mh.length);
+		modificationCount++;
 	} else if (FlagSet(mh.modificationType, ModificationFlags::DeleteText)) {
 		decorations->DeleteRange(mh.position, mh.length);
+		modificationCount++;
 	}
 	for (const WatcherWithUserData &watcher : watchers) {
 		watcher.watcher->NotifyModified(this, mh, watcher.userData);
@@ -17,6 +17,7 @@ class LineMarkers;
 class LineLevels;
 class LineState;
 class LineAnnotation;
+class LineCheckpoints;
 
 enum class EncodingFamily { eightBit, unicode, dbcs };
 
@@ -186,8 +187,13 @@ class LexInterface {
 protected:
 	Document *pdoc;
 	LexerInstance instance;
+	Scintilla::ILexerCheckpoint *checkpointer;	///< Optional interface of instance
 	bool performingStyle;	///< Prevent reentrance
+	void ColouriseCheckpointed(Sci::Position start, Sci::Position end);
 public:
+	/// Lines lexed before stopping to check whether the lexer is back in its previous state
+	static constexpr Sci::Line linesPerCheckpoint = 64;
+
 	explicit LexInterface(Document *pdoc_) noexcept;
 	// Deleted so LexInterface objects can not be copied.
 	LexInterface(const LexInterface &) = delete;
@@ -228,7 +234,7 @@ public:
 
 /**
  */
-class Document : PerLine, public Scintilla::IDocument, public Scintilla::ILoader {
+class Document : PerLine, public Scintilla::IDocumentSegments, public Scintilla::ILoader {
 
 public:
 	/** Used to pair watcher pointer with user data. */
@@ -250,7 +256,12 @@ private:
 	CharacterCategoryMap charMap;
 	std::unique_ptr<CaseFolder> pcf;
 	Sci::Position endStyled;
+	/// Styles from endStyled up to here were set before edits above them and may be reused
+	/// if lexing reaches a checkpoint in the same state as before.
+	Sci::Position endStyledReusable;
 	int styleClock;
+	/// Counts insertions and deletions so clients can tell whether the text has changed
+	Sci::Position modificationCount;
 	int enteredModification;
 	int enteredStyling;
 	int enteredReadOnlyCount;
@@ -261,7 +272,7 @@ private:
 	std::vector<WatcherWithUserData> watchers;
 
 	// ldSize is not real data - it is for dimensions and loops
-	enum lineData { ldMarkers, ldLevels, ldState, ldMargin, ldAnnotation, ldEOLAnnotation, ldSize };
+	enum lineData { ldMarkers, ldLevels, ldState, ldMargin, ldAnnotation, ldEOLAnnotation, ldCheckpoints, ldSize };
 	std::unique_ptr<PerLine> perLineData[ldSize];
 	LineMarkers *Markers() const noexcept;
 	LineLevels *Levels() const noexcept;
@@ -269,6 +280,7 @@ private:
 	LineAnnotation *Margins() const noexcept;
 	LineAnnotation *Annotations() const noexcept;
 	LineAnnotation *EOLAnnotations() const noexcept;
+	LineCheckpoints *Checkpoints() const noexcept;
 
 	bool matchesValid;
 	std::unique_ptr<RegexSearchBase> regex;
@@ -326,7 +338,7 @@ public:
 	Scintilla::LineEndType GetLineEndTypesActive() const noexcept { return cb.GetLineEndTypes(); }
 
 	int SCI_METHOD Version() const override {
-		return Scintilla::dvRelease4;
+		return Scintilla::dvRelease5;
 	}
 
 	void SCI_METHOD SetErrorStatus(int status) override;
@@ -357,6 +369,7 @@ public:
 
 	// Gateways to modifying document
 	void ModifiedAt(Sci::Position pos) noexcept;
+	void TextModifiedAt(Sci::Position pos, Sci::Position lengthChange) noexcept;
 	void CheckReadOnly();
 	bool DeleteChars(Sci::Position pos, Sci::Position len);
 	Sci::Position InsertString(Sci::Position position, const char *s, Sci::Position insertLength);
@@ -375,6 +388,17 @@ public:
 	void BeginUndoAction() { cb.BeginUndoAction(); }
 	void EndUndoAction() { cb.EndUndoAction(); }
 	void AddUndoAction(Sci::Position token, bool mayCoalesce) { cb.AddUndoAction(token, mayCoalesce); }
+	void SetUndoMemoryLimit(size_t limit) { cb.SetUndoMemoryLimit(limit); }
+	size_t UndoMemoryLimit() const noexcept { return cb.UndoMemoryLimit(); }
+	size_t UndoMemory() const noexcept { return cb.UndoMemory(); }
+	int UndoActions() const noexcept { return cb.UndoActions(); }
+	Action GetUndoAction(int index) const noexcept { return cb.GetUndoAction(index); }
+	void SetUndoSavePoint(int action);
+	int UndoSavePoint() const noexcept { return cb.UndoSavePoint(); }
+	void SetUndoCurrent(int action);
+	int UndoCurrent() const noexcept { return cb.UndoCurrent(); }
+	void PushUndoAction(ActionType at, Sci::Position position, bool mayCoalesce) { cb.PushUndoAction(at, position, mayCoalesce); }
+	void ChangeLastUndoActionText(const char *text, Sci::Position lengthText) { cb.ChangeLastUndoActionText(text, lengthText); }
 	void SetSavePoint();
 	bool IsSavePoint() const noexcept { return cb.IsSavePoint(); }
 
@@ -384,7 +408,7 @@ public:
 	bool TentativeActive() const noexcept { return cb.TentativeActive(); }
 
 	const char * SCI_METHOD BufferPointer() override { return cb.BufferPointer(); }
-	const char *RangePointer(Sci::Position position, Sci::Position rangeLength) noexcept { return cb.RangePointer(position, rangeLength); }
+	const char *RangePointer(Sci::Position position, Sci::Position rangeLength) { return cb.RangePointer(position, rangeLength); }
 	Sci::Position GapPosition() const noexcept { return cb.GapPosition(); }
 
 	int SCI_METHOD GetLineIndentation(Sci_Position line) override;
@@ -400,6 +424,8 @@ public:
 	void SetReadOnly(bool set) { cb.SetReadOnly(set); }
 	bool IsReadOnly() const noexcept { return cb.IsReadOnly(); }
 	bool IsLarge() const noexcept { return cb.IsLarge(); }
+	/// While true, the text and styles may be read from several threads but must not be changed.
+	void SetConcurrentReading(bool concurrentReading) noexcept { cb.SetConcurrentReading(concurrentReading); }
 	Scintilla::DocumentOption Options() const noexcept;
 
 	void DelChar(Sci::Position pos);
@@ -409,6 +435,9 @@ public:
 	void SCI_METHOD GetCharRange(char *buffer, Sci_Position position, Sci_Position lengthRetrieve) const override {
 		cb.GetCharRange(buffer, position, lengthRetrieve);
 	}
+	const char * SCI_METHOD TextSegment(Sci_Position position, Sci_Position *segmentStart, Sci_Position *segmentEnd) const override {
+		return cb.SegmentPointer(position, *segmentStart, *segmentEnd);
+	}
 	char SCI_METHOD StyleAt(Sci_Position position) const override { return cb.StyleAt(position); }
 	int StyleIndexAt(Sci_Position position) const noexcept { return static_cast<unsigned char>(cb.StyleAt(position)); }
 	void GetStyleRange(unsigned char *buffer, Sci::Position position, Sci::Position lengthRetrieve) const {
@@ -478,11 +507,20 @@ public:
 	Sci::Position GetEndStyled() const noexcept { return endStyled; }
 	void EnsureStyledTo(Sci::Position pos);
 	void StyleToAdjustingLineDuration(Sci::Position pos);
+	Sci::Line CheckpointNext(Sci::Line lineStart, Sci::Line lineEnd) const noexcept;
+	bool CheckpointReached(Sci::Line line, const char *state, Sci::Position lengthState);
+	void ClearCheckpoints(Sci::Line lineStart, Sci::Line lineEnd);
+	void DiscardCheckpoints(Sci::Position pos, Sci::Position length);
+	bool StylingCheckpoint(const char *state, Sci::Position lengthState);
+	bool StylesMatch(Sci::Position pos, Sci::Position length, const char *styles) const noexcept;
+	bool StyleMatches(Sci::Position pos, Sci::Position length, char style) const noexcept;
 	void LexerChanged();
 	int GetStyleClock() const noexcept { return styleClock; }
+	Sci::Position ModificationCount() const noexcept { return modificationCount; }
 	void IncrementStyleClock() noexcept;
 	void SCI_METHOD DecorationSetCurrentIndicator(int indicator) override;
 	void SCI_METHOD DecorationFillRange(Sci_Position position, int value, Sci_Position fillLength) override;
+	void DecorationFillRanges(const Sci::Position *ranges, size_t rangeCount, int value, bool replace);
 	LexInterface *GetLexInterface() const noexcept;
 	void SetLexInterface(std::unique_ptr<LexInterface> pLexInterface) noexcept;
 
@@ -594,7 +632,7 @@ public:
 		position(act.position),
 		length(act.lenData),
 		linesAdded(linesAdded_),
-		text(act.data.get()),
+		text(act.data),
 		line(0),
 		foldLevelNow(Scintilla::FoldLevel::None),
 		foldLevelPrev(Scintilla::FoldLevel::None),
@@ -195,7 +195,9 @@ EditView::EditView() {
 	imeCaretBlockOverride = false;
 	llc.SetLevel(LineCache::Caret);
 	posCache = CreatePositionCache();
-	posCache->SetSize(0x400);
+	linePixmapBudget = 0;
+	linePixmapsViewSignature = 0;
+	linePixmapsClock = 0;
 	maxLayoutThreads = 1;
 	tabArrowHeight = 4;
 	customDrawTabArrow = nullptr;
@@ -278,6 +280,125 @@ void EditView::DropGraphics() noexcept {
 	pixmapLine.reset();
 	pixmapIndentGuide.reset();
 	pixmapIndentGuideHighlight.reset();
+	linePixmaps.clear();
+}
+
+void EditView::SetLinePixmapBudget(size_t budget) noexcept {
+	linePixmapBudget = budget;
+	InvalidateLinePixmaps();
+}
+
+void EditView::InvalidateLinePixmaps() noexcept {
+	linePixmaps.clear();
+}
+
+void EditView::InvalidateLinePixmaps(Sci::Line lineFirst, Sci::Line lineLast) noexcept {
+	linePixmaps.erase(std::remove_if(linePixmaps.begin(), linePixmaps.end(),
+		[lineFirst, lineLast](const LinePixmap &lp) noexcept {
+			return lp.lineDoc >= lineFirst && lp.lineDoc <= lineLast;
+		}), linePixmaps.end());
+}
+
+namespace {
+
+constexpr void HashCombine(size_t &hash, size_t value) noexcept {
+	hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+}
+
+// Everything that changes the appearance of all lines without a redraw being requested
+size_t EditView::LinePixmapsViewSignature(const EditModel &model, const ViewStyle &vsDraw, PRectangle rcClient) const noexcept {
+	size_t hash = 0;
+	HashCombine(hash, static_cast<size_t>(rcClient.Width()));
+	HashCombine(hash, vsDraw.lineHeight);
+	HashCombine(hash, vsDraw.textStart);
+	HashCombine(hash, model.xOffset);
+	HashCombine(hash, model.hasFocus);
+	HashCombine(hash, model.primarySelection);
+	HashCombine(hash, model.inOverstrike);
+	HashCombine(hash, model.caret.active);
+	HashCombine(hash, static_cast<size_t>(model.sel.selType));
+	HashCombine(hash, model.bracesMatchStyle);
+	HashCombine(hash, model.highlightGuideColumn);
+	HashCombine(hash, hideSelection);
+	HashCombine(hash, imeCaretBlockOverride);
+	return hash;
+}
+
+// Selections, carets, braces and hotspots that fall on lineDoc
+size_t EditView::LinePixmapSignature(const EditModel &model, Sci::Line lineDoc) const noexcept {
+	const Sci::Position posLineStart = model.pdoc->LineStart(lineDoc);
+	const Sci::Position posLineEnd = model.pdoc->LineStart(lineDoc + 1);
+	const auto onLine = [posLineStart, posLineEnd](Sci::Position pos) noexcept {
+		return pos >= posLineStart && pos <= posLineEnd;
+	};
+	size_t hash = 0;
+	for (size_t r = 0; r < model.sel.Count(); r++) {
+		const SelectionRange &range = model.sel.Range(r);
+		if (range.Start().Position() <= posLineEnd && range.End().Position() >= posLineStart) {
+			HashCombine(hash, r);
+			HashCombine(hash, r == model.sel.Main());
+			HashCombine(hash, range.caret.Position());
+			HashCombine(hash, range.caret.VirtualSpace());
+			HashCombine(hash, range.anchor.Position());
+			HashCombine(hash, range.anchor.VirtualSpace());
+			if (onLine(range.caret.Position())) {
+				HashCombine(hash, model.caret.on);
+			}
+		}
+	}
+	if (model.posDrag.IsValid() && onLine(model.posDrag.Position())) {
+		HashCombine(hash, model.posDrag.Position());
+		HashCombine(hash, model.caret.on);
+	}
+	for (const Sci::Position brace : model.braces) {
+		if (onLine(brace)) {
+			HashCombine(hash, brace);
+		}
+	}
+	if (model.hotspot.Valid() && model.hotspot.start <= posLineEnd && model.hotspot.end >= posLineStart) {
+		HashCombine(hash, model.hotspot.start);
+		HashCombine(hash, model.hotspot.end);
+	}
+	if (onLine(model.hoverIndicatorPos)) {
+		HashCombine(hash, model.hoverIndicatorPos);
+	}
+	return hash;
+}
+
+LinePixmap *EditView::FindLinePixmap(Sci::Line lineDoc, int subLine, size_t signature) noexcept {
+	for (LinePixmap &lp : linePixmaps) {
+		if (lp.lineDoc == lineDoc && lp.subLine == subLine) {
+			if (lp.signature != signature) {
+				return nullptr;
+			}
+			lp.lastUsed = ++linePixmapsClock;
+			return &lp;
+		}
+	}
+	return nullptr;
+}
+
+LinePixmap &EditView::AddLinePixmap(Sci::Line lineDoc, int subLine, size_t signature, size_t maxLines) {
+	// Reuse a stale image of the same line or else the least recently used one when full
+	auto it = std::find_if(linePixmaps.begin(), linePixmaps.end(), [lineDoc, subLine](const LinePixmap &lp) noexcept {
+		return lp.lineDoc == lineDoc && lp.subLine == subLine;
+	});
+	if ((it == linePixmaps.end()) && (linePixmaps.size() >= maxLines)) {
+		it = std::min_element(linePixmaps.begin(), linePixmaps.end(), [](const LinePixmap &a, const LinePixmap &b) noexcept {
+			return a.lastUsed < b.lastUsed;
+		});
+	}
+	if (it == linePixmaps.end()) {
+		linePixmaps.emplace_back();
+		it = linePixmaps.end() - 1;
+	}
+	it->lineDoc = lineDoc;
+	it->subLine = subLine;
+	it->signature = signature;
+	it->lastUsed = ++linePixmapsClock;
+	return *it;
 }
 
 static const char *ControlCharacterString(unsigned char ch) noexcept {
@@ -391,8 +512,8 @@ void LayoutSegments(IPositionCache *pCache,
 	LineLayout *ll, 
 	const std::vector<TextSegment> &segments,
 	std::atomic<uint32_t> &nextIndex,
-	const bool textUnicode,
-	const bool multiThreaded) {
+	const int codePage) {
+	const bool textUnicode = CpUtf8 == codePage;
 	while (true) {
 		const uint32_t i = nextIndex.fetch_add(1, std::memory_order_acq_rel);
 		if (i >= segments.size()) {
@@ -414,7 +535,7 @@ void LayoutSegments(IPositionCache *pCache,
 						// or it only contains ASCII which is a subset of all currently supported encodings.
 						if (textUnicode || ViewIsASCII(ts.representation->stringRep)) {
 							pCache->MeasureWidths(surface, vstyle, StyleControlChar, ts.representation->stringRep,
-								positionsRepr, multiThreaded);
+								positionsRepr, codePage);
 						} else {
 							surface->MeasureWidthsUTF8(vstyle.styles[StyleControlChar].font.get(), ts.representation->stringRep, positionsRepr);
 						}
@@ -433,7 +554,7 @@ void LayoutSegments(IPositionCache *pCache,
 					ll->positions[ts.start + 1] = vstyle.styles[ll->styles[ts.start]].spaceWidth;
 				} else {
 					pCache->MeasureWidths(surface, vstyle, ll->styles[ts.start],
-						std::string_view(&ll->chars[ts.start], ts.length), &ll->positions[ts.start + 1], multiThreaded);
+						std::string_view(&ll->chars[ts.start], ts.length), &ll->positions[ts.start + 1], codePage);
 				}
 			}
 		}
@@ -549,7 +670,7 @@ void EditView::LayoutLine(const EditModel &model, Surface *surface, const ViewSt
 
 			std::atomic<uint32_t> nextIndex = 0;
 
-			const bool textUnicode = CpUtf8 == model.pdoc->dbcsCodePage;
+			const int codePage = model.pdoc->dbcsCodePage;
 			const bool multiThreaded = threads > 1;
 			IPositionCache *pCache = posCache.get();
 
@@ -560,8 +681,8 @@ void EditView::LayoutLine(const EditModel &model, Surface *surface, const ViewSt
 			for (size_t th = 0; th < threads; th++) {
 				// Find relative positions of everything except for tabs
 				std::future<void> fut = std::async(policy,
-					[pCache, surface, &vstyle, &ll, &segments, &nextIndex, textUnicode, multiThreaded]() {
-					LayoutSegments(pCache, surface, vstyle, ll, segments, nextIndex, textUnicode, multiThreaded);
+					[pCache, surface, &vstyle, &ll, &segments, &nextIndex, codePage]() {
+					LayoutSegments(pCache, surface, vstyle, ll, segments, nextIndex, codePage);
 				});
 				futures.push_back(std::move(fut));
 			}
@@ -702,6 +823,82 @@ void EditView::LayoutLine(const EditModel &model, Surface *surface, const ViewSt
 	}
 }
 
+bool EditView::CanWrapConcurrently(Surface *surface, Sci::Line lines) const {
+	return (maxLayoutThreads > 1) &&
+		(lines >= linesPerWrapBlock * 2) &&
+		surface->SupportsFeature(Supports::ThreadSafeMeasureWidths);
+}
+
+namespace {
+
+// Allows the document to be read from several threads for as long as it is in scope.
+class ConcurrentReading {
+	Document *pdoc;
+public:
+	explicit ConcurrentReading(Document *pdoc_) noexcept : pdoc(pdoc_) {
+		pdoc->SetConcurrentReading(true);
+	}
+	// Deleted so ConcurrentReading objects can not be copied.
+	ConcurrentReading(const ConcurrentReading &) = delete;
+	ConcurrentReading(ConcurrentReading &&) = delete;
+	void operator=(const ConcurrentReading &) = delete;
+	void operator=(ConcurrentReading &&) = delete;
+	~ConcurrentReading() {
+		pdoc->SetConcurrentReading(false);
+	}
+};
+
+}
+
+/**
+* Lay out the lines from @a lineStart up to @a lineEnd at @a width on several threads,
+* returning the number of sub-lines for each line.
+* The document and styles must not change until this returns, which is ensured by
+* waiting for all the threads.
+* The layout cache is not used as it can not be shared between threads and these are
+* usually lines that are not on screen.
+*/
+std::vector<int> EditView::WrapLinesConcurrently(const EditModel &model, Surface *surface, const ViewStyle &vstyle,
+	Sci::Line lineStart, Sci::Line lineEnd, int width) {
+	const Sci::Line lines = lineEnd - lineStart;
+	std::vector<int> linesWrapped(lines, 1);
+	const Sci::Line blocks = (lines + linesPerWrapBlock - 1) / linesPerWrapBlock;
+	const size_t threads = std::min<size_t>(maxLayoutThreads, blocks);
+
+	std::atomic<Sci::Line> nextBlock = 0;
+	auto wrapBlocks = [this, &model, surface, &vstyle, lineStart, lineEnd, width, blocks, &nextBlock, &linesWrapped]() {
+		LineLayout ll(-1, 200);
+		while (true) {
+			const Sci::Line block = nextBlock.fetch_add(1, std::memory_order_acq_rel);
+			if (block >= blocks) {
+				break;
+			}
+			const Sci::Line lineFirst = lineStart + block * linesPerWrapBlock;
+			const Sci::Line lineLast = std::min(lineFirst + linesPerWrapBlock, lineEnd);
+			for (Sci::Line line = lineFirst; line < lineLast; line++) {
+				const Sci::Position lengthLine = model.pdoc->LineStart(line + 1) - model.pdoc->LineStart(line);
+				ll.Reuse(line, static_cast<int>(lengthLine));
+				LayoutLine(model, surface, vstyle, &ll, width);
+				linesWrapped[line - lineStart] = ll.lines;
+			}
+		}
+	};
+
+	// Declared before the futures so the other threads have finished before it is released
+	const ConcurrentReading concurrentReading(model.pdoc);
+
+	// The calling thread takes blocks as well
+	std::vector<std::future<void>> futures;
+	for (size_t th = 1; th < threads; th++) {
+		futures.push_back(std::async(std::launch::async, wrapBlocks));
+	}
+	wrapBlocks();
+	for (std::future<void> &f : futures) {
+		f.get();
+	}
+	return linesWrapped;
+}
+
 // Fill the LineLayout bidirectional data fields according to each char style
 
 void EditView::UpdateBidiData(const EditModel &model, const ViewStyle &vstyle, LineLayout *ll) {
@@ -2436,8 +2633,26 @@ void EditView::PaintText(Surface *surfaceWindow, const EditModel &model, PRectan
 	// Do the painting
 	if (rcArea.right > vsDraw.textStart - leftTextOverlap) {
 
+		// Keep images of lines when enough fit in the budget to cover the window
+		const int linePixmapWidth = static_cast<int>(rcClient.Width());
+		const size_t linePixmapBytes = static_cast<size_t>(linePixmapWidth) * vsDraw.lineHeight * 4;
+		const size_t linePixmapsMax = linePixmapBytes ? linePixmapBudget / linePixmapBytes : 0;
+		const bool cachingLines = (phasesDraw != PhasesDraw::Multiple) &&
+			(linePixmapsMax > static_cast<size_t>(model.LinesOnScreen()) + 1);
+		if (cachingLines) {
+			const size_t viewSignature = LinePixmapsViewSignature(model, vsDraw, rcClient);
+			if (viewSignature != linePixmapsViewSignature) {
+				InvalidateLinePixmaps();
+				linePixmapsViewSignature = viewSignature;
+			}
+		} else {
+			InvalidateLinePixmaps();
+		}
+		// Lines are drawn separately then copied to the window
+		const bool lineBuffered = bufferedDraw || cachingLines;
+
 		Surface *surface = surfaceWindow;
-		if (bufferedDraw) {
+		if (bufferedDraw && !cachingLines) {
 			surface = pixmapLine.get();
 			PLATFORM_ASSERT(pixmapLine->Initialised());
 		}
@@ -2462,7 +2677,7 @@ void EditView::PaintText(Surface *surfaceWindow, const EditModel &model, PRectan
 
 		// Remove selection margin from drawing area so text will not be drawn
 		// on it in unbuffered mode.
-		const bool clipping = !bufferedDraw && vsDraw.marginInside;
+		const bool clipping = !lineBuffered && vsDraw.marginInside;
 		if (clipping) {
 			PRectangle rcClipText = rcTextArea;
 			rcClipText.left -= leftTextOverlap;
@@ -2482,7 +2697,7 @@ void EditView::PaintText(Surface *surfaceWindow, const EditModel &model, PRectan
 		Sci::Line lineDocPrevious = -1;	// Used to avoid laying out one document line multiple times
 		std::shared_ptr<LineLayout> ll;
 		std::vector<DrawPhase> phases;
-		if ((phasesDraw == PhasesDraw::Multiple) && !bufferedDraw) {
+		if ((phasesDraw == PhasesDraw::Multiple) && !lineBuffered) {
 			for (DrawPhase phase = DrawPhase::back; phase <= DrawPhase::carets; phase = static_cast<DrawPhase>(static_cast<int>(phase) * 2)) {
 				phases.push_back(phase);
 			}
@@ -2491,7 +2706,7 @@ void EditView::PaintText(Surface *surfaceWindow, const EditModel &model, PRectan
 		}
 		for (const DrawPhase &phase : phases) {
 			int ypos = 0;
-			if (!bufferedDraw)
+			if (!lineBuffered)
 				ypos += screenLinePaintFirst * vsDraw.lineHeight;
 			int yposScreen = screenLinePaintFirst * vsDraw.lineHeight;
 			Sci::Line visibleLine = model.TopLineOfMain() + screenLinePaintFirst;
@@ -2503,6 +2718,30 @@ void EditView::PaintText(Surface *surfaceWindow, const EditModel &model, PRectan
 				const Sci::Line lineStartSet = model.pcs->DisplayFromDoc(lineDoc);
 				const int subLine = static_cast<int>(visibleLine - lineStartSet);
 
+				LinePixmap *linePixmap = nullptr;
+				if (cachingLines) {
+					const size_t signature = LinePixmapSignature(model, lineDoc);
+					linePixmap = FindLinePixmap(lineDoc, subLine, signature);
+					if (linePixmap) {
+						// Unchanged since it was last drawn so just copy it
+						const Point from = Point::FromInts(vsDraw.textStart - leftTextOverlap, 0);
+						const PRectangle rcCopyArea = PRectangle::FromInts(vsDraw.textStart - leftTextOverlap, yposScreen,
+							static_cast<int>(rcClient.right - vsDraw.rightMarginWidth),
+							yposScreen + vsDraw.lineHeight);
+						surfaceWindow->Copy(rcCopyArea, from, *linePixmap->pixmap);
+						lineWidthMaxSeen = std::max(lineWidthMaxSeen, linePixmap->lineWidth);
+						yposScreen += vsDraw.lineHeight;
+						visibleLine++;
+						continue;
+					}
+					linePixmap = &AddLinePixmap(lineDoc, subLine, signature, linePixmapsMax);
+					if (!linePixmap->pixmap) {
+						linePixmap->pixmap = surfaceWindow->AllocatePixMap(linePixmapWidth, vsDraw.lineHeight);
+					}
+					surface = linePixmap->pixmap.get();
+					surface->SetMode(SurfaceMode(model.pdoc->dbcsCodePage, model.BidirectionalR2L()));
+				}
+
 				// Copy this line and its styles from the document into local arrays
 				// and determine the x position at which each character starts.
 #if defined(TIME_PAINTING)
@@ -2531,7 +2770,7 @@ void EditView::PaintText(Surface *surfaceWindow, const EditModel &model, PRectan
 					ll->SetBracesHighlight(rangeLine, model.braces, static_cast<char>(model.bracesMatchStyle),
 						static_cast<int>(model.highlightGuideColumn * vsDraw.spaceWidth), bracesIgnoreStyle);
 
-					if (leftTextOverlap && (bufferedDraw || ((phasesDraw < PhasesDraw::Multiple) && (FlagSet(phase, DrawPhase::back))))) {
+					if (leftTextOverlap && (lineBuffered || ((phasesDraw < PhasesDraw::Multiple) && (FlagSet(phase, DrawPhase::back))))) {
 						// Clear the left margin
 						PRectangle rcSpacer = rcLine;
 						rcSpacer.right = rcSpacer.left;
@@ -2559,23 +2798,28 @@ void EditView::PaintText(Surface *surfaceWindow, const EditModel &model, PRectan
 						DrawCarets(surface, model, vsDraw, ll.get(), lineDoc, xStart, rcLine, subLine);
 					}
 
-					if (bufferedDraw) {
+					if (lineBuffered) {
 						const Point from = Point::FromInts(vsDraw.textStart - leftTextOverlap, 0);
 						const PRectangle rcCopyArea = PRectangle::FromInts(vsDraw.textStart - leftTextOverlap, yposScreen,
 							static_cast<int>(rcClient.right - vsDraw.rightMarginWidth),
 							yposScreen + vsDraw.lineHeight);
-						pixmapLine->FlushDrawing();
-						surfaceWindow->Copy(rcCopyArea, from, *pixmapLine);
+						surface->FlushDrawing();
+						surfaceWindow->Copy(rcCopyArea, from, *surface);
 					}
 
 					lineWidthMaxSeen = std::max(
 						lineWidthMaxSeen, static_cast<int>(ll->positions[ll->numCharsInLine]));
+					if (linePixmap) {
+						linePixmap->lineWidth = static_cast<int>(ll->positions[ll->numCharsInLine]);
+					}
 #if defined(TIME_PAINTING)
 					durCopy += ep.Duration(true);
 #endif
+				} else if (linePixmap) {
+					InvalidateLinePixmaps(lineDoc, lineDoc);
 				}
 
-				if (!bufferedDraw) {
+				if (!lineBuffered) {
 					ypos += vsDraw.lineHeight;
 				}
 
@@ -47,6 +47,19 @@ typedef void (*DrawTabArrowFn)(Surface *surface, PRectangle rcTab, int ymid,
 
 class LineTabstops;
 
+/**
+* An image of one display line kept so that it can be copied to the window again instead of
+* being laid out and drawn while nothing that changes its appearance has happened.
+*/
+struct LinePixmap {
+	Sci::Line lineDoc = 0;
+	int subLine = 0;
+	size_t signature = 0;	///< Selection, caret and brace state that applied to the line
+	int lineWidth = 0;	///< Width of the line's text for lineWidthMaxSeen
+	unsigned int lastUsed = 0;
+	std::unique_ptr<Surface> pixmap;
+};
+
 /**
 * EditView draws the main text area.
 */
@@ -83,8 +96,17 @@ public:
 	LineLayoutCache llc;
 	std::unique_ptr<IPositionCache> posCache;
 
+	/** Images of recently drawn lines limited to approximately linePixmapBudget bytes.
+	* Lines are only cached when linePixmapBudget is non-zero and multiple phase drawing is off. */
+	size_t linePixmapBudget;
+	std::vector<LinePixmap> linePixmaps;
+	size_t linePixmapsViewSignature;	///< State that applies to every cached line
+	unsigned int linePixmapsClock;
+
 	unsigned int maxLayoutThreads;
 	static constexpr int bytesPerLayoutThread = 1000;
+	// Lines are handed out to wrapping threads in blocks to reduce contention
+	static constexpr Sci::Line linesPerWrapBlock = 64;
 
 	int tabArrowHeight; // draw arrow heads this many pixels above/below line midpoint
 	/** Some platforms, notably PLAT_CURSES, do not support Scintilla's native
@@ -117,11 +139,19 @@ public:
 	void LinesAddedOrRemoved(Sci::Line lineOfPos, Sci::Line linesAdded);
 
 	void DropGraphics() noexcept;
+
+	void SetLinePixmapBudget(size_t budget) noexcept;
+	size_t GetLinePixmapBudget() const noexcept { return linePixmapBudget; }
+	void InvalidateLinePixmaps() noexcept;
+	void InvalidateLinePixmaps(Sci::Line lineFirst, Sci::Line lineLast) noexcept;
 	void RefreshPixMaps(Surface *surfaceWindow, const ViewStyle &vsDraw);
 
 	std::shared_ptr<LineLayout> RetrieveLineLayout(Sci::Line lineNumber, const EditModel &model);
 	void LayoutLine(const EditModel &model, Surface *surface, const ViewStyle &vstyle,
 		LineLayout *ll, int width);
+	bool CanWrapConcurrently(Surface *surface, Sci::Line lines) const;
+	std::vector<int> WrapLinesConcurrently(const EditModel &model, Surface *surface, const ViewStyle &vstyle,
+		Sci::Line lineStart, Sci::Line lineEnd, int width);
 
 	static void UpdateBidiData(const EditModel &model, const ViewStyle &vstyle, LineLayout *ll);
 
@@ -156,6 +186,10 @@ public:
 		Sci::Line line, Sci::Line lineVisible, PRectangle rcLine, int xStart, int subLine);
 	void DrawLine(Surface *surface, const EditModel &model, const ViewStyle &vsDraw, const LineLayout *ll, Sci::Line line,
 		Sci::Line lineVisible, int xStart, PRectangle rcLine, int subLine, DrawPhase phase);
+	size_t LinePixmapsViewSignature(const EditModel &model, const ViewStyle &vsDraw, PRectangle rcClient) const noexcept;
+	size_t LinePixmapSignature(const EditModel &model, Sci::Line lineDoc) const noexcept;
+	LinePixmap *FindLinePixmap(Sci::Line lineDoc, int subLine, size_t signature) noexcept;
+	LinePixmap &AddLinePixmap(Sci::Line lineDoc, int subLine, size_t signature, size_t maxLines);
 	void PaintText(Surface *surfaceWindow, const EditModel &model, PRectangle rcArea, PRectangle rcClient,
 		const ViewStyle &vsDraw);
 	void FillLineRemainder(Surface *surface, const EditModel &model, const ViewStyle &vsDraw, const LineLayout *ll,
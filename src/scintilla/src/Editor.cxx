@@ -188,6 +188,8 @@ Editor::Editor() : durationWrapOneByte(0.000001, 0.00000001, 0.00001) {
 	willRedrawAll = false;
 	idleStyling = IdleStyling::None;
 	needIdleStyling = false;
+	needIdleLayout = false;
+	scrollDirection = 1;
 
 	modEventMask = ModificationFlags::EventMaskAll;
 	commandEvents = true;
@@ -439,8 +441,14 @@ Sci::Line Editor::LineFromLocation(Point pt) const {
 
 void Editor::SetTopLine(Sci::Line topLineNew) {
 	if ((topLine != topLineNew) && (topLineNew >= 0)) {
+		scrollDirection = (topLineNew > topLine) ? 1 : -1;
 		topLine = topLineNew;
 		ContainerNeedsUpdate(Update::VScroll);
+		if (view.llc.Budgeted()) {
+			// Lay out the next page while idle as there is room for it in the cache
+			needIdleLayout = true;
+			SetIdle(true);
+		}
 	}
 	posTopLine = pdoc->LineStart(pcs->DocFromDisplay(topLine));
 }
@@ -480,6 +488,10 @@ void Editor::DiscardOverdraw() {
 }
 
 void Editor::Redraw() {
+	// Scrolling only moves lines so their images can still be used
+	if (!willRedrawAll) {
+		view.InvalidateLinePixmaps();
+	}
 	if (redrawPendingText) {
 		return;
 	}
@@ -565,6 +577,8 @@ PRectangle Editor::RectangleFromRange(Range r, int overlap) {
 }
 
 void Editor::InvalidateRange(Sci::Position start, Sci::Position end) {
+	view.InvalidateLinePixmaps(pdoc->SciLineFromPosition(std::min(start, end)),
+		pdoc->SciLineFromPosition(std::max(start, end)));
 	if (redrawPendingText) {
 		return;
 	}
@@ -1589,12 +1603,29 @@ bool Editor::WrapLines(WrapScope ws) {
 
 				const size_t bytesBeingWrapped = pdoc->LineStart(lineToWrapEnd) - pdoc->LineStart(lineToWrap);
 				ElapsedPeriod epWrapping;
-				while (lineToWrap < lineToWrapEnd) {
-					if (WrapOneLine(surface, lineToWrap)) {
-						wrapOccurred = true;
+				if (view.CanWrapConcurrently(surface, lineToWrapEnd - lineToWrap)) {
+					// Measure on several threads then apply the heights here
+					const std::vector<int> subLines = view.WrapLinesConcurrently(*this, surface, vs,
+						lineToWrap, lineToWrapEnd, wrapWidth);
+					for (const int linesLayout : subLines) {
+						int linesWrapped = linesLayout;
+						if (vs.annotationVisible != AnnotationVisible::Hidden) {
+							linesWrapped += pdoc->AnnotationLines(lineToWrap);
+						}
+						if (pcs->SetHeight(lineToWrap, linesWrapped)) {
+							wrapOccurred = true;
+						}
+						wrapPending.Wrapped(lineToWrap);
+						lineToWrap++;
+					}
+				} else {
+					while (lineToWrap < lineToWrapEnd) {
+						if (WrapOneLine(surface, lineToWrap)) {
+							wrapOccurred = true;
+						}
+						wrapPending.Wrapped(lineToWrap);
+						lineToWrap++;
 					}
-					wrapPending.Wrapped(lineToWrap);
-					lineToWrap++;
 				}
 				durationWrapOneByte.AddSample(bytesBeingWrapped, epWrapping.Duration());
 
@@ -2167,6 +2198,7 @@ void Editor::ClearAll() {
 
 void Editor::ClearDocumentStyle() {
 	pdoc->decorations->DeleteLexerDecorations();
+	pdoc->DiscardCheckpoints(0, pdoc->Length());
 	pdoc->StartStyling(0);
 	pdoc->SetStyleFor(pdoc->Length(), 0);
 	pcs->ShowAll();
@@ -2594,6 +2626,26 @@ constexpr Sci::Position MovePositionForDeletion(Sci::Position position, Sci::Pos
 
 void Editor::NotifyModified(Document *, DocModification mh, void *) {
 	ContainerNeedsUpdate(Update::Content);
+	// Line images are dropped even while painting as styling can change lines drawn earlier
+	if ((mh.linesAdded != 0) ||
+		(FlagSet(mh.modificationType, ModificationFlags::InsertText | ModificationFlags::DeleteText) &&
+		(vs.viewIndentationGuides == IndentView::LookForward || vs.viewIndentationGuides == IndentView::LookBoth))) {
+		// Line numbers moved or guides on blank lines may depend on the changed line
+		view.InvalidateLinePixmaps();
+	} else if (FlagSet(mh.modificationType, ModificationFlags::ChangeMarker | ModificationFlags::ChangeFold |
+		ModificationFlags::ChangeLineState | ModificationFlags::ChangeMargin |
+		ModificationFlags::ChangeAnnotation | ModificationFlags::ChangeEOLAnnotation)) {
+		if (mh.line < 0) {
+			view.InvalidateLinePixmaps();
+		} else {
+			view.InvalidateLinePixmaps(mh.line, mh.line);
+		}
+	} else if (FlagSet(mh.modificationType, ModificationFlags::InsertText | ModificationFlags::DeleteText |
+		ModificationFlags::ChangeStyle | ModificationFlags::ChangeIndicator | ModificationFlags::LexerState)) {
+		const Sci::Position endChange = FlagSet(mh.modificationType, ModificationFlags::DeleteText) ?
+			mh.position : mh.position + mh.length;
+		view.InvalidateLinePixmaps(pdoc->SciLineFromPosition(mh.position), pdoc->SciLineFromPosition(endChange));
+	}
 	if (paintState == PaintState::painting) {
 		CheckForChangeOutsidePaint(Range(mh.position, mh.position + mh.length));
 	}
@@ -4123,6 +4175,37 @@ Sci::Position Editor::FindText(
 	}
 }
 
+/**
+ * Search of a text in the document, in the given range.
+ * @return The position of the found text, -1 if not found.
+ */
+Sci::Position Editor::FindTextFull(
+    uptr_t wParam,		///< Search modes : @c FindOption::MatchCase, @c FindOption::WholeWord,
+    ///< @c FindOption::WordStart, @c FindOption::RegExp or @c FindOption::Posix.
+    sptr_t lParam) {	///< @c Sci_TextToFindFull structure: The text to search for in the given range.
+
+	TextToFindFull *ft = static_cast<TextToFindFull *>(PtrFromSPtr(lParam));
+	Sci::Position lengthFound = strlen(ft->lpstrText);
+	if (!pdoc->HasCaseFolder())
+		pdoc->SetCaseFolder(CaseFolderForEncoding());
+	try {
+		const Sci::Position pos = pdoc->FindText(
+			ft->chrg.cpMin,
+			ft->chrg.cpMax,
+			ft->lpstrText,
+			static_cast<FindOption>(wParam),
+			&lengthFound);
+		if (pos != -1) {
+			ft->chrgText.cpMin = pos;
+			ft->chrgText.cpMax = pos + lengthFound;
+		}
+		return pos;
+	} catch (RegexError &) {
+		errorStatus = Status::RegEx;
+		return -1;
+	}
+}
+
 /**
  * Relocatable search support : Searches relative to current selection
  * point and sets the selection to the found text range with
@@ -5032,6 +5115,8 @@ bool Editor::Idle() {
 		needWrap = wrapPending.NeedsWrap();
 	} else if (needIdleStyling) {
 		IdleStyle();
+	} else if (needIdleLayout) {
+		IdleLayout();
 	}
 
 	// Add more idle things to do here, but make sure idleDone is
@@ -5039,7 +5124,7 @@ bool Editor::Idle() {
 	// false will stop calling this idle function until SetIdle() is
 	// called again.
 
-	const bool idleDone = !needWrap && !needIdleStyling; // && thatDone && theOtherThingDone...
+	const bool idleDone = !needWrap && !needIdleStyling && !needIdleLayout; // && thatDone && theOtherThingDone...
 
 	return !idleDone;
 }
@@ -5199,6 +5284,41 @@ void Editor::IdleStyle() {
 	}
 }
 
+void Editor::IdleLayout() {
+	// Lay out the page after the visible lines in the direction of the last scroll so
+	// continuing to scroll finds the layouts in the cache.
+	needIdleLayout = false;
+	const Sci::Line linesOnScreen = LinesOnScreen();
+	const Sci::Line displayStart = (scrollDirection > 0) ?
+		topLine + linesOnScreen + 1 : topLine - linesOnScreen - 1;
+	const Sci::Line displayEnd = displayStart + linesOnScreen;
+	if ((displayEnd < 0) || (displayStart >= pcs->LinesDisplayed())) {
+		return;
+	}
+	// Styling here would hold up scrolling so only lines that are already styled are laid out,
+	// layouts of the others would be thrown away once they were styled anyway.
+	const Sci::Position endStyled = pdoc->GetEndStyled();
+	const Sci::Line lineStyledEnd = (endStyled >= pdoc->Length()) ?
+		pdoc->LinesTotal() - 1 : pdoc->SciLineFromPosition(endStyled) - 1;
+	const Sci::Line lineDocStart = pcs->DocFromDisplay(std::max<Sci::Line>(displayStart, 0));
+	const Sci::Line lineDocEnd = std::min(pcs->DocFromDisplay(displayEnd), lineStyledEnd);
+	if (lineDocEnd < lineDocStart) {
+		return;
+	}
+	AutoSurface surface(this);
+	if (!surface) {
+		return;
+	}
+	for (Sci::Line line = lineDocStart; line <= lineDocEnd; line++) {
+		if (pcs->GetVisible(line)) {
+			std::shared_ptr<LineLayout> ll = view.RetrieveLineLayout(line, *this);
+			if (ll) {
+				view.LayoutLine(*this, surface, vs, ll.get(), wrapWidth);
+			}
+		}
+	}
+}
+
 void Editor::IdleWork() {
 	// Style the line after the modification as this allows modifications that change just the
 	// line of the modification to heal instead of propagating to the rest of the window.
@@ -5544,26 +5664,41 @@ void Editor::FoldAll(FoldAction action) {
 			}
 		}
 	}
+	// Gather the lines to change so the fold state is updated in one pass over each line
+	// list rather than one line at a time, which is slow for large documents
+	std::vector<Sci::Line> headers;
+	std::vector<Sci::Line> hidden;
 	if (expanding) {
-		pcs->SetVisible(0, maxLine-1, true);
-		for (int line = 0; line < maxLine; line++) {
-			const FoldLevel levelLine = pdoc->GetFoldLevel(line);
-			if (LevelIsHeader(levelLine)) {
-				SetFoldExpanded(line, true);
+		for (Sci::Line line = 0; line < maxLine; line++) {
+			if (LevelIsHeader(pdoc->GetFoldLevel(line))) {
+				headers.push_back(line);
+				headers.push_back(1);
 			}
 		}
+		const Sci::Line all[] = { 0, maxLine };
+		pcs->SetVisibleRanges(all, 1, true);
+		pcs->SetExpandedRanges(headers.data(), headers.size() / 2, true);
 	} else {
 		for (Sci::Line line = 0; line < maxLine; line++) {
 			const FoldLevel level = pdoc->GetFoldLevel(line);
 			if (LevelIsHeader(level) &&
 					(FoldLevel::Base == LevelNumberPart(level))) {
-				SetFoldExpanded(line, false);
+				headers.push_back(line);
+				headers.push_back(1);
 				const Sci::Line lineMaxSubord = pdoc->GetLastChild(line);
 				if (lineMaxSubord > line) {
-					pcs->SetVisible(line + 1, lineMaxSubord, false);
+					if (!hidden.empty() && (line < hidden[hidden.size() - 2] + hidden.back())) {
+						// Whitespace header inside the previous fold
+						hidden.back() = std::max(hidden.back(), lineMaxSubord + 1 - hidden[hidden.size() - 2]);
+					} else {
+						hidden.push_back(line + 1);
+						hidden.push_back(lineMaxSubord - line);
+					}
 				}
 			}
 		}
+		pcs->SetExpandedRanges(headers.data(), headers.size() / 2, false);
+		pcs->SetVisibleRanges(hidden.data(), hidden.size() / 2, false);
 	}
 	SetScrollBars();
 	Redraw();
@@ -5649,6 +5784,28 @@ Sci::Position Editor::GetTag(char *tagValue, int tagNumber) {
 	return length;
 }
 
+Sci::Position Editor::GetTextRange(char *buffer, Sci::Position cpMin, Sci::Position cpMax) const {
+	if (cpMax == -1)
+		cpMax = pdoc->Length();
+	PLATFORM_ASSERT(cpMax <= pdoc->Length());
+	const Sci::Position len = cpMax - cpMin; 	// No -1 as cpMin and cpMax are referring to inter character positions
+	pdoc->GetCharRange(buffer, cpMin, len);
+	// Spec says copied text is terminated with a NUL
+	buffer[len] = '\0';
+	return len; 	// Not including NUL
+}
+
+Sci::Position Editor::GetStyledText(char *buffer, Sci::Position cpMin, Sci::Position cpMax) const noexcept {
+	Sci::Position iPlace = 0;
+	for (Sci::Position iChar = cpMin; iChar < cpMax; iChar++) {
+		buffer[iPlace++] = pdoc->CharAt(iChar);
+		buffer[iPlace++] = pdoc->StyleAt(iChar);
+	}
+	buffer[iPlace] = '\0';
+	buffer[iPlace + 1] = '\0';
+	return iPlace;
+}
+
 Sci::Position Editor::ReplaceTarget(bool replacePatterns, const char *text, Sci::Position length) {
 	UndoGroup ug(pdoc);
 	if (length == -1)
@@ -6226,20 +6383,20 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::FindText:
 		return FindText(wParam, lParam);
 
-	case Message::GetTextRange: {
-			if (lParam == 0)
-				return 0;
-			TextRange *tr = static_cast<TextRange *>(PtrFromSPtr(lParam));
-			Sci::Position cpMax = static_cast<Sci::Position>(tr->chrg.cpMax);
-			if (cpMax == -1)
-				cpMax = pdoc->Length();
-			PLATFORM_ASSERT(cpMax <= pdoc->Length());
-			Sci::Position len = cpMax - tr->chrg.cpMin; 	// No -1 as cpMin and cpMax are referring to inter character positions
-			pdoc->GetCharRange(tr->lpstrText, tr->chrg.cpMin, len);
-			// Spec says copied text is terminated with a NUL
-			tr->lpstrText[len] = '\0';
-			return len; 	// Not including NUL
+	case Message::FindTextFull:
+		return FindTextFull(wParam, lParam);
+
+	case Message::GetTextRange:
+		if (TextRange *tr = static_cast<TextRange *>(PtrFromSPtr(lParam))) {
+			return GetTextRange(tr->lpstrText, tr->chrg.cpMin, tr->chrg.cpMax);
 		}
+		return 0;
+
+	case Message::GetTextRangeFull:
+		if (TextRangeFull *tr = static_cast<TextRangeFull *>(PtrFromSPtr(lParam))) {
+			return GetTextRange(tr->lpstrText, tr->chrg.cpMin, tr->chrg.cpMax);
+		}
+		return 0;
 
 	case Message::HideSelection:
 		view.hideSelection = wParam != 0;
@@ -6326,6 +6483,62 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::GetUndoCollection:
 		return pdoc->IsCollectingUndo();
 
+	case Message::SetUndoMemoryLimit:
+		pdoc->SetUndoMemoryLimit(wParam);
+		return 0;
+
+	case Message::GetUndoMemoryLimit:
+		return pdoc->UndoMemoryLimit();
+
+	case Message::GetUndoMemory:
+		return pdoc->UndoMemory();
+
+	case Message::GetModificationCount:
+		return pdoc->ModificationCount();
+
+	case Message::GetUndoActions:
+		return pdoc->UndoActions();
+
+	case Message::SetUndoSavePoint:
+		pdoc->SetUndoSavePoint(static_cast<int>(wParam));
+		return 0;
+
+	case Message::GetUndoSavePoint:
+		return pdoc->UndoSavePoint();
+
+	case Message::SetUndoCurrent:
+		pdoc->SetUndoCurrent(static_cast<int>(wParam));
+		return 0;
+
+	case Message::GetUndoCurrent:
+		return pdoc->UndoCurrent();
+
+	case Message::PushUndoActionType: {
+			const int type = static_cast<int>(wParam) & ~static_cast<int>(UndoActionType::MayCoalesce);
+			if (type >= 0 && type <= static_cast<int>(UndoActionType::Container)) {
+				pdoc->PushUndoAction(static_cast<ActionType>(type), lParam,
+					FlagSet(static_cast<UndoActionType>(wParam), UndoActionType::MayCoalesce));
+			}
+		}
+		return 0;
+
+	case Message::ChangeLastUndoActionText:
+		pdoc->ChangeLastUndoActionText(ConstCharPtrFromSPtr(lParam), PositionFromUPtr(wParam));
+		return 0;
+
+	case Message::GetUndoActionType: {
+			const Action action = pdoc->GetUndoAction(static_cast<int>(wParam));
+			return static_cast<int>(action.at) | (action.mayCoalesce ? static_cast<int>(UndoActionType::MayCoalesce) : 0);
+		}
+
+	case Message::GetUndoActionPosition:
+		return pdoc->GetUndoAction(static_cast<int>(wParam)).position;
+
+	case Message::GetUndoActionText: {
+			const Action action = pdoc->GetUndoAction(static_cast<int>(wParam));
+			return BytesResult(lParam, reinterpret_cast<const unsigned char *>(action.data), action.lenData);
+		}
+
 	case Message::BeginUndoAction:
 		pdoc->BeginUndoAction();
 		return 0;
@@ -6476,19 +6689,17 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 		pdoc->SetSavePoint();
 		break;
 
-	case Message::GetStyledText: {
-			if (lParam == 0)
-				return 0;
-			TextRange *tr = static_cast<TextRange *>(PtrFromSPtr(lParam));
-			Sci::Position iPlace = 0;
-			for (Sci::Position iChar = tr->chrg.cpMin; iChar < tr->chrg.cpMax; iChar++) {
-				tr->lpstrText[iPlace++] = pdoc->CharAt(iChar);
-				tr->lpstrText[iPlace++] = pdoc->StyleAt(iChar);
-			}
-			tr->lpstrText[iPlace] = '\0';
-			tr->lpstrText[iPlace + 1] = '\0';
-			return iPlace;
+	case Message::GetStyledText:
+		if (TextRange *tr = static_cast<TextRange *>(PtrFromSPtr(lParam))) {
+			return GetStyledText(tr->lpstrText, tr->chrg.cpMin, tr->chrg.cpMax);
+		}
+		return 0;
+
+	case Message::GetStyledTextFull:
+		if (TextRangeFull *tr = static_cast<TextRangeFull *>(PtrFromSPtr(lParam))) {
+			return GetStyledText(tr->lpstrText, tr->chrg.cpMin, tr->chrg.cpMax);
 		}
+		return 0;
 
 	case Message::CanRedo:
 		return (pdoc->CanRedo() && !pdoc->IsReadOnly()) ? 1 : 0;
@@ -6597,16 +6808,25 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::SetStyling:
 		if (PositionFromUPtr(wParam) < 0)
 			errorStatus = Status::Failure;
-		else
+		else {
+			// Checkpoints still describe styles that are set to what they already were
+			if (!pdoc->StyleMatches(pdoc->GetEndStyled(), PositionFromUPtr(wParam), static_cast<char>(lParam)))
+				pdoc->DiscardCheckpoints(pdoc->GetEndStyled(), PositionFromUPtr(wParam));
 			pdoc->SetStyleFor(PositionFromUPtr(wParam), static_cast<char>(lParam));
+		}
 		break;
 
 	case Message::SetStylingEx:             // Specify a complete styling buffer
 		if (lParam == 0)
 			return 0;
+		if (!pdoc->StylesMatch(pdoc->GetEndStyled(), PositionFromUPtr(wParam), ConstCharPtrFromSPtr(lParam)))
+			pdoc->DiscardCheckpoints(pdoc->GetEndStyled(), PositionFromUPtr(wParam));
 		pdoc->SetStyles(PositionFromUPtr(wParam), ConstCharPtrFromSPtr(lParam));
 		break;
 
+	case Message::SetStylingCheckpoint:
+		return pdoc->StylingCheckpoint(ConstCharPtrFromSPtr(lParam), PositionFromUPtr(wParam));
+
 	case Message::SetBufferedDraw:
 		view.bufferedDraw = wParam != 0;
 		break;
@@ -6746,6 +6966,21 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::GetIdleStyling:
 		return static_cast<sptr_t>(idleStyling);
 
+	case Message::GetIdleTasks: {
+			IdleTask tasks = IdleTask::None;
+			if (Wrapping() && wrapPending.NeedsWrap())
+				tasks |= IdleTask::Wrap;
+			if (needIdleStyling)
+				tasks |= IdleTask::Style;
+			if (needIdleLayout)
+				tasks |= IdleTask::Layout;
+			if (workNeeded.items != WorkItems::none)
+				tasks |= IdleTask::Queued;
+			if (idler.state)
+				tasks |= IdleTask::Active;
+			return static_cast<sptr_t>(tasks);
+		}
+
 	case Message::SetWrapMode:
 		if (vs.SetWrapState(static_cast<Wrap>(wParam))) {
 			xOffset = 0;
@@ -6806,6 +7041,29 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::GetLayoutCache:
 		return static_cast<sptr_t>(view.llc.GetLevel());
 
+	case Message::SetLayoutCacheBudget:
+		view.llc.SetBudget(wParam);
+		Redraw();
+		break;
+
+	case Message::GetLayoutCacheBudget:
+		return view.llc.GetBudget();
+
+	case Message::SetLinePixmapCacheBudget:
+		view.SetLinePixmapBudget(wParam);
+		Redraw();
+		break;
+
+	case Message::GetLinePixmapCacheBudget:
+		return view.GetLinePixmapBudget();
+
+	case Message::GetLayoutCacheStatistic:
+		return view.llc.Statistic(static_cast<LayoutCacheStatistic>(wParam));
+
+	case Message::ResetLayoutCacheStatistics:
+		view.llc.ResetStatistics();
+		break;
+
 	case Message::SetPositionCache:
 		view.posCache->SetSize(wParam);
 		break;
@@ -6813,6 +7071,13 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::GetPositionCache:
 		return view.posCache->GetSize();
 
+	case Message::GetPositionCacheStatistic:
+		return view.posCache->Statistic(static_cast<LayoutCacheStatistic>(wParam));
+
+	case Message::ResetPositionCacheStatistics:
+		view.posCache->ResetStatistics();
+		break;
+
 	case Message::SetLayoutThreads:
 		view.SetLayoutThreads(static_cast<unsigned int>(wParam));
 		break;
@@ -7756,12 +8021,30 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 			lParam);
 		break;
 
+	case Message::IndicatorFillRanges:
+		pdoc->DecorationFillRanges(static_cast<const Sci::Position *>(PtrFromSPtr(lParam)), wParam,
+			pdoc->decorations->GetCurrentValue(), false);
+		break;
+
+	case Message::IndicatorReplaceRanges:
+		pdoc->DecorationFillRanges(static_cast<const Sci::Position *>(PtrFromSPtr(lParam)), wParam,
+			pdoc->decorations->GetCurrentValue(), true);
+		break;
+
 	case Message::IndicatorAllOnFor:
 		return pdoc->decorations->AllOnFor(PositionFromUPtr(wParam));
 
 	case Message::IndicatorValueAt:
 		return pdoc->decorations->ValueAt(static_cast<int>(wParam), lParam);
 
+	case Message::GetIndicatorRuns:
+		for (const IDecoration *deco : pdoc->decorations->View()) {
+			if (deco->Indicator() == static_cast<int>(wParam)) {
+				return deco->Runs();
+			}
+		}
+		return 0;
+
 	case Message::IndicatorStart:
 		return pdoc->decorations->Start(static_cast<int>(wParam), lParam);
 
@@ -8257,6 +8540,17 @@ sptr_t Editor::WndProc(Message iMessage, uptr_t wParam, sptr_t lParam) {
 	case Message::GetGapPosition:
 		return pdoc->GapPosition();
 
+	case Message::GetTextSegment: {
+			const Sci::Position pos = PositionFromUPtr(wParam);
+			Sci_Position segmentStart = 0;
+			Sci_Position segmentEnd = 0;
+			const char *segment = pdoc->TextSegment(pos, &segmentStart, &segmentEnd);
+			Sci_Position *length = static_cast<Sci_Position *>(PtrFromSPtr(lParam));
+			if (length)
+				*length = segment ? segmentEnd - pos : 0;
+			return segment ? reinterpret_cast<sptr_t>(segment + (pos - segmentStart)) : 0;
+		}
+
 	case Message::SetExtraAscent:
 		vs.extraAscent = static_cast<int>(wParam);
 		InvalidateStyleRedraw();
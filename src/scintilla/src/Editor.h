@@ -264,6 +264,8 @@ protected:	// ScintillaBase subclass needs access to much of Editor
 	WorkNeeded workNeeded;
 	Scintilla::IdleStyling idleStyling;
 	bool needIdleStyling;
+	bool needIdleLayout;
+	int scrollDirection;
 
 	Scintilla::ModificationFlags modEventMask;
 	bool commandEvents;
@@ -502,6 +504,7 @@ protected:	// ScintillaBase subclass needs access to much of Editor
 
 	virtual std::unique_ptr<CaseFolder> CaseFolderForEncoding();
 	Sci::Position FindText(Scintilla::uptr_t wParam, Scintilla::sptr_t lParam);
+	Sci::Position FindTextFull(Scintilla::uptr_t wParam, Scintilla::sptr_t lParam);
 	void SearchAnchor();
 	Sci::Position SearchText(Scintilla::Message iMessage, Scintilla::uptr_t wParam, Scintilla::sptr_t lParam);
 	Sci::Position SearchInTarget(const char *text, Sci::Position length);
@@ -554,6 +557,7 @@ protected:	// ScintillaBase subclass needs access to much of Editor
 		return (idleStyling == Scintilla::IdleStyling::None) || (idleStyling == Scintilla::IdleStyling::AfterVisible);
 	}
 	void IdleStyle();
+	void IdleLayout();
 	virtual void IdleWork();
 	virtual void QueueIdleWork(WorkItems items, Sci::Position upTo=0);
 
@@ -580,6 +584,8 @@ protected:	// ScintillaBase subclass needs access to much of Editor
 	void FoldAll(Scintilla::FoldAction action);
 
 	Sci::Position GetTag(char *tagValue, int tagNumber);
+	Sci::Position GetTextRange(char *buffer, Sci::Position cpMin, Sci::Position cpMax) const;
+	Sci::Position GetStyledText(char *buffer, Sci::Position cpMin, Sci::Position cpMax) const noexcept;
 	Sci::Position ReplaceTarget(bool replacePatterns, const char *text, Sci::Position length=-1);
 
 	bool PositionIsHotspot(Sci::Position position) const;
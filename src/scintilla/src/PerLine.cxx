@@ -10,6 +10,7 @@
 #include <cstring>
 
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 #include <forward_list>
@@ -224,9 +225,11 @@ LineLevels::~LineLevels() {
 
 void LineLevels::Init() {
 	levels.DeleteAll();
+	InvalidateFoldHeaders(0);
 }
 
 void LineLevels::InsertLine(Sci::Line line) {
+	InvalidateFoldHeaders(line);
 	if (levels.Length()) {
 		const int level = (line < levels.Length()) ? levels[line] : static_cast<int>(Scintilla::FoldLevel::Base);
 		levels.Insert(line, level);
@@ -234,6 +237,7 @@ void LineLevels::InsertLine(Sci::Line line) {
 }
 
 void LineLevels::InsertLines(Sci::Line line, Sci::Line lines) {
+	InvalidateFoldHeaders(line);
 	if (levels.Length()) {
 		const int level = (line < levels.Length()) ? levels[line] : static_cast<int>(Scintilla::FoldLevel::Base);
 		levels.InsertValue(line, lines, level);
@@ -241,6 +245,7 @@ void LineLevels::InsertLines(Sci::Line line, Sci::Line lines) {
 }
 
 void LineLevels::RemoveLine(Sci::Line line) {
+	InvalidateFoldHeaders(line - 1);
 	if (levels.Length()) {
 		// Move up following lines but merge header flag from this line
 		// to line before to avoid a temporary disappearance causing expansion.
@@ -259,6 +264,7 @@ void LineLevels::ExpandLevels(Sci::Line sizeNew) {
 
 void LineLevels::ClearLevels() {
 	levels.DeleteAll();
+	InvalidateFoldHeaders(0);
 }
 
 int LineLevels::SetLevel(Sci::Line line, int level, Sci::Line lines) {
@@ -270,6 +276,7 @@ int LineLevels::SetLevel(Sci::Line line, int level, Sci::Line lines) {
 		prev = levels[line];
 		if (prev != level) {
 			levels[line] = level;
+			InvalidateFoldHeaders(line);
 		}
 	}
 	return prev;
@@ -283,6 +290,90 @@ int LineLevels::GetLevel(Sci::Line line) const noexcept {
 	}
 }
 
+void LineLevels::InvalidateFoldHeaders(Sci::Line line) noexcept {
+	foldHeadersValid = std::clamp<Sci::Line>(line, 0, foldHeadersValid);
+}
+
+// A header's fold ends at the first following line that is not whitespace and has a level
+// number no greater than the header's. The parent of a line is the nearest header before it
+// with a lower level number. Both are found with a stack of headers.
+void LineLevels::BuildFoldHeaders(Sci::Line lines) {
+	foldHeaders.clear();
+	std::vector<size_t> open;	// Indices of headers with increasing level numbers
+	std::vector<size_t> ancestors;	// Indices of headers with increasing level numbers
+	for (Sci::Line line = 0; line < lines; line++) {
+		const Scintilla::FoldLevel level = static_cast<Scintilla::FoldLevel>(GetLevel(line));
+		const int levelNumber = Scintilla::LevelNumber(level);
+		if (!Scintilla::LevelIsWhitespace(level)) {
+			while (!open.empty() && (foldHeaders[open.back()].levelNumber >= levelNumber)) {
+				foldHeaders[open.back()].end = line;
+				open.pop_back();
+			}
+		}
+		if (Scintilla::LevelIsHeader(level)) {
+			while (!ancestors.empty() && (foldHeaders[ancestors.back()].levelNumber >= levelNumber)) {
+				ancestors.pop_back();
+			}
+			const Sci::Line parent = ancestors.empty() ? -1 : foldHeaders[ancestors.back()].line;
+			foldHeaders.push_back({line, parent, -1, levelNumber});
+			ancestors.push_back(foldHeaders.size() - 1);
+			if (!Scintilla::LevelIsWhitespace(level)) {
+				open.push_back(foldHeaders.size() - 1);
+			}
+		}
+	}
+	for (const size_t header : open) {
+		foldHeaders[header].end = lines;
+	}
+	// Changes to the number of lines are seen as the end of headers open to the end may change
+	foldHeadersValid = lines + 1;
+}
+
+const FoldHeader *LineLevels::FoldHeaderBefore(Sci::Line line) const noexcept {
+	const auto it = std::lower_bound(foldHeaders.begin(), foldHeaders.end(), line,
+		[](const FoldHeader &header, Sci::Line lineFind) noexcept {
+		return header.line < lineFind;
+	});
+	if (it == foldHeaders.begin()) {
+		return nullptr;
+	}
+	return &*(it - 1);
+}
+
+Sci::Line LineLevels::FoldParent(Sci::Line line, Sci::Line lines) {
+	// Lines changed since the headers were found are looked at directly unless there are many
+	constexpr Sci::Line linesScanMax = 1000;
+	if (std::min(line, lines) - foldHeadersValid > linesScanMax) {
+		BuildFoldHeaders(lines);
+	}
+	const int levelNumber = Scintilla::LevelNumber(static_cast<Scintilla::FoldLevel>(GetLevel(line)));
+	for (Sci::Line lineLook = line - 1; lineLook >= foldHeadersValid; lineLook--) {
+		const Scintilla::FoldLevel levelLook = static_cast<Scintilla::FoldLevel>(GetLevel(lineLook));
+		if (Scintilla::LevelIsHeader(levelLook) && (Scintilla::LevelNumber(levelLook) < levelNumber)) {
+			return lineLook;
+		}
+	}
+	// Walk up through the ancestors of the nearest header
+	const FoldHeader *header = FoldHeaderBefore(std::min(line, foldHeadersValid));
+	while (header && (header->levelNumber >= levelNumber)) {
+		header = (header->parent >= 0) ? FoldHeaderBefore(header->parent + 1) : nullptr;
+	}
+	return header ? header->line : -1;
+}
+
+Sci::Line LineLevels::FoldEnd(Sci::Line lineHeader, Sci::Line lines) {
+	if (!Scintilla::LevelIsHeader(static_cast<Scintilla::FoldLevel>(GetLevel(lineHeader)))) {
+		return -1;
+	}
+	const FoldHeader *header = FoldHeaderBefore(lineHeader + 1);
+	if ((lineHeader >= foldHeadersValid) || !header || (header->line != lineHeader) ||
+		(header->end >= foldHeadersValid)) {
+		BuildFoldHeaders(lines);
+		header = FoldHeaderBefore(lineHeader + 1);
+	}
+	return (header && (header->line == lineHeader)) ? header->end : -1;
+}
+
 LineState::~LineState() {
 }
 
@@ -330,6 +421,69 @@ Sci::Line LineState::GetMaxLineState() const noexcept {
 	return lineStates.Length();
 }
 
+LineCheckpoints::~LineCheckpoints() {
+}
+
+void LineCheckpoints::Init() {
+	ClearAll();
+}
+
+// A checkpoint is for the end of a line so it stays with the text that followed it: when a
+// line is split it belongs with the last of the pieces and when lines are inserted at the
+// start of a line it moves to the last of the inserted lines.
+
+void LineCheckpoints::InsertLine(Sci::Line line) {
+	if (checkpoints.Length()) {
+		const Sci::Line lineCheckpoint = std::max<Sci::Line>(line - 1, 0);
+		checkpoints.EnsureLength(lineCheckpoint);
+		checkpoints.Insert(lineCheckpoint, std::unique_ptr<LexerCheckpoint>());
+	}
+}
+
+void LineCheckpoints::InsertLines(Sci::Line line, Sci::Line lines) {
+	if (checkpoints.Length()) {
+		const Sci::Line lineCheckpoint = std::max<Sci::Line>(line - 1, 0);
+		checkpoints.EnsureLength(lineCheckpoint);
+		checkpoints.InsertEmpty(lineCheckpoint, lines);
+	}
+}
+
+void LineCheckpoints::RemoveLine(Sci::Line line) {
+	// Line is joined onto the previous line which now ends where line did
+	if (checkpoints.Length() && (line > 0) && (line <= checkpoints.Length())) {
+		checkpoints[line-1].reset();
+		checkpoints.Delete(line-1);
+	}
+}
+
+const LexerCheckpoint *LineCheckpoints::Checkpoint(Sci::Line line) const noexcept {
+	if ((line >= 0) && (line < checkpoints.Length()))
+		return checkpoints[line].get();
+	return nullptr;
+}
+
+Sci::Line LineCheckpoints::CheckpointNext(Sci::Line lineStart, Sci::Line lineEnd) const noexcept {
+	if (lineStart < 0)
+		lineStart = 0;
+	const Sci::Line length = std::min(lineEnd, checkpoints.Length());
+	for (Sci::Line iLine = lineStart; iLine < length; iLine++) {
+		if (checkpoints[iLine])
+			return iLine;
+	}
+	return -1;
+}
+
+void LineCheckpoints::SetCheckpoint(Sci::Line line, std::unique_ptr<LexerCheckpoint> checkpoint) {
+	if (line >= 0) {
+		checkpoints.EnsureLength(line + 1);
+		checkpoints[line] = std::move(checkpoint);
+	}
+}
+
+void LineCheckpoints::ClearAll() {
+	checkpoints.DeleteAll();
+}
+
 // Each allocated LineAnnotation is a char array which starts with an AnnotationHeader
 // and then has text and optional styles.
 
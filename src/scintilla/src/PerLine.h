@@ -73,8 +73,26 @@ public:
 	int NumberFromLine(Sci::Line line, int which) const noexcept;
 };
 
+/**
+ * A fold header line with its fold parent and the first line after its fold, kept so these
+ * can be found without scanning through large folds.
+ */
+struct FoldHeader {
+	Sci::Line line;
+	Sci::Line parent;	///< Fold parent or -1
+	Sci::Line end;	///< First line that is not subordinate or -1 when not known
+	int levelNumber;
+};
+
 class LineLevels : public PerLine {
 	SplitVector<int> levels;
+	// Fold headers are found in one pass over the levels when needed and stay valid for the
+	// lines before the first change to levels or lines.
+	std::vector<FoldHeader> foldHeaders;
+	Sci::Line foldHeadersValid = 0;
+	void InvalidateFoldHeaders(Sci::Line line) noexcept;
+	void BuildFoldHeaders(Sci::Line lines);
+	const FoldHeader *FoldHeaderBefore(Sci::Line line) const noexcept;
 public:
 	LineLevels() {
 	}
@@ -93,6 +111,8 @@ public:
 	void ClearLevels();
 	int SetLevel(Sci::Line line, int level, Sci::Line lines);
 	int GetLevel(Sci::Line line) const noexcept;
+	Sci::Line FoldParent(Sci::Line line, Sci::Line lines);
+	Sci::Line FoldEnd(Sci::Line lineHeader, Sci::Line lines);
 };
 
 class LineState : public PerLine {
@@ -116,6 +136,43 @@ public:
 	Sci::Line GetMaxLineState() const noexcept;
 };
 
+/**
+ * The state of a lexer at the end of a line. When lexing after an edit reaches the end of a
+ * line in the same state as before, the styles already set for the following lines are kept.
+ */
+struct LexerCheckpoint {
+	int lineState = 0;
+	int level = 0;	///< Fold level of the line
+	char style = 0;	///< Style of the last character of the line
+	std::string state;	///< Opaque state held by the lexer
+	bool operator==(const LexerCheckpoint &other) const noexcept {
+		return (lineState == other.lineState) && (level == other.level) &&
+			(style == other.style) && (state == other.state);
+	}
+};
+
+class LineCheckpoints : public PerLine {
+	SplitVector<std::unique_ptr<LexerCheckpoint>> checkpoints;
+public:
+	LineCheckpoints() {
+	}
+	// Deleted so LineCheckpoints objects can not be copied.
+	LineCheckpoints(const LineCheckpoints &) = delete;
+	LineCheckpoints(LineCheckpoints &&) = delete;
+	void operator=(const LineCheckpoints &) = delete;
+	void operator=(LineCheckpoints &&) = delete;
+	~LineCheckpoints() override;
+	void Init() override;
+	void InsertLine(Sci::Line line) override;
+	void InsertLines(Sci::Line line, Sci::Line lines) override;
+	void RemoveLine(Sci::Line line) override;
+
+	const LexerCheckpoint *Checkpoint(Sci::Line line) const noexcept;
+	Sci::Line CheckpointNext(Sci::Line lineStart, Sci::Line lineEnd) const noexcept;
+	void SetCheckpoint(Sci::Line line, std::unique_ptr<LexerCheckpoint> checkpoint);
+	void ClearAll();
+};
+
 class LineAnnotation : public PerLine {
 	SplitVector<std::unique_ptr<char []>> annotations;
 public:
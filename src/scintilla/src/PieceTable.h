@@ -0,0 +1,309 @@
+// Scintilla source code edit control
+/** @file PieceTable.h
+ ** Data structure for holding arrays where insertions and deletions are scattered.
+ **/
+// The License.txt file describes the conditions under which this software may be distributed.
+
+#ifndef PIECETABLE_H
+#define PIECETABLE_H
+
+namespace Scintilla::Internal {
+
+/// An alternative to SplitVector for large buffers with edits spread over the whole buffer.
+/// Elements are only ever appended to a single backing buffer and the logical sequence is
+/// described by a list of pieces, each a run of the backing buffer.
+/// Piece boundaries are kept in a Partitioning so finding the piece for a position is a
+/// binary search and an edit only moves the piece list, not the elements.
+/// Pieces never share elements so elements may be modified in place.
+/// Deleted elements are not reclaimed until the pieces are flattened, which happens when
+/// contiguous access to more than one piece is requested.
+template <typename T>
+class PieceTable {
+private:
+	std::vector<T> buffer;
+	ptrdiff_t used;	/// Elements of buffer in use, buffer.size() is the capacity
+	T empty;	/// Returned as the result of out-of-bounds access.
+	SplitVector<ptrdiff_t> starts;	/// Offset into buffer of each piece
+	Partitioning<ptrdiff_t> pieces;	/// Logical position of each piece
+
+	/// Range of a piece and the offset that turns a position in it into an index of buffer.
+	struct Piece {
+		ptrdiff_t start;
+		ptrdiff_t end;
+		ptrdiff_t offset;
+	};
+
+	// Last piece accessed to make sequential access cheap.
+	// Left alone while several threads are reading so they never write to shared state.
+	mutable Piece cache;
+	bool concurrentReading;
+
+	void Invalidate() noexcept {
+		cache = Piece{ 0, 0, 0 };
+	}
+
+	bool Locate(ptrdiff_t position, Piece &piece) const noexcept {
+		if (position >= cache.start && position < cache.end) {
+			piece = cache;
+			return true;
+		}
+		if (position < 0 || position >= Length()) {
+			return false;
+		}
+		const ptrdiff_t partition = pieces.PartitionFromPosition(position);
+		piece.start = pieces.PositionFromPartition(partition);
+		piece.end = pieces.PositionFromPartition(partition + 1);
+		piece.offset = starts.ValueAt(partition) - piece.start;
+		if (!concurrentReading) {
+			cache = piece;
+		}
+		return true;
+	}
+
+	/// Copy elements to the end of the backing buffer and return where they start.
+	ptrdiff_t Append(const T *s, ptrdiff_t insertLength) {
+		RoomFor(insertLength);
+		const ptrdiff_t offset = used;
+		if (s) {
+			std::copy(s, s + insertLength, buffer.data() + used);
+		}
+		used += insertLength;
+		return offset;
+	}
+
+	void RoomFor(ptrdiff_t insertLength) {
+		// Always leave room for a terminating element after the content
+		const ptrdiff_t needed = used + insertLength + 1;
+		if (needed > static_cast<ptrdiff_t>(buffer.size())) {
+			ReAllocate(std::max(needed, static_cast<ptrdiff_t>(buffer.size() + buffer.size() / 2)));
+		}
+	}
+
+	/// Add insertLength elements, which are already at offset in the buffer, at position.
+	void InsertPiece(ptrdiff_t position, ptrdiff_t offset, ptrdiff_t insertLength) {
+		Invalidate();
+		if (starts.Length() == 0) {
+			starts.Insert(0, offset);
+			pieces.InsertText(0, insertLength);
+			return;
+		}
+		ptrdiff_t piece = pieces.PartitionFromPosition(position);
+		ptrdiff_t pieceStart = pieces.PositionFromPartition(piece);
+		if (position == pieceStart && piece > 0) {
+			// Treat as appending to the previous piece so it can be extended
+			piece--;
+			pieceStart = pieces.PositionFromPartition(piece);
+		}
+		const ptrdiff_t pieceLength = pieces.PositionFromPartition(piece + 1) - pieceStart;
+		const ptrdiff_t within = position - pieceStart;
+		if (within == pieceLength) {
+			if (starts.ValueAt(piece) + pieceLength == offset) {
+				// Typing and loading both append at the end of the last insertion
+				pieces.InsertText(piece, insertLength);
+			} else {
+				starts.Insert(piece + 1, offset);
+				pieces.InsertPartition(piece + 1, position);
+				pieces.InsertText(piece + 1, insertLength);
+			}
+		} else if (within == 0) {
+			// Only reached for the first piece
+			starts.Insert(piece, offset);
+			pieces.InsertPartition(piece, position);
+			pieces.InsertText(piece, insertLength);
+		} else {
+			// Split the piece and put the new piece between the halves
+			starts.Insert(piece + 1, starts.ValueAt(piece) + within);
+			pieces.InsertPartition(piece + 1, position);
+			starts.Insert(piece + 1, offset);
+			pieces.InsertPartition(piece + 1, position);
+			pieces.InsertText(piece + 1, insertLength);
+		}
+	}
+
+public:
+	PieceTable() : used(0), empty(), pieces(8), cache{ 0, 0, 0 }, concurrentReading(false) {
+	}
+
+	// Deleted so PieceTable objects can not be copied.
+	PieceTable(const PieceTable &) = delete;
+	PieceTable(PieceTable &&) = delete;
+	void operator=(const PieceTable &) = delete;
+	void operator=(PieceTable &&) = delete;
+
+	~PieceTable() {
+	}
+
+	/// Reserve room in the backing buffer. Must not be used to decrease the size.
+	void ReAllocate(ptrdiff_t newSize) {
+		if (newSize < 0)
+			throw std::runtime_error("PieceTable::ReAllocate: negative size.");
+
+		if (newSize > static_cast<ptrdiff_t>(buffer.size())) {
+			// Make sure there is room for the terminating element as well
+			buffer.reserve(newSize + 1);
+			buffer.resize(newSize + 1);
+		}
+	}
+
+	/// While true, const methods may be called from several threads at once.
+	/// Nothing may be changed until it is set back to false.
+	void SetConcurrentReading(bool concurrentReading_) noexcept {
+		concurrentReading = concurrentReading_;
+	}
+
+	/// Retrieve the element at a particular position.
+	/// Retrieving positions outside the range of the buffer returns empty or 0.
+	const T &ValueAt(ptrdiff_t position) const noexcept {
+		Piece piece;
+		if (!Locate(position, piece)) {
+			return empty;
+		}
+		return buffer[piece.offset + position];
+	}
+
+	/// Set the element at a particular position.
+	/// Setting positions outside the range of the buffer does nothing.
+	void SetValueAt(ptrdiff_t position, T v) noexcept {
+		Piece piece;
+		if (Locate(position, piece)) {
+			buffer[piece.offset + position] = std::move(v);
+		}
+	}
+
+	ptrdiff_t Length() const noexcept {
+		return pieces.Length();
+	}
+
+	/// Number of pieces the content is currently split into.
+	ptrdiff_t Pieces() const noexcept {
+		return starts.Length();
+	}
+
+	/// Insert a number of elements into the buffer setting their value.
+	void InsertValue(ptrdiff_t position, ptrdiff_t insertLength, T v) {
+		if (insertLength > 0 && position >= 0 && position <= Length()) {
+			const ptrdiff_t offset = Append(nullptr, insertLength);
+			std::fill(buffer.data() + offset, buffer.data() + offset + insertLength, v);
+			InsertPiece(position, offset, insertLength);
+		}
+	}
+
+	/// Insert text into the buffer from an array.
+	void InsertFromArray(ptrdiff_t positionToInsert, const T s[], ptrdiff_t positionFrom, ptrdiff_t insertLength) {
+		if (insertLength > 0 && positionToInsert >= 0 && positionToInsert <= Length()) {
+			const ptrdiff_t offset = Append(s + positionFrom, insertLength);
+			InsertPiece(positionToInsert, offset, insertLength);
+		}
+	}
+
+	/// Delete a range from the buffer.
+	/// Deleting positions outside the current range fails.
+	void DeleteRange(ptrdiff_t position, ptrdiff_t deleteLength) {
+		if ((position < 0) || ((position + deleteLength) > Length()))
+			return;
+		if ((position == 0) && (deleteLength == Length())) {
+			DeleteAll();
+			return;
+		}
+		Invalidate();
+		while (deleteLength > 0) {
+			const ptrdiff_t piece = pieces.PartitionFromPosition(position);
+			const ptrdiff_t pieceStart = pieces.PositionFromPartition(piece);
+			const ptrdiff_t pieceLength = pieces.PositionFromPartition(piece + 1) - pieceStart;
+			const ptrdiff_t within = position - pieceStart;
+			const ptrdiff_t lengthRemove = std::min(deleteLength, pieceLength - within);
+
+			pieces.InsertText(piece, -lengthRemove);
+			if (lengthRemove == pieceLength) {
+				// Whole piece goes so drop one of its now coincident boundaries
+				pieces.RemovePartition(piece > 0 ? piece : 1);
+				starts.Delete(piece);
+			} else if (within == 0) {
+				starts.SetValueAt(piece, starts.ValueAt(piece) + lengthRemove);
+			} else if (within + lengthRemove < pieceLength) {
+				// Middle of the piece so keep the tail as a new piece
+				starts.Insert(piece + 1, starts.ValueAt(piece) + within + lengthRemove);
+				pieces.InsertPartition(piece + 1, position);
+			}
+			deleteLength -= lengthRemove;
+		}
+	}
+
+	/// Delete all the buffer contents.
+	void DeleteAll() {
+		buffer.clear();
+		buffer.shrink_to_fit();
+		used = 0;
+		starts.DeleteAll();
+		pieces.DeleteAll();
+		Invalidate();
+	}
+
+	/// Retrieve a range of elements into an array
+	void GetRange(T *buffer_, ptrdiff_t position, ptrdiff_t retrieveLength) const noexcept {
+		Piece piece;
+		while (retrieveLength > 0 && Locate(position, piece)) {
+			const ptrdiff_t lengthCopy = std::min(retrieveLength, piece.end - position);
+			std::copy(buffer.data() + piece.offset + position, buffer.data() + piece.offset + position + lengthCopy, buffer_);
+			buffer_ += lengthCopy;
+			position += lengthCopy;
+			retrieveLength -= lengthCopy;
+		}
+	}
+
+	/// Copy all the pieces, in order, into a new buffer leaving a single piece.
+	void Flatten() {
+		const ptrdiff_t length = Length();
+		if (Pieces() <= 1 && (length == 0 || starts.ValueAt(0) == 0)) {
+			return;
+		}
+		std::vector<T> flat(length + 1);
+		GetRange(flat.data(), 0, length);
+		buffer.swap(flat);
+		used = length;
+		starts.DeleteAll();
+		starts.Insert(0, 0);
+		pieces.DeleteAll();
+		pieces.InsertText(0, length);
+		Invalidate();
+	}
+
+	/// Retrieve a pointer to the whole buffer, which is flattened if needed.
+	/// The buffer is terminated by an extra element set to 0.
+	T *BufferPointer() {
+		Flatten();
+		RoomFor(0);
+		buffer[Length()] = 0;
+		return buffer.data();
+	}
+
+	/// Return a pointer to the first element of the piece containing position and set the
+	/// range of that piece, or nullptr when position is out of bounds.
+	/// Does not flatten the buffer.
+	const T *SegmentPointer(ptrdiff_t position, ptrdiff_t &segmentStart, ptrdiff_t &segmentEnd) const noexcept {
+		Piece piece;
+		if (!Locate(position, piece)) {
+			return nullptr;
+		}
+		segmentStart = piece.start;
+		segmentEnd = piece.end;
+		return buffer.data() + piece.offset + piece.start;
+	}
+
+	/// Return a pointer to a range of elements, first flattening the buffer if the range
+	/// is spread over more than one piece.
+	/// Throws std::bad_alloc rather than returning nullptr if flattening can not allocate.
+	T *RangePointer(ptrdiff_t position, ptrdiff_t rangeLength) {
+		Piece piece;
+		if (Locate(position, piece) && (position + rangeLength <= piece.end)) {
+			return buffer.data() + piece.offset + position;
+		}
+		Flatten();
+		RoomFor(0);
+		return buffer.data() + std::clamp<ptrdiff_t>(position, 0, Length());
+	}
+};
+
+}
+
+#endif
@@ -22,6 +22,10 @@
 #include <iterator>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <array>
+#include <tuple>
 
 #include "ScintillaTypes.h"
 #include "ScintillaMessages.h"
@@ -100,6 +104,13 @@ void LineLayout::Resize(int maxLineLength_) {
 	}
 }
 
+// Lay out a different line without allocating when the line fits.
+void LineLayout::Reuse(Sci::Line lineNumber_, int maxLineLength_) {
+	lineNumber = lineNumber_;
+	Resize(maxLineLength_);
+	Invalidate(ValidLevel::invalid);
+}
+
 void LineLayout::EnsureBidiData() {
 	if (!bidiData) {
 		bidiData = std::make_unique<BidiData>();
@@ -128,6 +139,16 @@ bool LineLayout::CanHold(Sci::Line lineDoc, int lineLength_) const noexcept {
 	return (lineNumber == lineDoc) && (lineLength_ <= maxLineLength);
 }
 
+size_t LineLayout::Memory() const noexcept {
+	const size_t elements = std::max(maxLineLength, 0) + 2;
+	size_t bytes = sizeof(LineLayout) + elements * (sizeof(char) + sizeof(unsigned char) + sizeof(XYPOSITION));
+	bytes += lenLineStarts * sizeof(int);
+	if (bidiData) {
+		bytes += elements * (sizeof(std::shared_ptr<Font>) + sizeof(XYPOSITION));
+	}
+	return bytes;
+}
+
 int LineLayout::LineStart(int line) const noexcept {
 	if (line <= 0) {
 		return 0;
@@ -365,8 +386,9 @@ XYPOSITION ScreenLine::TabPositionAfter(XYPOSITION xPosition) const {
 }
 
 LineLayoutCache::LineLayoutCache() :
-	level(LineCache::None),
-	allInvalidated(false), styleClock(-1) {
+	level(LineCache::None), budget(0), memory(0), useClock(0),
+	allInvalidated(false), styleClock(-1),
+	hits(0), misses(0), evictions(0) {
 }
 
 LineLayoutCache::~LineLayoutCache() = default;
@@ -459,15 +481,21 @@ void LineLayoutCache::AllocateForLevel(Sci::Line linesOnScreen, Sci::Line linesI
 
 void LineLayoutCache::Deallocate() noexcept {
 	cache.clear();
+	recent.clear();
+	uses.clear();
+	memory = 0;
 }
 
 void LineLayoutCache::Invalidate(LineLayout::ValidLevel validity_) noexcept {
-	if (!cache.empty() && !allInvalidated) {
+	if ((!cache.empty() || !recent.empty()) && !allInvalidated) {
 		for (const std::shared_ptr<LineLayout> &ll : cache) {
 			if (ll) {
 				ll->Invalidate(validity_);
 			}
 		}
+		for (const auto &[line, entry] : recent) {
+			entry.ll->Invalidate(validity_);
+		}
 		if (validity_ == LineLayout::ValidLevel::invalid) {
 			allInvalidated = true;
 		}
@@ -478,12 +506,105 @@ void LineLayoutCache::SetLevel(LineCache level_) noexcept {
 	if (level != level_) {
 		level = level_;
 		allInvalidated = false;
-		cache.clear();
+		Deallocate();
+	}
+}
+
+void LineLayoutCache::SetBudget(size_t budget_) noexcept {
+	if (budget != budget_) {
+		budget = budget_;
+		allInvalidated = false;
+		Deallocate();
+	}
+}
+
+bool LineLayoutCache::Budgeted() const noexcept {
+	return (budget > 0) && ((level == LineCache::Page) || (level == LineCache::Document));
+}
+
+size_t LineLayoutCache::Statistic(LayoutCacheStatistic statistic) const noexcept {
+	switch (statistic) {
+	case LayoutCacheStatistic::Hits:
+		return hits;
+	case LayoutCacheStatistic::Misses:
+		return misses;
+	case LayoutCacheStatistic::Evictions:
+		return evictions;
+	case LayoutCacheStatistic::Entries:
+		return recent.size() + static_cast<size_t>(std::count_if(cache.cbegin(), cache.cend(),
+			[](const std::shared_ptr<LineLayout> &ll) noexcept { return ll != nullptr; }));
+	case LayoutCacheStatistic::Memory: {
+			size_t bytes = memory;
+			for (const std::shared_ptr<LineLayout> &ll : cache) {
+				if (ll) {
+					bytes += ll->Memory();
+				}
+			}
+			return bytes;
+		}
+	}
+	return 0;
+}
+
+void LineLayoutCache::ResetStatistics() noexcept {
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+std::shared_ptr<LineLayout> LineLayoutCache::RetrieveRecent(Sci::Line lineNumber, int maxChars) {
+	useClock++;
+	auto it = recent.find(lineNumber);
+	if ((it != recent.end()) && !it->second.ll->CanHold(lineNumber, maxChars)) {
+		memory -= it->second.memory;
+		uses.erase(it->second.lastUsed);
+		recent.erase(it);
+		it = recent.end();
+	}
+	if (it == recent.end()) {
+		misses++;
+		it = recent.emplace(lineNumber, Recent{ std::make_shared<LineLayout>(lineNumber, maxChars), 0, 0 }).first;
+	} else {
+		hits++;
+		uses.erase(it->second.lastUsed);
+	}
+	Recent &entry = it->second;
+	// Wrapping may have grown the layout since it was last retrieved
+	const size_t memoryEntry = entry.ll->Memory();
+	memory = memory - entry.memory + memoryEntry;
+	entry.memory = memoryEntry;
+	entry.lastUsed = useClock;
+	// The clock only increases so this is always added at the end
+	uses.emplace_hint(uses.end(), useClock, lineNumber);
+	std::shared_ptr<LineLayout> ll = entry.ll;
+	if (memory > budget) {
+		EvictToBudget();
+	}
+	return ll;
+}
+
+void LineLayoutCache::EvictToBudget() {
+	// The most recently used layout is always kept even when it is larger than the budget.
+	while ((uses.size() > 1) && (memory > budget)) {
+		const auto leastRecent = uses.begin();
+		const auto it = recent.find(leastRecent->second);
+		memory -= it->second.memory;
+		recent.erase(it);
+		uses.erase(leastRecent);
+		evictions++;
 	}
 }
 
 std::shared_ptr<LineLayout> LineLayoutCache::Retrieve(Sci::Line lineNumber, Sci::Line lineCaret, int maxChars, int styleClock_,
                                       Sci::Line linesOnScreen, Sci::Line linesInDoc) {
+	if (Budgeted()) {
+		if (styleClock != styleClock_) {
+			Invalidate(LineLayout::ValidLevel::checkTextAndStyle);
+			styleClock = styleClock_;
+		}
+		allInvalidated = false;
+		return RetrieveRecent(lineNumber, maxChars);
+	}
 	AllocateForLevel(linesOnScreen, linesInDoc);
 	if (styleClock != styleClock_) {
 		Invalidate(LineLayout::ValidLevel::checkTextAndStyle);
@@ -521,10 +642,16 @@ std::shared_ptr<LineLayout> LineLayoutCache::Retrieve(Sci::Line lineNumber, Sci:
 
 	if (pos < cache.size()) {
 		if (cache[pos] && !cache[pos]->CanHold(lineNumber, maxChars)) {
+			if (cache[pos]->LineNumber() != lineNumber) {
+				evictions++;
+			}
 			cache[pos].reset();
 		}
 		if (!cache[pos]) {
+			misses++;
 			cache[pos] = std::make_shared<LineLayout>(lineNumber, maxChars);
+		} else {
+			hits++;
 		}
 #ifdef CHECK_LLC
 		// Expensive check that there is only one entry for any line number
@@ -540,6 +667,7 @@ std::shared_ptr<LineLayout> LineLayoutCache::Retrieve(Sci::Line lineNumber, Sci:
 	}
 
 	// Only reach here for level == Cache::none
+	misses++;
 	return std::make_shared<LineLayout>(lineNumber, maxChars);
 }
 
@@ -799,67 +927,41 @@ bool BreakFinder::More() const noexcept {
 	return (subBreak >= 0) || (nextBreak < lineRange.end);
 }
 
+namespace {
+
+// Entries are keyed by a font identifier from PositionCacheStore::FontId instead of a style
+// number so that measurements can be shared by all views using the same font.
 class PositionCacheEntry {
-	uint16_t styleNumber;
+	uint16_t fontId;
 	uint16_t len;
 	uint16_t clock;
 	std::unique_ptr<XYPOSITION[]> positions;
 public:
 	PositionCacheEntry() noexcept;
-	// Copy constructor not currently used, but needed for being element in std::vector.
-	PositionCacheEntry(const PositionCacheEntry &);
 	PositionCacheEntry(PositionCacheEntry &&) noexcept = default;
-	// Deleted so PositionCacheEntry objects can not be assigned.
+	// Deleted so PositionCacheEntry objects can not be copied or assigned.
+	PositionCacheEntry(const PositionCacheEntry &) = delete;
 	void operator=(const PositionCacheEntry &) = delete;
 	void operator=(PositionCacheEntry &&) = delete;
 	~PositionCacheEntry();
-	void Set(unsigned int styleNumber_, std::string_view sv, const XYPOSITION *positions_, uint16_t clock_);
+	void Set(unsigned int fontId_, std::string_view sv, const XYPOSITION *positions_, uint16_t clock_);
 	void Clear() noexcept;
-	bool Retrieve(unsigned int styleNumber_, std::string_view sv, XYPOSITION *positions_) const noexcept;
-	static size_t Hash(unsigned int styleNumber_, std::string_view sv) noexcept;
+	bool Retrieve(unsigned int fontId_, std::string_view sv, XYPOSITION *positions_) const noexcept;
+	static size_t Hash(unsigned int fontId_, std::string_view sv) noexcept;
 	bool NewerThan(const PositionCacheEntry &other) const noexcept;
 	void ResetClock() noexcept;
-};
-
-class PositionCache : public IPositionCache {
-	std::vector<PositionCacheEntry> pces;
-	std::mutex mutex;
-	uint16_t clock;
-	bool allClear;
-public:
-	PositionCache();
-	// Deleted so LineAnnotation objects can not be copied.
-	PositionCache(const PositionCache &) = delete;
-	PositionCache(PositionCache &&) = delete;
-	void operator=(const PositionCache &) = delete;
-	void operator=(PositionCache &&) = delete;
-	~PositionCache() override = default;
-
-	void Clear() noexcept override;
-	void SetSize(size_t size_) override;
-	size_t GetSize() const noexcept override;
-	void MeasureWidths(Surface *surface, const ViewStyle &vstyle, unsigned int styleNumber,
-		std::string_view sv, XYPOSITION *positions, bool needsLocking) override;
+	bool Empty() const noexcept;
+	size_t Memory() const noexcept;
 };
 
 PositionCacheEntry::PositionCacheEntry() noexcept :
-	styleNumber(0), len(0), clock(0) {
-}
-
-// Copy constructor not currently used, but needed for being element in std::vector.
-PositionCacheEntry::PositionCacheEntry(const PositionCacheEntry &other) :
-	styleNumber(other.styleNumber), len(other.len), clock(other.clock) {
-	if (other.positions) {
-		const size_t lenData = len + (len / sizeof(XYPOSITION)) + 1;
-		positions = std::make_unique<XYPOSITION[]>(lenData);
-		memcpy(positions.get(), other.positions.get(), lenData * sizeof(XYPOSITION));
-	}
+	fontId(0), len(0), clock(0) {
 }
 
-void PositionCacheEntry::Set(unsigned int styleNumber_, std::string_view sv,
+void PositionCacheEntry::Set(unsigned int fontId_, std::string_view sv,
 	const XYPOSITION *positions_, uint16_t clock_) {
 	Clear();
-	styleNumber = static_cast<uint16_t>(styleNumber_);
+	fontId = static_cast<uint16_t>(fontId_);
 	len = static_cast<uint16_t>(sv.length());
 	clock = clock_;
 	if (sv.data() && positions_) {
@@ -877,13 +979,13 @@ PositionCacheEntry::~PositionCacheEntry() {
 
 void PositionCacheEntry::Clear() noexcept {
 	positions.reset();
-	styleNumber = 0;
+	fontId = 0;
 	len = 0;
 	clock = 0;
 }
 
-bool PositionCacheEntry::Retrieve(unsigned int styleNumber_, std::string_view sv, XYPOSITION *positions_) const noexcept {
-	if ((styleNumber == styleNumber_) && (len == sv.length()) &&
+bool PositionCacheEntry::Retrieve(unsigned int fontId_, std::string_view sv, XYPOSITION *positions_) const noexcept {
+	if (positions && (fontId == fontId_) && (len == sv.length()) &&
 		(memcmp(&positions[len], sv.data(), sv.length())== 0)) {
 		for (unsigned int i=0; i<len; i++) {
 			positions_[i] = positions[i];
@@ -894,9 +996,9 @@ bool PositionCacheEntry::Retrieve(unsigned int styleNumber_, std::string_view sv
 	}
 }
 
-size_t PositionCacheEntry::Hash(unsigned int styleNumber_, std::string_view sv) noexcept {
+size_t PositionCacheEntry::Hash(unsigned int fontId_, std::string_view sv) noexcept {
 	const size_t h1 = std::hash<std::string_view>{}(sv);
-	const size_t h2 = std::hash<unsigned int>{}(styleNumber_);
+	const size_t h2 = std::hash<unsigned int>{}(fontId_);
 	return h1 ^ (h2 << 1);
 }
 
@@ -910,13 +1012,79 @@ void PositionCacheEntry::ResetClock() noexcept {
 	}
 }
 
-PositionCache::PositionCache() {
-	clock = 1;
-	pces.resize(0x400);
-	allClear = true;
+bool PositionCacheEntry::Empty() const noexcept {
+	return !positions;
 }
 
-void PositionCache::Clear() noexcept {
+size_t PositionCacheEntry::Memory() const noexcept {
+	size_t memory = sizeof(PositionCacheEntry);
+	if (positions) {
+		memory += (len + (len / sizeof(XYPOSITION)) + 1) * sizeof(XYPOSITION);
+	}
+	return memory;
+}
+
+// Everything that affects how wide a string is when drawn in a style. Style numbers can't be
+// used between views as each view can define its styles differently.
+struct FontKey {
+	std::string fontName;
+	int sizeZoomed = 0;
+	FontWeight weight = FontWeight::Normal;
+	bool italic = false;
+	CharacterSet characterSet = CharacterSet::Default;
+	FontQuality extraFontFlag = FontQuality::QualityDefault;
+	Technology technology = Technology::Default;
+	int logPixelsY = 0;
+	int codePage = 0;
+	bool operator<(const FontKey &other) const noexcept {
+		return std::tie(fontName, sizeZoomed, weight, italic, characterSet, extraFontFlag, technology, logPixelsY, codePage) <
+			std::tie(other.fontName, other.sizeZoomed, other.weight, other.italic, other.characterSet, other.extraFontFlag,
+				other.technology, other.logPixelsY, other.codePage);
+	}
+};
+
+// Process-wide cache of string widths shared by every view.
+// The table is split into shards, each with its own reader-writer lock, so concurrent
+// layout threads mostly look up entries without contending with each other.
+// Each shard is two way associative, replacing the least recently stored entry.
+class PositionCacheStore {
+	static constexpr size_t shards = 16;
+	static constexpr size_t defaultSize = 0x4000;
+	struct Shard {
+		std::shared_mutex mutex;
+		std::vector<PositionCacheEntry> pces;
+		uint16_t clock = 1;
+		bool allClear = true;
+		void Clear() noexcept;
+	};
+	std::array<Shard, shards> shard;
+	std::atomic<size_t> size;
+
+	std::mutex mutexFonts;
+	std::map<FontKey, unsigned int> fontIds;
+	std::atomic<unsigned int> generation;
+
+	std::atomic<size_t> hits;
+	std::atomic<size_t> misses;
+	std::atomic<size_t> evictions;
+
+	void ClearAll() noexcept;
+public:
+	PositionCacheStore();
+
+	static PositionCacheStore &Instance();
+
+	unsigned int FontId(const FontKey &key);
+	unsigned int Generation() const noexcept;
+	void SetSize(size_t size_);
+	size_t GetSize() const noexcept;
+	bool Retrieve(unsigned int fontId, std::string_view sv, XYPOSITION *positions);
+	void Store(unsigned int fontId, std::string_view sv, const XYPOSITION *positions);
+	size_t Statistic(LayoutCacheStatistic statistic);
+	void ResetStatistics() noexcept;
+};
+
+void PositionCacheStore::Shard::Clear() noexcept {
 	if (!allClear) {
 		for (PositionCacheEntry &pce : pces) {
 			pce.Clear();
@@ -926,17 +1094,226 @@ void PositionCache::Clear() noexcept {
 	allClear = true;
 }
 
+PositionCacheStore::PositionCacheStore() : size(defaultSize), generation(1), hits(0), misses(0), evictions(0) {
+	for (Shard &sh : shard) {
+		sh.pces.resize(defaultSize / shards);
+	}
+}
+
+PositionCacheStore &PositionCacheStore::Instance() {
+	static PositionCacheStore store;
+	return store;
+}
+
+void PositionCacheStore::ClearAll() noexcept {
+	for (Shard &sh : shard) {
+		std::unique_lock<std::shared_mutex> guard(sh.mutex);
+		sh.Clear();
+	}
+}
+
+unsigned int PositionCacheStore::FontId(const FontKey &key) {
+	std::lock_guard<std::mutex> guard(mutexFonts);
+	auto it = fontIds.find(key);
+	if (it != fontIds.end()) {
+		return it->second;
+	}
+	if (fontIds.size() >= UINT16_MAX) {
+		// Identifiers are 16 bits in entries so start again. Views notice the new
+		// generation and look up their fonts again.
+		ClearAll();
+		fontIds.clear();
+		generation++;
+	}
+	const unsigned int id = static_cast<unsigned int>(fontIds.size()) + 1;
+	fontIds.emplace(key, id);
+	return id;
+}
+
+unsigned int PositionCacheStore::Generation() const noexcept {
+	return generation.load(std::memory_order_acquire);
+}
+
+void PositionCacheStore::SetSize(size_t size_) {
+	if (size_ == size) {
+		return;
+	}
+	// Round up so each shard has the same number of entries
+	const size_t perShard = (size_ + shards - 1) / shards;
+	for (Shard &sh : shard) {
+		std::unique_lock<std::shared_mutex> guard(sh.mutex);
+		sh.Clear();
+		sh.pces.resize(perShard);
+	}
+	size = size_;
+}
+
+size_t PositionCacheStore::GetSize() const noexcept {
+	return size;
+}
+
+bool PositionCacheStore::Retrieve(unsigned int fontId, std::string_view sv, XYPOSITION *positions) {
+	const size_t hashValue = PositionCacheEntry::Hash(fontId, sv);
+	Shard &sh = shard[hashValue % shards];
+	std::shared_lock<std::shared_mutex> guard(sh.mutex);
+	if (!sh.pces.empty()) {
+		const size_t probeHash = hashValue / shards;
+		if (sh.pces[probeHash % sh.pces.size()].Retrieve(fontId, sv, positions) ||
+			sh.pces[(probeHash * 37) % sh.pces.size()].Retrieve(fontId, sv, positions)) {
+			hits.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	misses.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+void PositionCacheStore::Store(unsigned int fontId, std::string_view sv, const XYPOSITION *positions) {
+	const size_t hashValue = PositionCacheEntry::Hash(fontId, sv);
+	Shard &sh = shard[hashValue % shards];
+	std::unique_lock<std::shared_mutex> guard(sh.mutex);
+	if (sh.pces.empty()) {
+		return;
+	}
+	// Choose the oldest of the two slots to replace
+	const size_t probeHash = hashValue / shards;
+	size_t probe = probeHash % sh.pces.size();
+	const size_t probe2 = (probeHash * 37) % sh.pces.size();
+	if (sh.pces[probe].NewerThan(sh.pces[probe2])) {
+		probe = probe2;
+	}
+	sh.clock++;
+	if (sh.clock > 60000) {
+		// Since there are only 16 bits for the clock, wrap it round and
+		// reset all cache entries so none get stuck with a high clock.
+		for (PositionCacheEntry &pce : sh.pces) {
+			pce.ResetClock();
+		}
+		sh.clock = 2;
+	}
+	if (!sh.pces[probe].Empty()) {
+		evictions.fetch_add(1, std::memory_order_relaxed);
+	}
+	sh.allClear = false;
+	sh.pces[probe].Set(fontId, sv, positions, sh.clock);
+}
+
+size_t PositionCacheStore::Statistic(LayoutCacheStatistic statistic) {
+	switch (statistic) {
+	case LayoutCacheStatistic::Hits:
+		return hits;
+	case LayoutCacheStatistic::Misses:
+		return misses;
+	case LayoutCacheStatistic::Evictions:
+		return evictions;
+	case LayoutCacheStatistic::Entries:
+	case LayoutCacheStatistic::Memory: {
+			size_t entries = 0;
+			size_t memory = 0;
+			for (Shard &sh : shard) {
+				std::shared_lock<std::shared_mutex> guard(sh.mutex);
+				for (const PositionCacheEntry &pce : sh.pces) {
+					if (!pce.Empty()) {
+						entries++;
+					}
+					memory += pce.Memory();
+				}
+			}
+			return (statistic == LayoutCacheStatistic::Entries) ? entries : memory;
+		}
+	}
+	return 0;
+}
+
+void PositionCacheStore::ResetStatistics() noexcept {
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+// Each view has its own PositionCache which maps its style numbers to shared font identifiers.
+class PositionCache : public IPositionCache {
+	std::mutex mutex;
+	std::vector<unsigned int> fontIds;	// Indexed by style number, 0 when not yet found
+	unsigned int generation;
+	int codePage;
+	unsigned int FontIdForStyle(Surface *surface, const ViewStyle &vstyle, unsigned int styleNumber, int codePage_);
+public:
+	PositionCache();
+	// Deleted so PositionCache objects can not be copied.
+	PositionCache(const PositionCache &) = delete;
+	PositionCache(PositionCache &&) = delete;
+	void operator=(const PositionCache &) = delete;
+	void operator=(PositionCache &&) = delete;
+	~PositionCache() override = default;
+
+	void Clear() noexcept override;
+	void SetSize(size_t size_) override;
+	size_t GetSize() const noexcept override;
+	size_t Statistic(LayoutCacheStatistic statistic) override;
+	void ResetStatistics() noexcept override;
+	void MeasureWidths(Surface *surface, const ViewStyle &vstyle, unsigned int styleNumber,
+		std::string_view sv, XYPOSITION *positions, int codePage_) override;
+};
+
+PositionCache::PositionCache() : generation(0), codePage(0) {
+}
+
+unsigned int PositionCache::FontIdForStyle(Surface *surface, const ViewStyle &vstyle, unsigned int styleNumber, int codePage_) {
+	PositionCacheStore &store = PositionCacheStore::Instance();
+	// Always lock as lines of a view may be laid out on several threads
+	std::lock_guard<std::mutex> guard(mutex);
+	if ((generation != store.Generation()) || (codePage != codePage_)) {
+		fontIds.clear();
+		generation = store.Generation();
+		codePage = codePage_;
+	}
+	if (styleNumber >= fontIds.size()) {
+		fontIds.resize(vstyle.styles.size(), 0);
+	}
+	if (fontIds[styleNumber] == 0) {
+		const Style &style = vstyle.styles[styleNumber];
+		FontKey key;
+		if (style.fontName) {
+			key.fontName = style.fontName;
+		}
+		key.sizeZoomed = style.sizeZoomed;
+		key.weight = style.weight;
+		key.italic = style.italic;
+		key.characterSet = style.characterSet;
+		key.extraFontFlag = style.extraFontFlag;
+		key.technology = vstyle.technology;
+		key.logPixelsY = surface->LogPixelsY();
+		key.codePage = codePage_;
+		fontIds[styleNumber] = store.FontId(key);
+	}
+	return fontIds[styleNumber];
+}
+
+void PositionCache::Clear() noexcept {
+	// Shared entries stay valid for other views, only this view's styles may have changed
+	std::lock_guard<std::mutex> guard(mutex);
+	fontIds.clear();
+}
+
 void PositionCache::SetSize(size_t size_) {
-	Clear();
-	pces.resize(size_);
+	PositionCacheStore::Instance().SetSize(size_);
 }
 
 size_t PositionCache::GetSize() const noexcept {
-	return pces.size();
+	return PositionCacheStore::Instance().GetSize();
+}
+
+size_t PositionCache::Statistic(LayoutCacheStatistic statistic) {
+	return PositionCacheStore::Instance().Statistic(statistic);
+}
+
+void PositionCache::ResetStatistics() noexcept {
+	PositionCacheStore::Instance().ResetStatistics();
 }
 
 void PositionCache::MeasureWidths(Surface *surface, const ViewStyle &vstyle, unsigned int styleNumber,
-	std::string_view sv, XYPOSITION *positions, bool needsLocking) {
+	std::string_view sv, XYPOSITION *positions, int codePage_) {
 	const Style &style = vstyle.styles[styleNumber];
 	if (style.monospaceASCII) {
 		if (AllGraphicASCII(sv)) {
@@ -948,53 +1325,27 @@ void PositionCache::MeasureWidths(Surface *surface, const ViewStyle &vstyle, uns
 		}
 	}
 
-	size_t probe = pces.size();	// Out of bounds
-	if ((!pces.empty()) && (sv.length() < 30)) {
-		// Only store short strings in the cache so it doesn't churn with
-		// long comments with only a single comment.
-
-		// Two way associative: try two probe positions.
-		const size_t hashValue = PositionCacheEntry::Hash(styleNumber, sv);
-		probe = hashValue % pces.size();
-		std::unique_lock<std::mutex> guard(mutex, std::defer_lock);
-		if (needsLocking) {
-			guard.lock();
-		}
-		if (pces[probe].Retrieve(styleNumber, sv, positions)) {
+	PositionCacheStore &store = PositionCacheStore::Instance();
+	// Only store short strings in the cache so it doesn't churn with
+	// long comments with only a single comment.
+	const bool cacheable = (store.GetSize() > 0) && (sv.length() < 30);
+	unsigned int fontId = 0;
+	if (cacheable) {
+		fontId = FontIdForStyle(surface, vstyle, styleNumber, codePage_);
+		if (store.Retrieve(fontId, sv, positions)) {
 			return;
 		}
-		const size_t probe2 = (hashValue * 37) % pces.size();
-		if (pces[probe2].Retrieve(styleNumber, sv, positions)) {
-			return;
-		}
-		// Not found. Choose the oldest of the two slots to replace
-		if (pces[probe].NewerThan(pces[probe2])) {
-			probe = probe2;
-		}
 	}
 
 	const Font *fontStyle = style.font.get();
 	surface->MeasureWidths(fontStyle, sv, positions);
-	if (probe < pces.size()) {
-		// Store into cache
-		std::unique_lock<std::mutex> guard(mutex, std::defer_lock);
-		if (needsLocking) {
-			guard.lock();
-		}
-		clock++;
-		if (clock > 60000) {
-			// Since there are only 16 bits for the clock, wrap it round and
-			// reset all cache entries so none get stuck with a high clock.
-			for (PositionCacheEntry &pce : pces) {
-				pce.ResetClock();
-			}
-			clock = 2;
-		}
-		allClear = false;
-		pces[probe].Set(styleNumber, sv, positions, clock);
+	if (cacheable) {
+		store.Store(fontId, sv, positions);
 	}
 }
 
+}
+
 std::unique_ptr<IPositionCache> Scintilla::Internal::CreatePositionCache() {
 	return std::make_unique<PositionCache>();
 }
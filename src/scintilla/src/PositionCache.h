@@ -84,11 +84,13 @@ public:
 	void operator=(LineLayout &&) = delete;
 	virtual ~LineLayout();
 	void Resize(int maxLineLength_);
+	void Reuse(Sci::Line lineNumber_, int maxLineLength_);
 	void EnsureBidiData();
 	void Free() noexcept;
 	void Invalidate(ValidLevel validity_) noexcept;
 	Sci::Line LineNumber() const noexcept;
 	bool CanHold(Sci::Line lineDoc, int lineLength_) const noexcept;
+	size_t Memory() const noexcept;
 	int LineStart(int line) const noexcept;
 	int LineLength(int line) const noexcept;
 	enum class Scope { visibleOnly, includeEnd };
@@ -141,12 +143,30 @@ struct ScreenLine : public IScreenLine {
 class LineLayoutCache {
 public:
 private:
+	struct Recent {
+		std::shared_ptr<LineLayout> ll;
+		size_t lastUsed;
+		size_t memory;
+	};
 	Scintilla::LineCache level;
 	std::vector<std::shared_ptr<LineLayout>>cache;
+	// With a budget, the page and document levels keep the most recently used layouts
+	// that fit in budget bytes instead of a fixed number of lines.
+	std::map<Sci::Line, Recent> recent;
+	// The lines in recent by when they were last used so the least recently used is first
+	std::map<size_t, Sci::Line> uses;
+	size_t budget;
+	size_t memory;
+	size_t useClock;
 	bool allInvalidated;
 	int styleClock;
+	size_t hits;
+	size_t misses;
+	size_t evictions;
 	size_t EntryForLine(Sci::Line line) const noexcept;
 	void AllocateForLevel(Sci::Line linesOnScreen, Sci::Line linesInDoc);
+	std::shared_ptr<LineLayout> RetrieveRecent(Sci::Line lineNumber, int maxChars);
+	void EvictToBudget();
 public:
 	LineLayoutCache();
 	// Deleted so LineLayoutCache objects can not be copied.
@@ -159,6 +179,11 @@ public:
 	void Invalidate(LineLayout::ValidLevel validity_) noexcept;
 	void SetLevel(Scintilla::LineCache level_) noexcept;
 	Scintilla::LineCache GetLevel() const noexcept { return level; }
+	void SetBudget(size_t budget_) noexcept;
+	size_t GetBudget() const noexcept { return budget; }
+	bool Budgeted() const noexcept;
+	size_t Statistic(Scintilla::LayoutCacheStatistic statistic) const noexcept;
+	void ResetStatistics() noexcept;
 	std::shared_ptr<LineLayout> Retrieve(Sci::Line lineNumber, Sci::Line lineCaret, int maxChars, int styleClock_,
 		Sci::Line linesOnScreen, Sci::Line linesInDoc);
 };
@@ -252,10 +277,14 @@ public:
 	virtual void Clear() noexcept = 0;
 	virtual void SetSize(size_t size_) = 0;
 	virtual size_t GetSize() const noexcept = 0;
+	virtual size_t Statistic(Scintilla::LayoutCacheStatistic statistic) = 0;
+	virtual void ResetStatistics() noexcept = 0;
 	virtual void MeasureWidths(Surface *surface, const ViewStyle &vstyle, unsigned int styleNumber,
-		std::string_view sv, XYPOSITION *positions, bool needsLocking) = 0;
+		std::string_view sv, XYPOSITION *positions, int codePage) = 0;
 };
 
+// The returned object is owned by a view but its measurements are held in a single
+// store shared by all views in the process. Clear only forgets the view's styles.
 std::unique_ptr<IPositionCache> CreatePositionCache();
 
 }
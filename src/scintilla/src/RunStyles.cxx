@@ -77,6 +77,64 @@ void RunStyles<DISTANCE, STYLE>::RemoveRunIfSameAsPrevious(DISTANCE run) {
 	}
 }
 
+// Build the runs for a whole set of ranges in one pass over the old runs instead of splitting
+// and merging runs for each range, which is slow when there are many ranges.
+template <typename DISTANCE, typename STYLE>
+FillResult<DISTANCE> RunStyles<DISTANCE, STYLE>::RebuildWithRanges(const DISTANCE *ranges, size_t rangeCount, STYLE value, bool keepOutside) {
+	const DISTANCE length = Length();
+	std::vector<DISTANCE> runStarts;
+	std::vector<STYLE> runStyles;
+	DISTANCE changeStart = length;
+	DISTANCE changeEnd = 0;
+	DISTANCE run = 0;
+	// Append the piece of the document from position to end, which is inside the ranges or not
+	auto appendPiece = [&](DISTANCE position, DISTANCE end, bool inRange) {
+		while (position < end) {
+			const DISTANCE runEnd = starts->PositionFromPartition(run + 1);
+			const DISTANCE pieceEnd = std::min(runEnd, end);
+			const STYLE styleOld = styles->ValueAt(run);
+			const STYLE styleNew = inRange ? value : (keepOutside ? styleOld : STYLE());
+			if (styleNew != styleOld) {
+				changeStart = std::min(changeStart, position);
+				changeEnd = pieceEnd;
+			}
+			if (runStyles.empty() || (runStyles.back() != styleNew)) {
+				runStarts.push_back(position);
+				runStyles.push_back(styleNew);
+			}
+			position = pieceEnd;
+			if (pieceEnd == runEnd) {
+				run++;
+			}
+		}
+	};
+	DISTANCE position = 0;
+	for (size_t i = 0; i < rangeCount; i++) {
+		const DISTANCE rangeStart = std::max(ranges[i * 2], position);
+		const DISTANCE rangeEnd = std::min(ranges[i * 2] + ranges[i * 2 + 1], length);
+		if (rangeStart < rangeEnd) {
+			appendPiece(position, rangeStart, false);
+			appendPiece(rangeStart, rangeEnd, true);
+			position = rangeEnd;
+		}
+	}
+	appendPiece(position, length, false);
+
+	if (changeStart >= changeEnd) {
+		return FillResult<DISTANCE>{false, 0, 0};
+	}
+
+	starts = std::make_unique<Partitioning<DISTANCE>>(8);
+	starts->ReAllocate(runStarts.size());
+	starts->InsertText(0, length);
+	starts->InsertPartitions(1, runStarts.data() + 1, runStarts.size() - 1);
+	styles = std::make_unique<SplitVector<STYLE>>();
+	styles->ReAllocate(runStyles.size() + 1);
+	styles->InsertFromArray(0, runStyles.data(), 0, runStyles.size());
+	styles->InsertValue(styles->Length(), 1, 0);
+	return FillResult<DISTANCE>{true, changeStart, changeEnd - changeStart};
+}
+
 template <typename DISTANCE, typename STYLE>
 RunStyles<DISTANCE, STYLE>::RunStyles() {
 	starts = std::make_unique<Partitioning<DISTANCE>>(8);
@@ -180,6 +238,16 @@ FillResult<DISTANCE> RunStyles<DISTANCE, STYLE>::FillRange(DISTANCE position, ST
 	}
 }
 
+template <typename DISTANCE, typename STYLE>
+FillResult<DISTANCE> RunStyles<DISTANCE, STYLE>::FillRanges(const DISTANCE *ranges, size_t rangeCount, STYLE value) {
+	return RebuildWithRanges(ranges, rangeCount, value, true);
+}
+
+template <typename DISTANCE, typename STYLE>
+FillResult<DISTANCE> RunStyles<DISTANCE, STYLE>::ReplaceRanges(const DISTANCE *ranges, size_t rangeCount, STYLE value) {
+	return RebuildWithRanges(ranges, rangeCount, value, false);
+}
+
 template <typename DISTANCE, typename STYLE>
 void RunStyles<DISTANCE, STYLE>::SetValueAt(DISTANCE position, STYLE value) {
 	FillRange(position, value, 1);
@@ -32,6 +32,7 @@ private:
 	void RemoveRun(DISTANCE run);
 	void RemoveRunIfEmpty(DISTANCE run);
 	void RemoveRunIfSameAsPrevious(DISTANCE run);
+	FillResult<DISTANCE> RebuildWithRanges(const DISTANCE *ranges, size_t rangeCount, STYLE value, bool keepOutside);
 public:
 	RunStyles();
 	// Deleted so RunStyles objects can not be copied.
@@ -47,6 +48,11 @@ public:
 	DISTANCE EndRun(DISTANCE position) const noexcept;
 	// Returns changed=true if some values may have changed
 	FillResult<DISTANCE> FillRange(DISTANCE position, STYLE value, DISTANCE fillLength);
+	// Ranges are pairs of position and length, sorted by position and not overlapping.
+	// Returns changed=true if some values may have changed
+	FillResult<DISTANCE> FillRanges(const DISTANCE *ranges, size_t rangeCount, STYLE value);
+	// As FillRanges but everywhere outside the ranges is set to 0
+	FillResult<DISTANCE> ReplaceRanges(const DISTANCE *ranges, size_t rangeCount, STYLE value);
 	void SetValueAt(DISTANCE position, STYLE value);
 	void InsertSpace(DISTANCE position, DISTANCE insertLength);
 	void DeleteAll();
@@ -340,6 +340,21 @@ public:
 		}
 	}
 
+	/// Return a pointer to the first element on the same side of the gap as position
+	/// and set the range of elements on that side.
+	/// Does not rearrange the buffer.
+	const T *SegmentPointer(ptrdiff_t position, ptrdiff_t &segmentStart, ptrdiff_t &segmentEnd) const noexcept {
+		if (position < part1Length) {
+			segmentStart = 0;
+			segmentEnd = part1Length;
+			return body.data();
+		} else {
+			segmentStart = part1Length;
+			segmentEnd = lengthBody;
+			return body.data() + part1Length + gapLength;
+		}
+	}
+
 	/// Return the position of the gap within the buffer.
 	ptrdiff_t GapPosition() const noexcept {
 		return part1Length;
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstring>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 #include <optional>
@@ -133,6 +134,123 @@ TEST_CASE("CellBuffer") {
 		REQUIRE(!cb.CanRedo());
 	}
 
+	SECTION("UndoLargeInsertion") {
+		// Larger than a chunk of undo storage so gets its own chunk
+		const std::string large(0x20000, 'x');
+		bool startSequence = false;
+		cb.InsertString(0, sText, sLength, startSequence);
+		cb.InsertString(0, large.c_str(), large.length(), startSequence);
+		cb.DeleteChars(0, 3, startSequence);
+		REQUIRE(cb.Length() == static_cast<Sci::Position>(large.length() + sLength - 3));
+		cb.StartUndo();
+		const Action action = cb.GetUndoStep();
+		REQUIRE(action.at == ActionType::remove);
+		REQUIRE(memcmp(action.data, "xxx", 3) == 0);
+		cb.PerformUndoStep();
+		cb.StartUndo();
+		REQUIRE(cb.GetUndoStep().lenData == static_cast<Sci::Position>(large.length()));
+		cb.PerformUndoStep();
+		REQUIRE(memcmp(cb.BufferPointer(), sText, sLength) == 0);
+		cb.StartRedo();
+		cb.PerformRedoStep();
+		REQUIRE(cb.Length() == static_cast<Sci::Position>(large.length() + sLength));
+		REQUIRE(cb.CharAt(0) == 'x');
+	}
+
+	SECTION("UndoMemoryLimit") {
+		REQUIRE(cb.UndoMemoryLimit() == 0);
+		const std::string block(0x1000, 'a');
+		bool startSequence = false;
+		// Separate undo transactions as each insertion is at the start
+		for (int i = 0; i < 200; i++) {
+			cb.InsertString(0, block.c_str(), block.length(), startSequence);
+			REQUIRE(startSequence);
+		}
+		const size_t unlimited = cb.UndoMemory();
+		REQUIRE(unlimited >= 200 * block.length());
+
+		cb.SetUndoMemoryLimit(0x40000);
+		REQUIRE(cb.UndoMemoryLimit() == 0x40000);
+		REQUIRE(cb.UndoMemory() < unlimited);
+		REQUIRE(cb.UndoMemory() <= 0x40000);
+		REQUIRE(!cb.IsSavePoint());
+
+		// Only the most recent transactions remain
+		int undone = 0;
+		while (cb.CanUndo()) {
+			const int steps = cb.StartUndo();
+			for (int step = 0; step < steps; step++) {
+				cb.PerformUndoStep();
+			}
+			undone++;
+		}
+		REQUIRE(undone > 0);
+		REQUIRE(undone < 200);
+		REQUIRE(cb.Length() == static_cast<Sci::Position>((200 - undone) * block.length()));
+
+		// Redo all the way back
+		while (cb.CanRedo()) {
+			const int steps = cb.StartRedo();
+			for (int step = 0; step < steps; step++) {
+				cb.PerformRedoStep();
+			}
+		}
+		REQUIRE(cb.Length() == static_cast<Sci::Position>(200 * block.length()));
+
+		// Limit is kept as new actions are added
+		for (int i = 0; i < 200; i++) {
+			cb.InsertString(0, block.c_str(), block.length(), startSequence);
+		}
+		REQUIRE(cb.UndoMemory() <= 0x40000);
+	}
+
+	SECTION("UndoSaveRestore") {
+		bool startSequence = false;
+		cb.InsertString(0, sText, sLength, startSequence);
+		cb.SetSavePoint();
+		cb.DeleteChars(1, 2, startSequence);
+		cb.InsertString(0, "ab", 2, startSequence);
+		cb.StartUndo();
+		cb.PerformUndoStep();
+		REQUIRE(memcmp(cb.BufferPointer(), "Sntilla", 7) == 0);
+
+		// Rebuild the history in a buffer with the same text
+		CellBuffer copy(true, false);
+		copy.InsertString(0, "Sntilla", 7, startSequence);
+		copy.DeleteUndoHistory();
+		REQUIRE(copy.UndoActions() == 1);
+		for (int act = 1; act < cb.UndoActions(); act++) {
+			const Action action = cb.GetUndoAction(act);
+			copy.PushUndoAction(action.at, action.position, action.mayCoalesce);
+			copy.ChangeLastUndoActionText(action.data, action.lenData);
+		}
+		copy.SetUndoCurrent(cb.UndoCurrent());
+		copy.SetUndoSavePoint(cb.UndoSavePoint());
+		REQUIRE(copy.UndoActions() == cb.UndoActions());
+		REQUIRE(!copy.IsSavePoint());
+
+		// Out of range actions are empty
+		REQUIRE(copy.GetUndoAction(-1).lenData == 0);
+		REQUIRE(copy.GetUndoAction(copy.UndoActions()).at == ActionType::start);
+
+		int steps = copy.StartRedo();
+		REQUIRE(steps == 1);
+		copy.PerformRedoStep();
+		REQUIRE(memcmp(copy.BufferPointer(), "abSntilla", 9) == 0);
+		steps = copy.StartUndo();
+		copy.PerformUndoStep();
+		steps = copy.StartUndo();
+		REQUIRE(steps == 1);
+		copy.PerformUndoStep();
+		REQUIRE(memcmp(copy.BufferPointer(), sText, sLength) == 0);
+		REQUIRE(copy.IsSavePoint());
+		// The original insertion is before the save point
+		copy.StartUndo();
+		copy.PerformUndoStep();
+		REQUIRE(copy.Length() == 0);
+		REQUIRE(!copy.CanUndo());
+	}
+
 	SECTION("LineEndTypes") {
 		REQUIRE(cb.GetLineEndTypes() == LineEndType::Default);
 		cb.SetLineEndTypes(LineEndType::Unicode);
@@ -152,6 +270,61 @@ TEST_CASE("CellBuffer") {
 
 }
 
+TEST_CASE("CellBufferPieceTable") {
+
+	const char sText[] = "Scintilla\nline two\n";
+	const Sci::Position sLength = static_cast<Sci::Position>(strlen(sText));
+
+	CellBuffer cb(true, false, true);
+	bool startSequence = false;
+	cb.InsertString(0, sText, sLength, startSequence);
+
+	SECTION("Setup") {
+		REQUIRE(cb.IsPieceTable());
+		REQUIRE(sLength == cb.Length());
+		REQUIRE(3 == cb.Lines());
+		REQUIRE(10 == cb.LineStart(1));
+		REQUIRE('l' == cb.CharAt(10));
+	}
+
+	SECTION("ScatteredEdits") {
+		cb.InsertString(10, "\n", 1, startSequence);
+		cb.InsertString(0, ">", 1, startSequence);
+		REQUIRE(4 == cb.Lines());
+		REQUIRE(memcmp(cb.BufferPointer(), ">Scintilla\n\nline two\n", sLength + 2) == 0);
+		const char *cpDeletion = cb.DeleteChars(9, 4, startSequence);
+		REQUIRE(memcmp(cpDeletion, "a\n\nl", 4) == 0);
+		REQUIRE(2 == cb.Lines());
+		REQUIRE(memcmp(cb.BufferPointer(), ">Scintilline two\n", sLength - 2) == 0);
+	}
+
+	SECTION("Styles") {
+		cb.InsertString(3, "__", 2, startSequence);
+		REQUIRE(cb.SetStyleFor(0, cb.Length(), 2));
+		REQUIRE(cb.SetStyleAt(4, 7));
+		REQUIRE(!cb.SetStyleAt(4, 7));
+		unsigned char styles[6] {};
+		cb.GetStyleRange(styles, 1, 5);
+		REQUIRE(std::string_view(reinterpret_cast<const char *>(styles), 5) == "\2\2\2\7\2");
+	}
+
+	SECTION("UndoRedo") {
+		cb.DeleteChars(1, 2, startSequence);
+		cb.InsertString(5, "XYZ", 3, startSequence);
+		REQUIRE(memcmp(cb.BufferPointer(), "SntilXYZla", 10) == 0);
+		int steps = cb.StartUndo();
+		REQUIRE(steps == 1);
+		cb.PerformUndoStep();
+		steps = cb.StartUndo();
+		REQUIRE(steps == 1);
+		cb.PerformUndoStep();
+		REQUIRE(memcmp(cb.BufferPointer(), sText, sLength) == 0);
+		steps = cb.StartRedo();
+		cb.PerformRedoStep();
+		REQUIRE(memcmp(cb.BufferPointer(), "Sntilla", 7) == 0);
+	}
+}
+
 TEST_CASE("CharacterIndex") {
 
 	CellBuffer cb(true, false);
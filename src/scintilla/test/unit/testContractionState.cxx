@@ -180,4 +180,57 @@ TEST_CASE("ContractionState") {
 		REQUIRE(strcmp(pcs->GetFoldDisplayText(4), "xyz") == 0);
 	}
 
+	SECTION("SetVisibleRanges") {
+		pcs->InsertLines(0, 9);
+		REQUIRE(10 == pcs->LinesInDoc());
+		pcs->SetHeight(3, 2);
+		const Sci::Line hide[] = { 1, 2, 5, 3 };
+		REQUIRE(true == pcs->SetVisibleRanges(hide, 2, false));
+		REQUIRE(false == pcs->SetVisibleRanges(hide, 2, false));
+		REQUIRE(true == pcs->GetVisible(0));
+		REQUIRE(false == pcs->GetVisible(1));
+		REQUIRE(false == pcs->GetVisible(2));
+		REQUIRE(true == pcs->GetVisible(3));
+		REQUIRE(true == pcs->GetVisible(4));
+		REQUIRE(false == pcs->GetVisible(7));
+		REQUIRE(true == pcs->GetVisible(8));
+		REQUIRE(6 == pcs->LinesDisplayed());
+		REQUIRE(1 == pcs->DisplayFromDoc(3));
+		REQUIRE(3 == pcs->DisplayFromDoc(4));
+		REQUIRE(4 == pcs->DisplayFromDoc(8));
+		REQUIRE(3 == pcs->DocFromDisplay(2));
+		REQUIRE(9 == pcs->DocFromDisplay(5));
+
+		// Same as hiding line by line
+		std::unique_ptr<IContractionState> pcsLines = ContractionStateCreate(false);
+		pcsLines->InsertLines(0, 9);
+		pcsLines->SetHeight(3, 2);
+		pcsLines->SetVisible(1, 2, false);
+		pcsLines->SetVisible(5, 7, false);
+		REQUIRE(pcsLines->LinesDisplayed() == pcs->LinesDisplayed());
+		for (Sci::Line line = 0; line < pcs->LinesInDoc(); line++) {
+			REQUIRE(pcsLines->DisplayFromDoc(line) == pcs->DisplayFromDoc(line));
+		}
+
+		const Sci::Line all[] = { 0, 10 };
+		REQUIRE(true == pcs->SetVisibleRanges(all, 1, true));
+		REQUIRE(11 == pcs->LinesDisplayed());
+		REQUIRE(false == pcs->HiddenLines());
+	}
+
+	SECTION("SetExpandedRanges") {
+		pcs->InsertLines(0, 4);
+		const Sci::Line headers[] = { 1, 1, 3, 1 };
+		REQUIRE(true == pcs->SetExpandedRanges(headers, 2, false));
+		REQUIRE(true == pcs->GetExpanded(0));
+		REQUIRE(false == pcs->GetExpanded(1));
+		REQUIRE(true == pcs->GetExpanded(2));
+		REQUIRE(false == pcs->GetExpanded(3));
+		REQUIRE(1 == pcs->ContractedNext(0));
+		REQUIRE(3 == pcs->ContractedNext(2));
+		REQUIRE(true == pcs->SetExpandedRanges(headers, 2, true));
+		REQUIRE(false == pcs->SetExpandedRanges(headers, 2, true));
+		REQUIRE(-1 == pcs->ContractedNext(0));
+	}
+
 }
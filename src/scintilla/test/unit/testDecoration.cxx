@@ -95,4 +95,30 @@ TEST_CASE("DecorationList") {
 		REQUIRE(decol->End(indicatorB, 5) == 6);
 	}
 
+	SECTION("FillRanges") {
+		decol->SetCurrentIndicator(indicator);
+		decol->InsertSpace(0, 20);
+		const Sci::Position ranges[] = { 2, 3, 10, 4 };
+		auto fr = decol->FillRanges(ranges, 2, 1, false);
+		REQUIRE(fr.changed);
+		REQUIRE(fr.position == 2);
+		REQUIRE(fr.fillLength == 12);
+		REQUIRE(decol->View().size() == 1);
+		REQUIRE(decol->Start(indicator, 11) == 10);
+		REQUIRE(decol->End(indicator, 11) == 14);
+		const Sci::Position rangesNew[] = { 12, 6 };
+		fr = decol->FillRanges(rangesNew, 1, 1, true);
+		REQUIRE(fr.changed);
+		REQUIRE(fr.position == 2);
+		REQUIRE(fr.fillLength == 16);
+		REQUIRE(decol->ValueAt(indicator, 3) == 0);
+		REQUIRE(decol->ValueAt(indicator, 11) == 0);
+		REQUIRE(decol->Start(indicator, 13) == 12);
+		REQUIRE(decol->End(indicator, 13) == 18);
+		// Replacing with no ranges deletes the decoration
+		fr = decol->FillRanges(nullptr, 0, 1, true);
+		REQUIRE(fr.changed);
+		REQUIRE(decol->View().empty());
+	}
+
 }
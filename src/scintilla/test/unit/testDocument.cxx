@@ -127,6 +127,62 @@ struct DocPlus {
 	}
 };
 
+// Minimal lexer for C-style comments that can be checkpointed and counts how much it lexes.
+class CommentLexer final : public ILexer5, public ILexerCheckpoint {
+public:
+	Sci_Position lexed = 0;
+	int SCI_METHOD Version() const override { return lvRelease5; }
+	void SCI_METHOD Release() override { delete this; }
+	const char *SCI_METHOD PropertyNames() override { return ""; }
+	int SCI_METHOD PropertyType(const char *) override { return 0; }
+	const char *SCI_METHOD DescribeProperty(const char *) override { return ""; }
+	Sci_Position SCI_METHOD PropertySet(const char *, const char *) override { return -1; }
+	const char *SCI_METHOD DescribeWordListSets() override { return ""; }
+	Sci_Position SCI_METHOD WordListSet(int, const char *) override { return -1; }
+	void SCI_METHOD Lex(Sci_PositionU startPos, Sci_Position lengthDoc, int initStyle, IDocument *pAccess) override {
+		lexed += lengthDoc;
+		std::string text(lengthDoc, '\0');
+		pAccess->GetCharRange(text.data(), startPos, lengthDoc);
+		std::string styles(lengthDoc, '\0');
+		int style = initStyle;
+		for (size_t i = 0; i < text.length(); i++) {
+			if ((style == 0) && (text.compare(i, 2, "/*") == 0))
+				style = 1;
+			styles[i] = static_cast<char>(style);
+			if ((style == 1) && (i > 0) && (text.compare(i - 1, 2, "*/") == 0))
+				style = 0;
+		}
+		pAccess->StartStyling(startPos);
+		pAccess->SetStyles(lengthDoc, styles.data());
+	}
+	void SCI_METHOD Fold(Sci_PositionU, Sci_Position, int, IDocument *) override {}
+	void *SCI_METHOD PrivateCall(int operation, void *) override {
+		return (operation == lpcCheckpoint) ? static_cast<ILexerCheckpoint *>(this) : nullptr;
+	}
+	int SCI_METHOD LineEndTypesSupported() override { return 0; }
+	int SCI_METHOD AllocateSubStyles(int, int) override { return -1; }
+	int SCI_METHOD SubStylesStart(int) override { return -1; }
+	int SCI_METHOD SubStylesLength(int) override { return 0; }
+	int SCI_METHOD StyleFromSubStyle(int subStyle) override { return subStyle; }
+	int SCI_METHOD PrimaryStyleFromStyle(int style) override { return style; }
+	void SCI_METHOD FreeSubStyles() override {}
+	void SCI_METHOD SetIdentifiers(int, const char *) override {}
+	int SCI_METHOD DistanceToSecondaryStyles() override { return 0; }
+	const char *SCI_METHOD GetSubStyleBases() override { return ""; }
+	int SCI_METHOD NamedStyles() override { return 0; }
+	const char *SCI_METHOD NameOfStyle(int) override { return ""; }
+	const char *SCI_METHOD TagsOfStyle(int) override { return ""; }
+	const char *SCI_METHOD DescriptionOfStyle(int) override { return ""; }
+	const char *SCI_METHOD GetName() override { return "comment"; }
+	int SCI_METHOD GetIdentifier() override { return 0; }
+	const char *SCI_METHOD PropertyGet(const char *) override { return ""; }
+	// All state is in the styles
+	const char *SCI_METHOD CheckpointState(Sci_Position, Sci_Position *length, IDocument *) override {
+		*length = 0;
+		return "";
+	}
+};
+
 void TimeTrace(std::string_view sv, const Catch::Timer &tikka) {
 	std::cout << sv << std::setw(5) << tikka.getElapsedMilliseconds() << " milliseconds" << std::endl;
 }
@@ -150,6 +206,21 @@ TEST_CASE("Document") {
 		REQUIRE(!doc.document.CanRedo());
 	}
 
+	SECTION("ModificationCount") {
+		DocPlus doc("", 0);
+		const Sci::Position initial = doc.document.ModificationCount();
+		doc.document.InsertString(0, sText, sLength);
+		REQUIRE(initial + 1 == doc.document.ModificationCount());
+		doc.document.DeleteChars(0, 3);
+		REQUIRE(initial + 2 == doc.document.ModificationCount());
+		doc.document.Undo();
+		REQUIRE(initial + 3 == doc.document.ModificationCount());
+		// Styling does not change the text
+		doc.document.StartStyling(0);
+		doc.document.SetStyleFor(sLength, 1);
+		REQUIRE(initial + 3 == doc.document.ModificationCount());
+	}
+
 	// Search ranges are from first argument to just before second argument
 	// Arguments are expected to be at character boundaries and will be tweaked if
 	// part way through a character.
@@ -180,6 +251,21 @@ TEST_CASE("Document") {
 		}
 	}
 
+	SECTION("SearchInPieces") {
+		Document document(DocumentOption::PieceTable);
+		document.InsertString(0, "abcdef", 6);
+		// Inserting in the middle splits the text over several pieces
+		document.InsertString(3, "XY", 2);
+		document.InsertString(0, "Z", 1);	// Z a b c X Y d e f
+		Sci::Position lengthFinding = 3;
+		REQUIRE(document.FindText(0, document.Length(), "cXY", FindOption::MatchCase, &lengthFinding) == 3);
+		REQUIRE(document.FindText(document.Length(), 0, "cXY", FindOption::MatchCase, &lengthFinding) == 3);
+		REQUIRE(document.FindText(0, document.Length(), "Yde", FindOption::MatchCase, &lengthFinding) == 5);
+		lengthFinding = 2;
+		REQUIRE(document.FindText(0, document.Length(), "ef", FindOption::MatchCase, &lengthFinding) == 7);
+		REQUIRE(document.FindText(0, 7, "ef", FindOption::MatchCase, &lengthFinding) == -1);
+	}
+
 	SECTION("InsensitiveSearchInLatin") {
 		DocPlus doc("abcde", 0);	// a b c d e
 		std::string finding = "B";
@@ -456,6 +542,125 @@ TEST_CASE("Document") {
 
 }
 
+TEST_CASE("Checkpoints") {
+
+	std::string text;
+	for (int line = 0; line < 1000; line++) {
+		text += "int x;\n";
+	}
+	DocPlus doc(text, 0);
+	Document &document = doc.document;
+	document.SetLexInterface(std::make_unique<LexInterface>(&document));
+	CommentLexer *lexer = new CommentLexer();
+	document.GetLexInterface()->SetInstance(lexer);
+	document.EnsureStyledTo(document.Length());
+	REQUIRE(lexer->lexed == document.Length());
+	const Sci::Position withinCheckpoint = document.LineStart(LexInterface::linesPerCheckpoint + 1);
+
+	SECTION("TypingStopsAtCheckpoint") {
+		lexer->lexed = 0;
+		document.InsertString(0, "x", 1);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.GetEndStyled() == document.Length());
+		REQUIRE(lexer->lexed <= withinCheckpoint);
+		document.DeleteChars(0, 1);
+		document.EnsureStyledTo(document.Length());
+		document.InsertString(document.LineStart(10), "\n\n", 2);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.GetEndStyled() == document.Length());
+		REQUIRE(lexer->lexed <= 3 * withinCheckpoint);
+	}
+
+	SECTION("CommentRestylesToEnd") {
+		document.InsertString(0, "/*", 2);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.StyleAt(document.Length() - 1) == 1);
+		lexer->lexed = 0;
+		document.DeleteChars(0, 2);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.StyleAt(document.Length() - 1) == 0);
+		REQUIRE(lexer->lexed == document.Length());
+	}
+
+	SECTION("EditAfterEndStyled") {
+		// Styles after the second edit can not be reused
+		document.InsertString(0, "x", 1);
+		document.InsertString(document.LineStart(500), "/*", 2);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.StyleAt(document.LineStart(499)) == 0);
+		REQUIRE(document.StyleAt(document.Length() - 1) == 1);
+	}
+
+	SECTION("UndoRedo") {
+		document.InsertString(document.LineStart(200), "/*", 2);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.StyleAt(document.Length() - 1) == 1);
+		document.Undo();
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.StyleAt(document.Length() - 1) == 0);
+		document.Redo();
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.StyleAt(document.Length() - 1) == 1);
+	}
+
+	SECTION("StylesFromApplication") {
+		// Checkpoints do not describe styles set by the application so they are all lexed again
+		document.DiscardCheckpoints(0, document.Length());
+		document.StartStyling(0);
+		document.SetStyleFor(document.Length(), 2);
+		lexer->lexed = 0;
+		document.InsertString(0, "y", 1);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.StyleAt(document.Length() - 1) == 0);
+		REQUIRE(lexer->lexed == document.Length());
+	}
+
+	SECTION("CheckpointsFromApplication") {
+		// Styles from a lexer run by the application come with its checkpoints
+		document.DiscardCheckpoints(0, document.Length());
+		const std::string styles(document.Length(), '\0');
+		REQUIRE(document.StylesMatch(0, document.Length(), styles.data()));
+		REQUIRE(document.StyleMatches(0, document.Length(), 0));
+		REQUIRE(!document.StyleMatches(0, document.Length(), 1));
+		Sci::Position position = 0;
+		for (Sci::Line line = LexInterface::linesPerCheckpoint - 1; line < document.LinesTotal() - 1;
+			line += LexInterface::linesPerCheckpoint) {
+			const Sci::Position lineEnd = document.LineStart(line + 1);
+			document.StartStyling(position);
+			document.SetStyles(lineEnd - position, styles.data() + position);
+			REQUIRE(!document.StylingCheckpoint("", 0));
+			position = lineEnd;
+		}
+		document.StartStyling(position);
+		document.SetStyles(document.Length() - position, styles.data() + position);
+		lexer->lexed = 0;
+		document.InsertString(0, "x", 1);
+		document.EnsureStyledTo(document.Length());
+		REQUIRE(document.GetEndStyled() == document.Length());
+		REQUIRE(lexer->lexed <= withinCheckpoint);
+	}
+
+	SECTION("ConvergeFromApplication") {
+		// Reaching a checkpoint in the same state keeps the styles after it
+		document.InsertString(0, "x", 1);
+		REQUIRE(document.GetEndStyled() == 0);
+		const std::string styles(document.Length(), '\0');
+		const Sci::Position lineEnd = document.LineStart(LexInterface::linesPerCheckpoint);
+		document.StartStyling(0);
+		document.SetStyles(lineEnd, styles.data());
+		REQUIRE(document.StylingCheckpoint("", 0));
+		REQUIRE(document.GetEndStyled() == document.Length());
+	}
+
+	SECTION("CheckpointNotAtLineStart") {
+		document.InsertString(0, "x", 1);
+		document.StartStyling(0);
+		document.SetStyleFor(3, 0);
+		REQUIRE(!document.StylingCheckpoint("", 0));
+		REQUIRE(document.GetEndStyled() == 3);
+	}
+}
+
 TEST_CASE("Words") {
 
 	SECTION("WordsInText") {
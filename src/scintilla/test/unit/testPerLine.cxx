@@ -5,11 +5,13 @@
 #include <cstddef>
 #include <cstring>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 #include <forward_list>
 #include <optional>
 #include <algorithm>
+#include <iterator>
 #include <memory>
 
 #include "ScintillaTypes.h"
@@ -209,6 +211,109 @@ TEST_CASE("LineLevels") {
 		REQUIRE(2 == ll.GetLevel(4));
 		REQUIRE(FoldBase == ll.GetLevel(5));
 	}
+
+	SECTION("FoldParentAndEnd") {
+		constexpr int Header = static_cast<int>(Scintilla::FoldLevel::HeaderFlag);
+		constexpr int White = static_cast<int>(Scintilla::FoldLevel::WhiteFlag);
+		const int levels[] = {
+			FoldBase | Header,
+			FoldBase + 1,
+			(FoldBase + 1) | Header,
+			FoldBase + 2,
+			(FoldBase + 1) | White,
+			FoldBase + 1,
+			FoldBase | Header,
+			FoldBase + 1,
+		};
+		Sci::Line lines = static_cast<Sci::Line>(std::size(levels));
+		for (Sci::Line line = 0; line < lines; line++) {
+			ll.SetLevel(line, levels[line], lines);
+		}
+		REQUIRE(-1 == ll.FoldParent(0, lines));
+		REQUIRE(0 == ll.FoldParent(1, lines));
+		REQUIRE(0 == ll.FoldParent(2, lines));
+		REQUIRE(2 == ll.FoldParent(3, lines));
+		REQUIRE(0 == ll.FoldParent(4, lines));
+		REQUIRE(0 == ll.FoldParent(5, lines));
+		REQUIRE(-1 == ll.FoldParent(6, lines));
+		REQUIRE(6 == ll.FoldParent(7, lines));
+		REQUIRE(6 == ll.FoldEnd(0, lines));
+		REQUIRE(-1 == ll.FoldEnd(1, lines));
+		REQUIRE(5 == ll.FoldEnd(2, lines));
+		REQUIRE(8 == ll.FoldEnd(6, lines));
+
+		// Changes to levels and lines are followed
+		ll.SetLevel(5, FoldBase + 2, lines);
+		REQUIRE(2 == ll.FoldParent(5, lines));
+		REQUIRE(6 == ll.FoldEnd(2, lines));
+		ll.InsertLine(1);
+		lines++;
+		REQUIRE(3 == ll.FoldParent(4, lines));
+		REQUIRE(7 == ll.FoldEnd(0, lines));
+		REQUIRE(7 == ll.FoldEnd(3, lines));
+		ll.RemoveLine(7);
+		lines--;
+		REQUIRE(8 == ll.FoldEnd(0, lines));
+		REQUIRE(0 == ll.FoldParent(7, lines));
+	}
+
+	SECTION("FoldParentMatchesScan") {
+		constexpr int Header = static_cast<int>(Scintilla::FoldLevel::HeaderFlag);
+		constexpr int White = static_cast<int>(Scintilla::FoldLevel::WhiteFlag);
+		auto levelNumber = [&ll](Sci::Line line) {
+			return ll.GetLevel(line) & static_cast<int>(Scintilla::FoldLevel::NumberMask);
+		};
+		auto isHeader = [&ll](Sci::Line line) {
+			return (ll.GetLevel(line) & Header) != 0;
+		};
+		auto isWhite = [&ll](Sci::Line line) {
+			return (ll.GetLevel(line) & White) != 0;
+		};
+		Sci::Line lines = 3000;
+		unsigned int seed = 1;
+		auto next = [&seed]() {
+			seed = seed * 1103515245 + 12345;
+			return (seed >> 16) & 0x7fff;
+		};
+		for (Sci::Line line = 0; line < lines; line++) {
+			const unsigned int r = next();
+			ll.SetLevel(line, (FoldBase + (r % 4)) | (((r / 4) % 4 == 0) ? Header : 0) |
+				(((r / 16) % 8 == 0) ? White : 0), lines);
+		}
+		for (int step = 0; step < 200; step++) {
+			const unsigned int r = next();
+			const Sci::Line lineChange = 1 + r % (lines - 2);
+			switch (step % 3) {
+			case 0:
+				ll.SetLevel(lineChange, (FoldBase + (r % 3)) | ((r % 5 == 0) ? Header : 0), lines);
+				break;
+			case 1:
+				ll.InsertLine(lineChange);
+				lines++;
+				break;
+			default:
+				ll.RemoveLine(lineChange);
+				lines--;
+				break;
+			}
+			for (int check = 0; check < 5; check++) {
+				const Sci::Line line = next() % lines;
+				Sci::Line parent = line - 1;
+				while ((parent >= 0) && (!isHeader(parent) || levelNumber(parent) >= levelNumber(line))) {
+					parent--;
+				}
+				REQUIRE(parent == ll.FoldParent(line, lines));
+				Sci::Line end = -1;
+				if (isHeader(line) && !isWhite(line)) {
+					end = line + 1;
+					while ((end < lines) && (isWhite(end) || levelNumber(end) > levelNumber(line))) {
+						end++;
+					}
+				}
+				REQUIRE(end == ll.FoldEnd(line, lines));
+			}
+		}
+	}
 }
 
 TEST_CASE("LineState") {
@@ -272,6 +377,67 @@ TEST_CASE("LineState") {
 	}
 }
 
+TEST_CASE("LineCheckpoints") {
+
+	LineCheckpoints lc;
+
+	auto checkpoint = [](int lineState) {
+		std::unique_ptr<LexerCheckpoint> cp = std::make_unique<LexerCheckpoint>();
+		cp->lineState = lineState;
+		return cp;
+	};
+
+	SECTION("Initial") {
+		// Initial State
+		REQUIRE(nullptr == lc.Checkpoint(0));
+		REQUIRE(-1 == lc.CheckpointNext(0, 100));
+	}
+
+	SECTION("SetCheckpoint") {
+		lc.SetCheckpoint(5, checkpoint(1));
+		lc.SetCheckpoint(9, checkpoint(2));
+		REQUIRE(1 == lc.Checkpoint(5)->lineState);
+		REQUIRE(nullptr == lc.Checkpoint(6));
+		REQUIRE(5 == lc.CheckpointNext(0, 100));
+		REQUIRE(9 == lc.CheckpointNext(6, 100));
+		REQUIRE(-1 == lc.CheckpointNext(6, 9));
+		lc.SetCheckpoint(5, std::unique_ptr<LexerCheckpoint>());
+		REQUIRE(9 == lc.CheckpointNext(0, 100));
+		lc.ClearAll();
+		REQUIRE(-1 == lc.CheckpointNext(0, 100));
+	}
+
+	SECTION("Equality") {
+		REQUIRE(*checkpoint(1) == *checkpoint(1));
+		REQUIRE(!(*checkpoint(1) == *checkpoint(2)));
+		std::unique_ptr<LexerCheckpoint> withState = checkpoint(1);
+		withState->state = "abc";
+		REQUIRE(!(*checkpoint(1) == *withState));
+	}
+
+	SECTION("InsertRemoveLine") {
+		lc.SetCheckpoint(1, checkpoint(1));
+		lc.SetCheckpoint(3, checkpoint(3));
+		// Splitting line 1 moves its checkpoint to the end of the second piece
+		lc.InsertLine(2);
+		REQUIRE(nullptr == lc.Checkpoint(1));
+		REQUIRE(1 == lc.Checkpoint(2)->lineState);
+		REQUIRE(3 == lc.Checkpoint(4)->lineState);
+		// Joining keeps the checkpoint at the end of the joined line
+		lc.RemoveLine(2);
+		REQUIRE(1 == lc.Checkpoint(1)->lineState);
+		REQUIRE(3 == lc.Checkpoint(3)->lineState);
+		lc.InsertLines(1, 2);
+		REQUIRE(nullptr == lc.Checkpoint(1));
+		REQUIRE(1 == lc.Checkpoint(3)->lineState);
+		REQUIRE(3 == lc.Checkpoint(5)->lineState);
+		// Inserting before the first line moves every checkpoint down
+		lc.InsertLine(0);
+		REQUIRE(1 == lc.Checkpoint(4)->lineState);
+		REQUIRE(3 == lc.Checkpoint(6)->lineState);
+	}
+}
+
 TEST_CASE("LineAnnotation") {
 
 	LineAnnotation la;
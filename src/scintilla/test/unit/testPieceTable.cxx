@@ -0,0 +1,215 @@
+/** @file testPieceTable.cxx
+ ** Unit Tests for Scintilla internal data structures
+ **/
+
+#include <cstddef>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "Debugging.h"
+
+#include "Position.h"
+#include "SplitVector.h"
+#include "Partitioning.h"
+#include "PieceTable.h"
+
+#include "catch.hpp"
+
+using namespace Scintilla::Internal;
+
+// Test PieceTable.
+
+namespace {
+
+std::string Contents(const PieceTable<char> &pt) {
+	std::string s(pt.Length(), '\0');
+	pt.GetRange(s.data(), 0, pt.Length());
+	return s;
+}
+
+}
+
+TEST_CASE("PieceTable") {
+
+	PieceTable<char> pt;
+
+	SECTION("IsEmptyInitially") {
+		REQUIRE(0 == pt.Length());
+		REQUIRE(0 == pt.Pieces());
+		REQUIRE(0 == pt.ValueAt(0));
+	}
+
+	SECTION("InsertFromArray") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		REQUIRE(6 == pt.Length());
+		REQUIRE("abcdef" == Contents(pt));
+		REQUIRE('c' == pt.ValueAt(2));
+	}
+
+	SECTION("AppendExtendsPiece") {
+		pt.InsertFromArray(0, "abc", 0, 3);
+		pt.InsertFromArray(3, "def", 0, 3);
+		pt.InsertFromArray(6, "ghi", 0, 3);
+		REQUIRE("abcdefghi" == Contents(pt));
+		REQUIRE(1 == pt.Pieces());
+	}
+
+	SECTION("InsertSplitsPiece") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		pt.InsertFromArray(3, "XY", 0, 2);
+		REQUIRE("abcXYdef" == Contents(pt));
+		REQUIRE(3 == pt.Pieces());
+		pt.InsertFromArray(0, "<", 0, 1);
+		pt.InsertFromArray(pt.Length(), ">", 0, 1);
+		REQUIRE("<abcXYdef>" == Contents(pt));
+	}
+
+	SECTION("InsertValue") {
+		pt.InsertFromArray(0, "ab", 0, 2);
+		pt.InsertValue(1, 3, '-');
+		REQUIRE("a---b" == Contents(pt));
+	}
+
+	SECTION("SetValue") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		pt.InsertFromArray(3, "XY", 0, 2);
+		pt.SetValueAt(4, 'Z');
+		pt.SetValueAt(7, 'F');
+		pt.SetValueAt(100, 'Q');
+		REQUIRE("abcXZdeF" == Contents(pt));
+	}
+
+	SECTION("DeleteRange") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		pt.InsertFromArray(3, "XY", 0, 2);
+		// Over the end of the first piece, all of the second and start of the third
+		pt.DeleteRange(2, 4);
+		REQUIRE("abef" == Contents(pt));
+		pt.DeleteRange(1, 2);
+		REQUIRE("af" == Contents(pt));
+		pt.DeleteRange(0, 1);
+		REQUIRE("f" == Contents(pt));
+		pt.DeleteRange(0, 1);
+		REQUIRE(0 == pt.Length());
+	}
+
+	SECTION("DeleteMiddle") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		pt.DeleteRange(2, 2);
+		REQUIRE("abef" == Contents(pt));
+		REQUIRE(2 == pt.Pieces());
+	}
+
+	SECTION("DeleteOutsideBounds") {
+		pt.InsertFromArray(0, "abc", 0, 3);
+		pt.DeleteRange(2, 5);
+		pt.DeleteRange(-1, 1);
+		REQUIRE("abc" == Contents(pt));
+	}
+
+	SECTION("BufferPointer") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		pt.InsertFromArray(3, "XY", 0, 2);
+		const char *p = pt.BufferPointer();
+		REQUIRE(std::string_view("abcXYdef") == p);
+		REQUIRE(1 == pt.Pieces());
+		pt.InsertFromArray(8, "!", 0, 1);
+		REQUIRE("abcXYdef!" == Contents(pt));
+	}
+
+	SECTION("RangePointer") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		pt.InsertFromArray(3, "XY", 0, 2);
+		// Inside a single piece does not flatten
+		REQUIRE(0 == memcmp(pt.RangePointer(3, 2), "XY", 2));
+		REQUIRE(3 == pt.Pieces());
+		REQUIRE(0 == memcmp(pt.RangePointer(2, 4), "cXYd", 4));
+		REQUIRE(1 == pt.Pieces());
+	}
+
+	SECTION("SegmentPointer") {
+		pt.InsertFromArray(0, "abcdef", 0, 6);
+		pt.InsertFromArray(3, "XY", 0, 2);
+		ptrdiff_t segmentStart = -1;
+		ptrdiff_t segmentEnd = -1;
+		const char *segment = pt.SegmentPointer(4, segmentStart, segmentEnd);
+		REQUIRE(3 == segmentStart);
+		REQUIRE(5 == segmentEnd);
+		REQUIRE(0 == memcmp(segment, "XY", 2));
+		segment = pt.SegmentPointer(7, segmentStart, segmentEnd);
+		REQUIRE(5 == segmentStart);
+		REQUIRE(8 == segmentEnd);
+		REQUIRE(0 == memcmp(segment, "def", 3));
+		REQUIRE(nullptr == pt.SegmentPointer(8, segmentStart, segmentEnd));
+		REQUIRE(3 == pt.Pieces());
+	}
+
+	SECTION("ScatteredEdits") {
+		// Compare against a std::string through edits spread over the buffer
+		std::string expected;
+		unsigned int seed = 1;
+		auto next = [&seed](unsigned int range) {
+			seed = seed * 1103515245 + 12345;
+			return (seed / 65536) % range;
+		};
+		for (int i = 0; i < 2000; i++) {
+			const ptrdiff_t position = next(static_cast<unsigned int>(expected.length()) + 1);
+			if (next(3) == 0 && position < static_cast<ptrdiff_t>(expected.length())) {
+				const ptrdiff_t length = std::min<ptrdiff_t>(next(20) + 1, expected.length() - position);
+				expected.erase(position, length);
+				pt.DeleteRange(position, length);
+			} else {
+				const std::string insertion(next(10) + 1, static_cast<char>('a' + next(26)));
+				expected.insert(position, insertion);
+				pt.InsertFromArray(position, insertion.c_str(), 0, insertion.length());
+			}
+			REQUIRE(static_cast<ptrdiff_t>(expected.length()) == pt.Length());
+		}
+		REQUIRE(expected == Contents(pt));
+		for (size_t i = 0; i < expected.length(); i++) {
+			REQUIRE(expected[i] == pt.ValueAt(i));
+		}
+		REQUIRE(expected == pt.BufferPointer());
+	}
+
+	SECTION("ConcurrentReading") {
+		// Several threads read every value while the piece cache is left alone
+		std::string expected;
+		for (int i = 0; i < 200; i++) {
+			const std::string insertion(i % 7 + 1, static_cast<char>('a' + i % 26));
+			const ptrdiff_t position = (i * 37) % (expected.length() + 1);
+			expected.insert(position, insertion);
+			pt.InsertFromArray(position, insertion.c_str(), 0, insertion.length());
+		}
+		REQUIRE(pt.Pieces() > 100);
+		pt.SetConcurrentReading(true);
+		std::vector<int> mismatches(4);
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < mismatches.size(); t++) {
+			threads.emplace_back([&, t]() {
+				for (size_t i = t; i < expected.length(); i += 3) {
+					if (expected[i] != pt.ValueAt(i))
+						mismatches[t]++;
+				}
+				std::string s(expected.length() - t, '\0');
+				pt.GetRange(s.data(), t, s.length());
+				if (s != expected.substr(t))
+					mismatches[t]++;
+			});
+		}
+		for (std::thread &thread : threads) {
+			thread.join();
+		}
+		pt.SetConcurrentReading(false);
+		REQUIRE(std::vector<int>(4) == mismatches);
+		REQUIRE(expected == Contents(pt));
+	}
+}
@@ -321,6 +321,114 @@ TEST_CASE("RunStyles") {
 		rs.Check();
 	}
 
+	SECTION("FillRanges") {
+		rs.InsertSpace(0, 20);
+		const int ranges[] = { 2, 3, 5, 2, 10, 4 };
+		const auto fr = rs.FillRanges(ranges, 3, 99);
+		REQUIRE(true == fr.changed);
+		REQUIRE(2 == fr.position);
+		REQUIRE(12 == fr.fillLength);
+		REQUIRE(20 == rs.Length());
+		// Touching ranges are a single run
+		REQUIRE(5 == rs.Runs());
+		REQUIRE(0 == rs.ValueAt(1));
+		REQUIRE(99 == rs.ValueAt(2));
+		REQUIRE(2 == rs.StartRun(3));
+		REQUIRE(7 == rs.EndRun(3));
+		REQUIRE(0 == rs.ValueAt(7));
+		REQUIRE(99 == rs.ValueAt(13));
+		REQUIRE(0 == rs.ValueAt(14));
+		rs.Check();
+	}
+
+	SECTION("FillRangesKeepsOtherRuns") {
+		rs.InsertSpace(0, 20);
+		rs.FillRange(0, 5, 4);
+		rs.FillRange(15, 99, 5);
+		const int ranges[] = { 2, 4, 12, 3 };
+		const auto fr = rs.FillRanges(ranges, 2, 99);
+		REQUIRE(true == fr.changed);
+		REQUIRE(2 == fr.position);
+		REQUIRE(13 == fr.fillLength);
+		REQUIRE(4 == rs.Runs());
+		REQUIRE(5 == rs.ValueAt(1));
+		REQUIRE(99 == rs.ValueAt(2));
+		REQUIRE(0 == rs.ValueAt(6));
+		REQUIRE(12 == rs.StartRun(19));
+		REQUIRE(20 == rs.EndRun(12));
+		rs.Check();
+	}
+
+	SECTION("FillRangesAlreadyFilled") {
+		rs.InsertSpace(0, 10);
+		rs.FillRange(2, 99, 6);
+		const int ranges[] = { 2, 1, 4, 3, 9, 0 };
+		const auto fr = rs.FillRanges(ranges, 3, 99);
+		REQUIRE(false == fr.changed);
+		REQUIRE(3 == rs.Runs());
+		rs.Check();
+	}
+
+	SECTION("FillRangesOutsideBounds") {
+		rs.InsertSpace(0, 5);
+		const int ranges[] = { 3, 10, 8, 2 };
+		const auto fr = rs.FillRanges(ranges, 2, 99);
+		REQUIRE(true == fr.changed);
+		REQUIRE(3 == fr.position);
+		REQUIRE(2 == fr.fillLength);
+		REQUIRE(5 == rs.Length());
+		REQUIRE(2 == rs.Runs());
+		rs.Check();
+	}
+
+	SECTION("ReplaceRanges") {
+		rs.InsertSpace(0, 20);
+		rs.FillRange(0, 99, 3);
+		rs.FillRange(16, 99, 2);
+		const int ranges[] = { 5, 2, 10, 1 };
+		const auto fr = rs.ReplaceRanges(ranges, 2, 99);
+		REQUIRE(true == fr.changed);
+		REQUIRE(0 == fr.position);
+		REQUIRE(18 == fr.fillLength);
+		REQUIRE(5 == rs.Runs());
+		REQUIRE(0 == rs.ValueAt(0));
+		REQUIRE(99 == rs.ValueAt(5));
+		REQUIRE(99 == rs.ValueAt(10));
+		REQUIRE(0 == rs.ValueAt(16));
+		rs.Check();
+		// Replacing with nothing clears everything
+		const auto frClear = rs.ReplaceRanges(nullptr, 0, 99);
+		REQUIRE(true == frClear.changed);
+		REQUIRE(1 == rs.Runs());
+		REQUIRE(true == rs.AllSameAs(0));
+		REQUIRE(20 == rs.Length());
+		rs.Check();
+	}
+
+	SECTION("FillRangesSameAsFillRange") {
+		rs.InsertSpace(0, 1000);
+		RunStyles<int, int> rsSingly;
+		rsSingly.InsertSpace(0, 1000);
+		std::vector<int> ranges;
+		for (int i = 0; i < 1000; i += 7) {
+			rs.FillRange(i, i % 3, 5);
+			rsSingly.FillRange(i, i % 3, 5);
+			if (i % 5) {
+				ranges.push_back(i + 2);
+				ranges.push_back(i % 4);
+			}
+		}
+		rs.FillRanges(ranges.data(), ranges.size() / 2, 2);
+		for (size_t range = 0; range < ranges.size(); range += 2) {
+			rsSingly.FillRange(ranges[range], 2, ranges[range + 1]);
+		}
+		REQUIRE(rsSingly.Runs() == rs.Runs());
+		for (int i = 0; i < 1000; i++) {
+			REQUIRE(rsSingly.ValueAt(i) == rs.ValueAt(i));
+		}
+		rs.Check();
+	}
+
 	SECTION("OutsideBounds") {
 		rs.InsertSpace(0, 1);
 		int startFill = 1;
@@ -324,6 +324,26 @@ TEST_CASE("SplitVector") {
 		REQUIRE(lengthAfterInsertion == sv.GapPosition());
 	}
 
+	SECTION("SegmentPointer") {
+		sv.InsertFromArray(0, testArray, 0, lengthTestArray);
+		sv.Insert(2, 99);
+		REQUIRE(3 == sv.GapPosition());
+		ptrdiff_t segmentStart = -1;
+		ptrdiff_t segmentEnd = -1;
+		const int *segment = sv.SegmentPointer(1, segmentStart, segmentEnd);
+		REQUIRE(0 == segmentStart);
+		REQUIRE(3 == segmentEnd);
+		REQUIRE(99 == segment[2]);
+		segment = sv.SegmentPointer(5, segmentStart, segmentEnd);
+		REQUIRE(3 == segmentStart);
+		REQUIRE(sv.Length() == segmentEnd);
+		for (ptrdiff_t i = segmentStart; i < segmentEnd; i++) {
+			REQUIRE(sv.ValueAt(i) == segment[i - segmentStart]);
+		}
+		// Gap not moved
+		REQUIRE(3 == sv.GapPosition());
+	}
+
 	SECTION("DeleteBackAndForth") {
 		sv.InsertValue(0, 10, 87);
 		for (int i=0; i<10; i+=2) {
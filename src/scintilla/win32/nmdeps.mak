@@ -96,6 +96,7 @@ $(DIR_O)/CellBuffer.obj: \
 	../src/Position.h \
 	../src/SplitVector.h \
 	../src/Partitioning.h \
+	../src/PieceTable.h \
 	../src/CellBuffer.h \
 	../src/UniConversion.h
 $(DIR_O)/CharacterCategoryMap.obj: \